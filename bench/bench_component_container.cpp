@@ -0,0 +1,131 @@
+// Micro-benchmark comparing the sparse-set ComponentContainer against the original hash-map backed container.
+// Builds without GLFW/SDL: only tiny_ecs and glm are needed.
+//
+//   bench_component_container [iterations]
+
+// stdlib
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+// internal
+#include "tiny_ecs.hpp"
+#include "bench_fixtures.hpp"
+
+// The container as it was before the sparse-set change, kept here as the baseline
+template <typename Component>
+class HashMapContainer
+{
+	std::unordered_map<unsigned int, unsigned int> map_entity_componentID;
+public:
+	std::vector<Component> components;
+	std::vector<Entity> entities;
+
+	Component& insert(Entity e, Component c)
+	{
+		map_entity_componentID[e] = (unsigned int)components.size();
+		components.push_back(std::move(c));
+		entities.push_back(e);
+		return components.back();
+	}
+	Component& get(Entity e) { return components[map_entity_componentID[e]]; }
+	bool has(Entity e) { return map_entity_componentID.count(e) > 0; }
+	void remove(Entity e)
+	{
+		if (has(e))
+		{
+			int cID = map_entity_componentID[e];
+			components[cID] = std::move(components.back());
+			entities[cID] = entities.back();
+			map_entity_componentID[entities.back()] = cID;
+			map_entity_componentID.erase(e);
+			components.pop_back();
+			entities.pop_back();
+		}
+	}
+};
+
+using Clock = std::chrono::steady_clock;
+
+static double ms_since(Clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+struct Result {
+	double insert = 0, has = 0, get = 0, iterate = 0, remove = 0;
+};
+
+// Runs the same workload on any container type:
+// insert n entities, probe has() for every other entity of the range, get() in random order,
+// walk entities and get() each one (the updatePositions pattern) and remove half in random order.
+template <class Container>
+static Result run(const std::vector<Entity>& ents, const std::vector<size_t>& order, int iterations)
+{
+	Result r;
+	volatile float sink = 0;
+	for (int it = 0; it < iterations; it++)
+	{
+		Container c;
+		auto t = Clock::now();
+		for (size_t i = 0; i < ents.size(); i += 2)
+			c.insert(ents[i], LegacyMotion());
+		r.insert += ms_since(t);
+
+		t = Clock::now();
+		size_t hits = 0;
+		for (size_t i : order)
+			hits += c.has(ents[i]);
+		r.has += ms_since(t);
+		sink = sink + (float)hits;
+
+		t = Clock::now();
+		for (size_t i : order)
+			if (i % 2 == 0)
+				sink = sink + c.get(ents[i]).position.x;
+		r.get += ms_since(t);
+
+		t = Clock::now();
+		for (Entity e : c.entities)
+			c.get(e).position += c.get(e).velocity;
+		r.iterate += ms_since(t);
+
+		t = Clock::now();
+		for (size_t i : order)
+			if (i % 4 == 0)
+				c.remove(ents[i]);
+		r.remove += ms_since(t);
+	}
+	r.insert /= iterations; r.has /= iterations; r.get /= iterations; r.iterate /= iterations; r.remove /= iterations;
+	return r;
+}
+
+static void print(const char* name, size_t n, const Result& r)
+{
+	printf("%-10s %8zu %10.3f %10.3f %10.3f %10.3f %10.3f\n", name, n, r.insert, r.has, r.get, r.iterate, r.remove);
+}
+
+int main(int argc, char* argv[])
+{
+	int iterations = argc > 1 ? std::max(1, atoi(argv[1])) : 20;
+
+	printf("average ms over %d iterations (half of the entities own the component)\n", iterations);
+	printf("%-10s %8s %10s %10s %10s %10s %10s\n", "container", "entities", "insert", "has", "get", "iterate", "remove");
+	std::mt19937 rng(1234);
+	for (size_t n : { 1000, 10000, 100000 })
+	{
+		// both containers see the same entity ids and the same access order
+		std::vector<Entity> ents(n);
+		std::vector<size_t> order(n);
+		for (size_t i = 0; i < n; i++) {
+			ents[i] = Entity::create();
+			order[i] = i;
+		}
+		std::shuffle(order.begin(), order.end(), rng);
+
+		print("hash_map", n, run<HashMapContainer<LegacyMotion>>(ents, order, iterations));
+		print("sparse_set", n, run<ComponentContainer<LegacyMotion>>(ents, order, iterations));
+	}
+	return 0;
+}
@@ -0,0 +1,554 @@
+// Throughput of ComponentContainer and ECSRegistry operations on the game's own components.
+// Builds without GLFW/SDL/GL libraries: only tiny_ecs, the registry and the component headers are needed.
+//
+//   bench_ecs [iterations]
+//
+// Prints one CSV row per measurement, the median over the iterations so repeated runs are comparable:
+//   suite,op,entities,ns_per_op,ops_per_sec
+
+// stdlib
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+
+// internal
+#include "tiny_ecs_registry.hpp"
+#include "registry_snapshot.hpp"
+#include "spatial_hash.hpp"
+#include "static_bvh.hpp"
+#include "separating_axis.hpp"
+#include "bench_fixtures.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+static double ns_since(Clock::time_point start)
+{
+	return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+static volatile float sink = 0;
+
+// Runs 'run' (which returns the nanoseconds spent in the timed part) 'iterations' times and prints the median per op
+template <class Function>
+static void measure(const char* suite, const char* op, size_t n, size_t ops, int iterations, Function run)
+{
+	std::vector<double> samples;
+	for (int it = 0; it < iterations; it++)
+		samples.push_back(run() / (double)ops);
+	std::sort(samples.begin(), samples.end());
+	double ns = samples[samples.size() / 2];
+	printf("%s,%s,%zu,%.2f,%.0f\n", suite, op, n, ns, ns > 0 ? 1e9 / ns : 0.0);
+}
+
+// Single container operations, every entity of 'ents' gets a component and is visited in random 'order'
+static void bench_container(const std::vector<Entity>& ents, const std::vector<size_t>& order, int iterations)
+{
+	const size_t n = ents.size();
+	auto filled = [&](ComponentContainer<Motion>& c) {
+		for (Entity e : ents)
+			c.insert(e, Motion());
+	};
+
+	measure("container", "insert", n, n, iterations, [&]() {
+		ComponentContainer<Motion> c;
+		auto t = Clock::now();
+		for (Entity e : ents)
+			c.insert(e, Motion());
+		return ns_since(t);
+	});
+	measure("container", "emplace", n, n, iterations, [&]() {
+		ComponentContainer<Motion> c;
+		auto t = Clock::now();
+		for (Entity e : ents)
+			c.emplace(e);
+		return ns_since(t);
+	});
+	measure("container", "has", n, n, iterations, [&]() {
+		ComponentContainer<Motion> c;
+		// only every other entity is present, so hits and misses mix
+		for (size_t i = 0; i < n; i += 2)
+			c.insert(ents[i], Motion());
+		size_t hits = 0;
+		auto t = Clock::now();
+		for (size_t i : order)
+			hits += c.has(ents[i]);
+		double ns = ns_since(t);
+		sink = sink + (float)hits;
+		return ns;
+	});
+	measure("container", "get", n, n, iterations, [&]() {
+		ComponentContainer<Motion> c;
+		filled(c);
+		auto t = Clock::now();
+		for (size_t i : order)
+			sink = sink + c.get(ents[i]).position.x;
+		return ns_since(t);
+	});
+	measure("container", "sort", n, n, iterations, [&]() {
+		ComponentContainer<Motion> c;
+		filled(c);
+		for (size_t i = 0; i < n; i++)
+			c.get(ents[order[i]]).position.y = (float)i;
+		auto t = Clock::now();
+		c.sort([&c](Entity a, Entity b) { return c.get(a).position.y < c.get(b).position.y; });
+		return ns_since(t);
+	});
+	// Ordered mode after a frame of movement: every hundredth entity moved a few places
+	measure("container", "repair_order", n, n, iterations, [&]() {
+		ComponentContainer<Motion> c;
+		filled(c);
+		for (size_t i = 0; i < n; i++)
+			c.get(ents[i]).position.y = (float)i;
+		c.keep_sorted([&c](Entity a, Entity b) { return c.get(a).position.y < c.get(b).position.y; });
+		for (size_t i = 0; i < n; i += 100)
+			c.get(ents[order[i]]).position.y += 5.5f;
+		auto t = Clock::now();
+		c.repair_order();
+		return ns_since(t);
+	});
+	measure("container", "remove", n, n, iterations, [&]() {
+		ComponentContainer<Motion> c;
+		filled(c);
+		auto t = Clock::now();
+		for (size_t i : order)
+			c.remove(ents[i]);
+		return ns_since(t);
+	});
+	measure("container", "clear", n, n, iterations, [&]() {
+		ComponentContainer<Motion> c;
+		filled(c);
+		auto t = Clock::now();
+		c.clear();
+		return ns_since(t);
+	});
+}
+
+// The two per-frame passes of the physics system over every moving entity, on the old and the split layout.
+// 'integrate' only needs the kinematics, 'ground' also reads the hitbox through a view like updatePositions does.
+static void bench_motion_split(const std::vector<Entity>& ents, int iterations)
+{
+	const size_t n = ents.size();
+	const float dt = 16.f;
+	ComponentContainer<LegacyMotion> legacy;
+	ComponentContainer<Motion> motions;
+	ComponentContainer<Shape> shapes;
+	for (size_t i = 0; i < n; i++) {
+		LegacyMotion& old = legacy.emplace(ents[i]);
+		Motion& motion = motions.emplace(ents[i]);
+		old.velocity = motion.velocity = { 0.1f, 0.2f, 0.f };
+		old.position.z = motion.position.z = (float)(i % 7);
+		old.hitbox = shapes.emplace(ents[i]).hitbox = { 10, 10, 4 };
+	}
+
+	measure("motion_split", "integrate_legacy", n, n, iterations, [&]() {
+		auto t = Clock::now();
+		for (LegacyMotion& m : legacy.components)
+			m.position += m.velocity * dt;
+		return ns_since(t);
+	});
+	measure("motion_split", "integrate_split", n, n, iterations, [&]() {
+		auto t = Clock::now();
+		for (Motion& m : motions.components)
+			m.position += m.velocity * dt;
+		return ns_since(t);
+	});
+	measure("motion_split", "ground_legacy", n, n, iterations, [&]() {
+		auto t = Clock::now();
+		for (LegacyMotion& m : legacy.components) {
+			float groundZ = m.hitbox.z / 2;
+			if (m.position.z > groundZ)
+				m.velocity.z -= m.gravity * dt;
+			else
+				m.position.z = groundZ;
+		}
+		return ns_since(t);
+	});
+	measure("motion_split", "ground_split", n, n, iterations, [&]() {
+		auto t = Clock::now();
+		View<Exclude<>, Motion, Shape>(std::make_tuple(), motions, shapes).each([dt](Entity, Motion& m, Shape& shape) {
+			float groundZ = shape.hitbox.z / 2;
+			if (m.position.z > groundZ)
+				m.velocity.z -= m.gravity * dt;
+			else
+				m.position.z = groundZ;
+		});
+		return ns_since(t);
+	});
+	sink = sink + legacy.components[0].position.x + motions.components[0].position.x;
+}
+
+// An enemy as the spawn functions build it, minus the rendering resources
+static Entity spawn_enemy(ECSRegistry& r, float x)
+{
+	Entity e = Entity::create();
+	r.emplace_motion(e).position = { x, x, 0 };
+	r.enemies.emplace(e);
+	r.knockables.emplace(e);
+	r.trappables.emplace(e);
+	r.midgrounds.emplace(e);
+	r.boars.emplace(e);
+	return e;
+}
+
+// Whole-entity operations through the registry, including the two churn patterns of the game
+static void bench_registry(size_t n, int iterations, std::mt19937& rng)
+{
+	measure("registry", "remove_all_components_of", n, n, iterations, [&]() {
+		ECSRegistry r;
+		std::vector<Entity> alive;
+		for (size_t i = 0; i < n; i++)
+			alive.push_back(spawn_enemy(r, (float)i));
+		std::shuffle(alive.begin(), alive.end(), rng);
+		auto t = Clock::now();
+		for (Entity e : alive)
+			r.remove_all_components_of(e);
+		return ns_since(t);
+	});
+
+	// Particles: short-lived, a tenth of the population dies and is respawned every frame
+	const size_t frames = 100;
+	measure("registry", "particle_churn", n, frames * (n / 10), iterations, [&]() {
+		ECSRegistry r;
+		std::vector<Entity> alive;
+		for (size_t i = 0; i < n; i++) {
+			Entity e = Entity::create();
+			r.particles.insert(e, ParticleMotion(), Particle());
+			alive.push_back(e);
+		}
+		auto t = Clock::now();
+		for (size_t frame = 0; frame < frames; frame++) {
+			for (size_t i = 0; i < n / 10; i++) {
+				size_t slot = (frame * (n / 10) + i) % n;
+				r.remove_all_components_of(alive[slot]);
+				Entity e = Entity::create();
+				r.particles.insert(e, ParticleMotion(), Particle());
+				alive[slot] = e;
+			}
+		}
+		double ns = ns_since(t);
+		for (Entity e : alive)
+			r.remove_all_components_of(e);
+		return ns;
+	});
+
+	// Enemies: long-lived, every frame moves all of them through the query and replaces one in a hundred
+	measure("registry", "enemy_frame", n, frames * n, iterations, [&]() {
+		ECSRegistry r;
+		std::vector<Entity> alive;
+		for (size_t i = 0; i < n; i++)
+			alive.push_back(spawn_enemy(r, (float)i));
+		std::uniform_int_distribution<size_t> pick(0, n - 1);
+		auto t = Clock::now();
+		for (size_t frame = 0; frame < frames; frame++) {
+			for (Entity e : r.livingEnemies.entities)
+				r.motions.get(e).position.x += 1.f;
+			for (size_t i = 0; i < std::max<size_t>(1, n / 100); i++) {
+				size_t slot = pick(rng);
+				r.defer_destroy(alive[slot]);
+				alive[slot] = spawn_enemy(r, (float)slot);
+			}
+			r.flush_deferred();
+		}
+		double ns = ns_since(t);
+		for (Entity e : alive)
+			r.remove_all_components_of(e);
+		return ns;
+	});
+
+	// New game on a registry that already ran one: clear everything and spawn the same population again
+	measure("registry", "restart", n, n, iterations, [&]() {
+		ECSRegistry r;
+		auto populate = [&]() {
+			for (size_t i = 0; i < n; i++) {
+				AnimationController& animations = r.emplace_animation_controller(spawn_enemy(r, (float)i));
+				animations.addAnimation(AnimationState::Idle, 100, 4, TEXTURE_ASSET_ID::HEART);
+				animations.addAnimation(AnimationState::Running, 100, 4, TEXTURE_ASSET_ID::HEART);
+				animations.addAnimation(AnimationState::Dead, 100, 4, TEXTURE_ASSET_ID::HEART);
+			}
+		};
+		populate();
+		auto t = Clock::now();
+		r.clear_all_components();
+		populate();
+		double ns = ns_since(t);
+		r.clear_all_components();
+		return ns;
+	});
+
+	// End of tick copy for concurrent readers, steady state: the snapshot buffers already hold a previous capture
+	measure("registry", "snapshot_capture", n, n, iterations, [&]() {
+		ECSRegistry r;
+		RegistrySnapshot snapshot;
+		std::vector<Entity> alive;
+		for (size_t i = 0; i < n; i++) {
+			alive.push_back(spawn_enemy(r, (float)i));
+			AnimationController& animations = r.emplace_animation_controller(alive.back());
+			animations.addAnimation(AnimationState::Idle, 100, 4, TEXTURE_ASSET_ID::HEART);
+			animations.addAnimation(AnimationState::Running, 100, 4, TEXTURE_ASSET_ID::HEART);
+			animations.addAnimation(AnimationState::Dead, 100, 4, TEXTURE_ASSET_ID::HEART);
+		}
+		snapshot.capture(r);
+		snapshot.capture(r);
+		auto t = Clock::now();
+		snapshot.capture(r);
+		double ns = ns_since(t);
+		sink = sink + snapshot.current().motions.components[0].position.x;
+		for (Entity e : alive)
+			r.remove_all_components_of(e);
+		return ns;
+	});
+}
+
+// Collision broadphase over boxes the size of game entities spread over the game's world, moving a little every
+// frame: the full pair loop checkCollisions used to run against the uniform grid kept across frames
+static void bench_broadphase(const std::vector<Entity>& ents, int iterations, std::mt19937& rng)
+{
+	const size_t n = ents.size();
+	std::uniform_real_distribution<float> x(0, (float)world_size_x), y(0, (float)world_size_y), extent(25, 75);
+	std::vector<vec2> centers(n), halves(n);
+	for (size_t i = 0; i < n; i++) {
+		centers[i] = { x(rng), y(rng) };
+		halves[i] = { extent(rng), extent(rng) };
+	}
+	const size_t frames = 10;
+	auto move = [&](size_t frame) {
+		for (size_t i = 0; i < n; i++)
+			centers[i].x += (i + frame) % 2 ? 3.f : -3.f;
+	};
+
+	// quadratic, only run it where it finishes in reasonable time
+	if (n <= 10000) {
+		measure("broadphase", "pairs_all", n, frames * n, iterations, [&]() {
+			size_t pairs = 0;
+			auto t = Clock::now();
+			for (size_t frame = 0; frame < frames; frame++) {
+				move(frame);
+				for (size_t i = 0; i < n; i++)
+					for (size_t j = i + 1; j < n; j++)
+						if (abs(centers[i].x - centers[j].x) <= halves[i].x + halves[j].x && abs(centers[i].y - centers[j].y) <= halves[i].y + halves[j].y)
+							pairs++;
+			}
+			sink = sink + (float)pairs;
+			return ns_since(t);
+		});
+	}
+
+	measure("broadphase", "pairs_grid", n, frames * n, iterations, [&]() {
+		SpatialHash grid((float)tile_x / 4, x_tiles * 4, y_tiles * 4);
+		for (size_t i = 0; i < n; i++)
+			grid.update(ents[i], (uint32_t)i, centers[i] - halves[i], centers[i] + halves[i]);
+		grid.sweep();
+		size_t pairs = 0;
+		auto t = Clock::now();
+		for (size_t frame = 0; frame < frames; frame++) {
+			move(frame);
+			for (size_t i = 0; i < n; i++)
+				grid.update(ents[i], (uint32_t)i, centers[i] - halves[i], centers[i] + halves[i]);
+			grid.sweep();
+			grid.for_each_pair([&pairs](uint32_t, uint32_t) { pairs++; });
+		}
+		sink = sink + (float)pairs;
+		return ns_since(t);
+	});
+
+	// Every other box is static (obstacles, cliffs, map tiles): it sits in a hierarchy built once, the moving half
+	// uses the grid and queries the hierarchy, pairs of two static boxes are never looked at
+	measure("broadphase", "pairs_grid_static_bvh", n, frames * n, iterations, [&]() {
+		SpatialHash grid((float)tile_x / 4, x_tiles * 4, y_tiles * 4);
+		StaticBVH statics;
+		std::vector<StaticBVH::Item> items;
+		for (size_t i = 1; i < n; i += 2)
+			items.push_back({ centers[i] - halves[i], centers[i] + halves[i], (uint32_t)i });
+		statics.build(items);
+		size_t pairs = 0;
+		auto t = Clock::now();
+		for (size_t frame = 0; frame < frames; frame++) {
+			for (size_t i = 0; i < n; i += 2) {
+				centers[i].x += (i + frame) % 4 ? 3.f : -3.f;
+				grid.update(ents[i], (uint32_t)i, centers[i] - halves[i], centers[i] + halves[i]);
+			}
+			grid.sweep();
+			grid.for_each_pair([&pairs](uint32_t, uint32_t) { pairs++; });
+			for (size_t i = 0; i < n; i += 2)
+				statics.query(centers[i] - halves[i], centers[i] + halves[i], [&pairs](uint32_t) { pairs++; });
+		}
+		sink = sink + (float)pairs;
+		return ns_since(t);
+	});
+}
+
+// Separating axis test as checkCollisions ran it before the fixed-size boxes: a vector per hitbox and a copy of
+// the polygon for every axis loop, kept here to measure what the batched kernel saves
+static bool legacy_polygons_collide(const std::vector<vec2>& polygon1, const std::vector<vec2>& polygon2)
+{
+	for (int i = 0; i < 2; i++) {
+		std::vector<vec2> polygon = i == 0 ? polygon1 : polygon2;
+		for (size_t i1 = 0; i1 < polygon.size(); i1++) {
+			vec2 p1 = polygon[i1];
+			vec2 p2 = polygon[(i1 + 1) % polygon.size()];
+			vec2 normal = { p2.y - p1.y, p1.x - p2.x };
+			float minA = dot(normal, polygon1[0]), maxA = minA;
+			for (vec2 v : polygon1) {
+				minA = std::min(minA, dot(normal, v));
+				maxA = std::max(maxA, dot(normal, v));
+			}
+			float minB = dot(normal, polygon2[0]), maxB = minB;
+			for (vec2 v : polygon2) {
+				minB = std::min(minB, dot(normal, v));
+				maxB = std::max(maxB, dot(normal, v));
+			}
+			if (maxA < minB || maxB < minA)
+				return false;
+		}
+	}
+	return true;
+}
+
+// Narrowphase of checkCollisions over turned hitboxes crowded enough that many of the candidate pairs touch.
+// Every frame builds the boxes of all entities and tests 4 candidate pairs per entity, ops are pairs.
+static void bench_narrowphase(size_t n, int iterations, std::mt19937& rng)
+{
+	std::uniform_real_distribution<float> x(0, sqrtf((float)n) * 60.f), extent(20, 60), angle(0, 6.28f);
+	std::vector<vec2> centers(n), halves(n);
+	std::vector<float> angles(n);
+	for (size_t i = 0; i < n; i++) {
+		centers[i] = { x(rng), x(rng) };
+		halves[i] = { extent(rng) / 2, extent(rng) / 2 };
+		angles[i] = angle(rng);
+	}
+	// candidates are near in x, like the broadphase hands them out
+	std::vector<size_t> by_x(n);
+	for (size_t i = 0; i < n; i++)
+		by_x[i] = i;
+	std::sort(by_x.begin(), by_x.end(), [&centers](size_t a, size_t b) { return centers[a].x < centers[b].x; });
+	std::vector<std::pair<uint, uint>> pairs;
+	for (size_t i = 0; i < n; i++)
+		for (size_t k = 1; k <= 4; k++)
+			pairs.push_back(std::make_pair((uint)by_x[i], (uint)by_x[(i + k) % n]));
+	std::sort(pairs.begin(), pairs.end());
+
+	auto corner = [&](size_t i, float sx, float sy) {
+		vec2 v = vec2(sx * halves[i].x, sy * halves[i].y);
+		float c = cosf(angles[i]), s = sinf(angles[i]);
+		return centers[i] + vec2(v.x * c - v.y * s, v.x * s + v.y * c);
+	};
+	const size_t frames = 10;
+
+	measure("narrowphase", "sat_legacy_vectors", n, frames * pairs.size(), iterations, [&]() {
+		size_t hits = 0;
+		auto t = Clock::now();
+		for (size_t frame = 0; frame < frames; frame++) {
+			std::vector<std::vector<vec2>> polygons;
+			polygons.reserve(n);
+			for (size_t i = 0; i < n; i++)
+				polygons.push_back(std::vector<vec2>{ corner(i, 1, 1), corner(i, -1, 1), corner(i, -1, -1), corner(i, 1, -1) });
+			for (const std::pair<uint, uint>& pair : pairs)
+				hits += legacy_polygons_collide(polygons[pair.first], polygons[pair.second]);
+		}
+		sink = sink + (float)hits;
+		return ns_since(t);
+	});
+
+	std::vector<OrientedBox> boxes(n);
+	std::vector<uint8_t> overlapping(pairs.size());
+	auto build_boxes = [&]() {
+		for (size_t i = 0; i < n; i++)
+			boxes[i] = OrientedBox{ { corner(i, 1, 1), corner(i, -1, 1), corner(i, -1, -1), corner(i, 1, -1) } };
+	};
+	measure("narrowphase", "sat_boxes_scalar", n, frames * pairs.size(), iterations, [&]() {
+		size_t hits = 0;
+		auto t = Clock::now();
+		for (size_t frame = 0; frame < frames; frame++) {
+			build_boxes();
+			for (const std::pair<uint, uint>& pair : pairs)
+				hits += orientedBoxesCollide(boxes[pair.first], boxes[pair.second]);
+		}
+		sink = sink + (float)hits;
+		return ns_since(t);
+	});
+	measure("narrowphase", "sat_boxes_batched", n, frames * pairs.size(), iterations, [&]() {
+		size_t hits = 0;
+		auto t = Clock::now();
+		for (size_t frame = 0; frame < frames; frame++) {
+			build_boxes();
+			orientedBoxesCollide(boxes.data(), pairs.data(), pairs.size(), overlapping.data());
+			for (uint8_t overlaps : overlapping)
+				hits += overlaps;
+		}
+		sink = sink + (float)hits;
+		return ns_since(t);
+	});
+}
+
+// Entity handle creation: recycling released indices on one thread, and fresh handles from worker threads that each
+// draw from an index block of their own and record their components for a merge into the registry
+static void bench_entities(size_t n, int iterations)
+{
+	measure("entities", "create_release", n, n, iterations, [&]() {
+		std::vector<Entity> made(n);
+		for (Entity& e : made)
+			e = Entity::create();
+		for (Entity e : made)
+			Entity::release(e);
+		auto t = Clock::now();
+		for (size_t i = 0; i < n; i++)
+			Entity::release(Entity::create());
+		return ns_since(t);
+	});
+
+	const size_t threads = 4;
+	measure("entities", "create_merge_4_threads", n, n, iterations, [&]() {
+		ECSRegistry r;
+		std::vector<CommandBuffer> buffers(threads);
+		std::vector<std::thread> workers;
+		auto t = Clock::now();
+		for (size_t w = 0; w < threads; w++)
+			workers.emplace_back([&, w]() {
+				for (size_t i = w; i < n; i += threads)
+					buffers[w].add(Entity::create(), Motion());
+			});
+		for (std::thread& worker : workers)
+			worker.join();
+		for (CommandBuffer& buffer : buffers)
+			r.merge(buffer);
+		r.flush_deferred();
+		double ns = ns_since(t);
+		std::vector<Entity> made = r.motions.entities;
+		for (Entity e : made)
+			r.remove_all_components_of(e);
+		return ns;
+	});
+}
+
+int main(int argc, char* argv[])
+{
+	int iterations = argc > 1 ? std::max(1, atoi(argv[1])) : 11;
+
+	printf("suite,op,entities,ns_per_op,ops_per_sec\n");
+	std::mt19937 rng(1234);
+	for (size_t n : { 1000, 10000, 100000 })
+	{
+		// every container run sees the same entity ids and the same access order
+		std::vector<Entity> ents(n);
+		std::vector<size_t> order(n);
+		for (size_t i = 0; i < n; i++) {
+			ents[i] = Entity::create();
+			order[i] = i;
+		}
+		std::shuffle(order.begin(), order.end(), rng);
+
+		bench_container(ents, order, iterations);
+		bench_motion_split(ents, iterations);
+		bench_broadphase(ents, iterations, rng);
+		bench_narrowphase(n, iterations, rng);
+		for (Entity e : ents)
+			Entity::release(e);
+
+		bench_registry(n, iterations, rng);
+		bench_entities(n, iterations);
+	}
+	return 0;
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+// glm
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+// Motion as it was before the hot/cold split in components.hpp, shared by the benchmarks as the baseline layout
+struct LegacyMotion {
+	glm::vec3 position = { 0, 0, 0 };
+	float angle = 0;
+	glm::vec3 velocity = { 0, 0, 0 };
+	float speed = 0;
+	glm::vec2 scale = { 10, 10 };
+	glm::vec2 facing = { 0, 0 };
+	glm::vec3 hitbox = { 0, 0, 0 };
+	float gravity = 1;
+	bool solid = false;
+};
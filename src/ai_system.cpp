@@ -18,7 +18,7 @@ const float BIRD_COOLDOWN_TIME = 1000;
 const float BIRD_TURNING_SPEED = 0.002;
 
 
-AISystem::AISystem(std::default_random_engine& rng, SoundSystem* sound)
+AISystem::AISystem(ECSRegistry& registry, std::default_random_engine& rng, SoundSystem* sound) : registry(registry)
 {
     this->rng = rng;
 	this->sound = sound;
@@ -48,9 +48,11 @@ void AISystem::moveTowardsTarget(Entity enemy, vec3 targetPosition, float elapse
     const float MARGIN = 500;
 
     Motion& enemyMotion = registry.motions.get(enemy);
+    Shape& enemyShape = registry.shapes.get(enemy);
+    Presentation& enemyPresentation = registry.presentations.get(enemy);
 
     // Skip if in the air
-    if (enemyMotion.position.z - enemyMotion.hitbox.z / 2 > getElevation(vec2(enemyMotion.position)) + 1) {
+    if (enemyMotion.position.z - enemyShape.hitbox.z / 2 > getElevation(vec2(enemyMotion.position)) + 1) {
         return;
     }
     
@@ -68,12 +70,12 @@ void AISystem::moveTowardsTarget(Entity enemy, vec3 targetPosition, float elapse
         registry.enemies.get(enemy).pathfindTime = 1000;
     }
 
-    vec2 direction = chooseDirection(enemyMotion, targetPosition);
-    enemyMotion.facing = direction;
+    vec2 direction = chooseDirection(enemyMotion, enemyShape, targetPosition);
+    enemyPresentation.facing = direction;
     enemyMotion.velocity = vec3(direction * enemyMotion.speed, enemyMotion.velocity.z);
 }
 
-vec2 AISystem::chooseDirection(Motion& motion, vec3 playerPosition)
+vec2 AISystem::chooseDirection(const Motion& motion, const Shape& shape, vec3 playerPosition)
 {
     const vec2 playerDirection = normalize(playerPosition - motion.position);
 
@@ -91,9 +93,8 @@ vec2 AISystem::chooseDirection(Motion& motion, vec3 playerPosition)
     // only include obstacles within the range we care about
     // won't work for extremely large obstacles (where none of their hitbox vertices will be inside the radius)
     std::copy_if(allObstacles.begin(), allObstacles.end(), std::back_inserter(obstacles), 
-        [&motion, radius](Entity obstacle) {
-            Motion& obstacleMotion = registry.motions.get(obstacle);
-            std::vector<vec3> vertices = boundingBoxVertices(obstacleMotion);
+        [this, &motion, radius](Entity obstacle) {
+            std::array<vec3, 8> vertices = boundingBoxVertices(registry.motions.get(obstacle), registry.shapes.get(obstacle), registry.presentations.get(obstacle));
             for (auto& vertex : vertices) {
                 float d = distance(motion.position, vertex);
                 if (d < radius)
@@ -109,7 +110,7 @@ vec2 AISystem::chooseDirection(Motion& motion, vec3 playerPosition)
         int side = i % 2 == 0 ? -1 : 1;     // which side to apply offset
         vec2 direction = rotate(playerDirection, OFFSET * ceil(i / 2.f) * side);
         float clearDistance;
-        if (pathClear(motion, direction, radius, obstacles, clearDistance)) {
+        if (pathClear(motion, shape, direction, radius, obstacles, clearDistance)) {
             return direction;
         }
         if (clearDistance > bestClearDistance) {
@@ -126,13 +127,13 @@ vec2 AISystem::chooseDirection(Motion& motion, vec3 playerPosition)
 }
 
 // Uses hitbox vertices except for the vertex in the direction quadrant 
-static std::vector<vec2> pathPolygon(Motion& motion, vec2 pathEnd)
+static ConvexPolygon pathPolygon(const Motion& motion, const Shape& shape, vec2 pathEnd)
 {
-    std::vector<vec2> polygon;
-    vec2 topRight = vec2(motion.position) + vec2(motion.hitbox.x, motion.hitbox.y) / 2.f;
-    vec2 topLeft  = vec2(motion.position) + vec2(-motion.hitbox.x, motion.hitbox.y) / 2.f;
-    vec2 botRight = vec2(motion.position) + vec2(motion.hitbox.x, -motion.hitbox.y) / 2.f;
-    vec2 botLeft  = vec2(motion.position) + vec2(-motion.hitbox.x, -motion.hitbox.y) / 2.f;
+    ConvexPolygon polygon;
+    vec2 topRight = vec2(motion.position) + vec2(shape.hitbox.x, shape.hitbox.y) / 2.f;
+    vec2 topLeft  = vec2(motion.position) + vec2(-shape.hitbox.x, shape.hitbox.y) / 2.f;
+    vec2 botRight = vec2(motion.position) + vec2(shape.hitbox.x, -shape.hitbox.y) / 2.f;
+    vec2 botLeft  = vec2(motion.position) + vec2(-shape.hitbox.x, -shape.hitbox.y) / 2.f;
     if (pathEnd.x >= 0 && pathEnd.y <= 0) {
         polygon.push_back(topLeft);
         polygon.push_back(botLeft);
@@ -170,54 +171,48 @@ static std::vector<vec2> pathPolygon(Motion& motion, vec2 pathEnd)
 
 // Returns whether the path is clear or not
 // If path is not clear, sets clearDistance to the distance along the path that is clear
-bool AISystem::pathClear(Motion& motion, vec2 direction, float howFar, const std::vector<Entity>& obstacles, float& clearDistance)
+bool AISystem::pathClear(const Motion& motion, const Shape& shape, vec2 direction, float howFar, const std::vector<Entity>& obstacles, float& clearDistance)
 {
-    // Filter out obstacles that are outside of the Z range
-    std::vector<Entity> verticallyBlockingObstacles;
-    std::copy_if(obstacles.begin(), obstacles.end(), std::back_inserter(verticallyBlockingObstacles),
-        [&motion](Entity obstacle) {
-            Motion& obstacleMotion = registry.motions.get(obstacle);
-            return !(
-                obstacleMotion.position.z - obstacleMotion.hitbox.z / 2 > motion.position.z + motion.hitbox.z / 2 ||
-                obstacleMotion.position.z + obstacleMotion.hitbox.z / 2 < motion.position.z - motion.hitbox.z / 2);
-        }
-    );
-
     // Horizontal path polygon
-    std::vector<vec2> polygon = pathPolygon(motion, direction * howFar);
-    
-    // Obstacles that block in both horizontal and vertical ranges
-    std::vector<Entity> blockingObstacles;
-    std::copy_if(verticallyBlockingObstacles.begin(), verticallyBlockingObstacles.end(), std::back_inserter(blockingObstacles),
-        [&polygon](Entity obstacle) {
-            float hitboxFactor = 1;
-            if (registry.meshPtrs.has(obstacle)) {
-                hitboxFactor = 0.2;
-            }
-
-            Motion& obstacleMotion = registry.motions.get(obstacle);
-            vec2 centre = vec2(obstacleMotion.position);
-            std::vector<vec2> obstaclePolygon = {
-                centre + vec2(obstacleMotion.hitbox.x,  obstacleMotion.hitbox.y) * 0.9f / 2.f * hitboxFactor,
-                centre + vec2(-obstacleMotion.hitbox.x,  obstacleMotion.hitbox.y) * 0.9f / 2.f * hitboxFactor,
-                centre + vec2(-obstacleMotion.hitbox.x, -obstacleMotion.hitbox.y) * 0.9f / 2.f * hitboxFactor,
-                centre + vec2(obstacleMotion.hitbox.x, -obstacleMotion.hitbox.y) * 0.9f / 2.f * hitboxFactor
-            };
-            return polygonsCollide(polygon, obstaclePolygon);
-        });
-
-    if (blockingObstacles.size() == 0) {
-        return true;
-    }
+    ConvexPolygon polygon = pathPolygon(motion, shape, direction * howFar);
 
+    // Closest of the obstacles that block in both horizontal and vertical ranges
+    bool blocked = false;
     float minDistance = FLT_MAX;
-    for (Entity obstacle : blockingObstacles) {
+    for (Entity obstacle : obstacles) {
         Motion& obstacleMotion = registry.motions.get(obstacle);
+        Shape& obstacleShape = registry.shapes.get(obstacle);
+
+        // Skip obstacles that are outside of the Z range
+        if (obstacleMotion.position.z - obstacleShape.hitbox.z / 2 > motion.position.z + shape.hitbox.z / 2 ||
+            obstacleMotion.position.z + obstacleShape.hitbox.z / 2 < motion.position.z - shape.hitbox.z / 2) {
+            continue;
+        }
+
+        float hitboxFactor = 1;
+        if (registry.meshPtrs.has(obstacle)) {
+            hitboxFactor = 0.2;
+        }
+        vec2 centre = vec2(obstacleMotion.position);
+        ConvexPolygon obstaclePolygon;
+        obstaclePolygon.push_back(centre + vec2(obstacleShape.hitbox.x,  obstacleShape.hitbox.y) * 0.9f / 2.f * hitboxFactor);
+        obstaclePolygon.push_back(centre + vec2(-obstacleShape.hitbox.x,  obstacleShape.hitbox.y) * 0.9f / 2.f * hitboxFactor);
+        obstaclePolygon.push_back(centre + vec2(-obstacleShape.hitbox.x, -obstacleShape.hitbox.y) * 0.9f / 2.f * hitboxFactor);
+        obstaclePolygon.push_back(centre + vec2(obstacleShape.hitbox.x, -obstacleShape.hitbox.y) * 0.9f / 2.f * hitboxFactor);
+        if (!polygonsCollide(polygon, obstaclePolygon)) {
+            continue;
+        }
+
+        blocked = true;
         float d = distance(obstacleMotion.position, motion.position);
         if (d < minDistance) {
             minDistance = d;
         }
     }
+
+    if (!blocked) {
+        return true;
+    }
     clearDistance = minDistance;
 
     return false;
@@ -236,6 +231,8 @@ void AISystem::boarBehaviour(Entity boar, vec3 targetPosition, float elapsed_ms)
     }
 
     Motion& motion = registry.motions.get(boar);
+    Shape& shape = registry.shapes.get(boar);
+    Presentation& presentation = registry.presentations.get(boar);
     Boar& boars = registry.boars.get(boar);
     AnimationController& animationController = registry.animationControllers.get(boar);
     float distanceToTarget = distance(motion.position, targetPosition);
@@ -249,11 +246,11 @@ void AISystem::boarBehaviour(Entity boar, vec3 targetPosition, float elapsed_ms)
     // Set state based on distance
     float clearDistance;
     if (distanceToTarget < BOAR_AGGRO_RANGE && boars.cooldownTimer <= 0 && !boars.preparing && !boars.charging &&
-            pathClear(motion, directionToTarget, distanceToTarget, registry.obstacles.entities, clearDistance)) {
+            pathClear(motion, shape, directionToTarget, distanceToTarget, registry.obstacles.entities, clearDistance)) {
         boars.preparing = true;
         boars.prepareTimer = BOAR_PREPARE_TIME;
         boars.chargeTimer = BOAR_CHARGE_DURATION;
-        animationController.changeState(boar, AnimationState::Idle);
+        animationController.changeState(boar, AnimationState::Idle, registry);
     } else if (distanceToTarget > BOAR_DISENGAGE_RANGE) {
         boars.preparing = false;
         boars.charging = false;
@@ -261,7 +258,7 @@ void AISystem::boarBehaviour(Entity boar, vec3 targetPosition, float elapsed_ms)
 
     if (boars.preparing) {
         // Preparation shake
-        motion.facing = directionToTarget;
+        presentation.facing = directionToTarget;
         if (boars.prepareTimer > 0) {
             boars.prepareTimer -= elapsed_ms;
 
@@ -275,8 +272,8 @@ void AISystem::boarBehaviour(Entity boar, vec3 targetPosition, float elapsed_ms)
 
         } else {
             boars.preparing = false;
-            if (pathClear(motion, directionToTarget, distanceToTarget, registry.obstacles.entities, clearDistance)) {
-                animationController.changeState(boar, AnimationState::Running);
+            if (pathClear(motion, shape, directionToTarget, distanceToTarget, registry.obstacles.entities, clearDistance)) {
+                animationController.changeState(boar, AnimationState::Running, registry);
                 boars.charging = true;
                 boars.chargeDirection = directionToTarget;
                 motion.velocity = vec3(boars.chargeDirection * BOAR_CHARGE_SPEED, 0);
@@ -295,7 +292,7 @@ void AISystem::boarBehaviour(Entity boar, vec3 targetPosition, float elapsed_ms)
     } 
     else if (!boars.preparing) {
 		moveTowardsTarget(boar, targetPosition, elapsed_ms);
-        animationController.changeState(boar, AnimationState::Running);
+        animationController.changeState(boar, AnimationState::Running, registry);
     }
 }
 
@@ -304,7 +301,7 @@ void AISystem::boarReset(Entity boar)
     AnimationController& animationController = registry.animationControllers.get(boar);
     Motion& motion = registry.motions.get(boar);
     Boar& boars = registry.boars.get(boar);
-    animationController.changeState(boar, AnimationState::Idle);
+    animationController.changeState(boar, AnimationState::Idle, registry);
     boars.charging = false;
     boars.cooldownTimer = BOAR_COOLDOWN_TIME;
     motion.velocity = vec3(0, 0, 0);
@@ -319,9 +316,9 @@ void AISystem::barbarianBehaviour(Entity barbarian, vec3 targetPosition, float e
 }
 
 // Returns the new direction to go in as a unit vector
-vec2 AISystem::alignToDirection(Motion& motion, float desiredAngle, float turning_speed, float elapsed_ms) 
+vec2 AISystem::alignToDirection(const Presentation& presentation, float desiredAngle, float turning_speed, float elapsed_ms) 
 {
-    float currentAngle = atan2(motion.facing.y, motion.facing.x);
+    float currentAngle = atan2(presentation.facing.y, presentation.facing.x);
     float angleToGo = desiredAngle - currentAngle;
     if (angleToGo < -M_PI) {
         angleToGo += 2 * M_PI;
@@ -350,21 +347,23 @@ void AISystem::trollBehaviour(Entity troll, vec3 targetPosition, float elapsed_m
     float TROLL_TURNING_SPEED = 0.001;
     Troll& trollComponent = registry.trolls.get(troll);
     Motion& motion = registry.motions.get(troll);
+    Shape& shape = registry.shapes.get(troll);
+    Presentation& presentation = registry.presentations.get(troll);
 
     // Skip if in the air
-    if (motion.position.z - motion.hitbox.z / 2 > getElevation(vec2(motion.position)) + 1) {
+    if (motion.position.z - shape.hitbox.z / 2 > getElevation(vec2(motion.position)) + 1) {
         return;
     }
 
     if (!decideToPathfind(troll, 100, elapsed_ms)) {
-        vec2 direction = chooseDirection(motion, targetPosition);
+        vec2 direction = chooseDirection(motion, shape, targetPosition);
         trollComponent.desiredAngle = atan2(direction.y, direction.x);
     }
 
     // Continue to align towards desired direction
-    vec2 direction = alignToDirection(motion, trollComponent.desiredAngle, TROLL_TURNING_SPEED, elapsed_ms);
-    motion.facing = direction;
-    motion.velocity = vec3(motion.facing * motion.speed, motion.velocity.z);
+    vec2 direction = alignToDirection(presentation, trollComponent.desiredAngle, TROLL_TURNING_SPEED, elapsed_ms);
+    presentation.facing = direction;
+    motion.velocity = vec3(presentation.facing * motion.speed, motion.velocity.z);
 }
 
 void AISystem::shootArrow(Entity shooter, vec3 targetPos)
@@ -374,6 +373,7 @@ void AISystem::shootArrow(Entity shooter, vec3 targetPos)
     const float MAX_ARROW_VELOCITY = 10;
 
     Motion& motion = registry.motions.get(shooter);
+    Shape& shape = registry.shapes.get(shooter);
 
     // Get start position of the arrow
     vec2 horizontal_direction = normalize(vec2(targetPos) - vec2(motion.position));
@@ -381,21 +381,21 @@ void AISystem::shootArrow(Entity shooter, vec3 targetPos)
     vec3 pos = motion.position;
     if (abs(horizontal_direction.x) > abs(horizontal_direction.y)) {
         if (horizontal_direction.x > 0) {
-            pos.x += motion.hitbox.x / 2 + maxArrowDimension;
+            pos.x += shape.hitbox.x / 2 + maxArrowDimension;
         }
         else if (horizontal_direction.x < 0) {
-            pos.x -= motion.hitbox.x / 2 + maxArrowDimension;
+            pos.x -= shape.hitbox.x / 2 + maxArrowDimension;
         }
     }
     else {
         if (horizontal_direction.y > 0) {
-            pos.y += motion.hitbox.y / 2 + maxArrowDimension;
+            pos.y += shape.hitbox.y / 2 + maxArrowDimension;
         }
         else if (horizontal_direction.x < 0) {
-            pos.y -= motion.hitbox.y / 2 + maxArrowDimension;
+            pos.y -= shape.hitbox.y / 2 + maxArrowDimension;
         }
     }
-    pos.z += motion.hitbox.z / 2 + maxArrowDimension;
+    pos.z += shape.hitbox.z / 2 + maxArrowDimension;
     horizontal_direction = normalize(vec2(targetPos) - vec2(pos));
 
     // Get distances from start to target
@@ -419,7 +419,7 @@ void AISystem::shootArrow(Entity shooter, vec3 targetPos)
     // Determine velocities for each dimension
     vec2 horizontal_velocity = velocity * cos(ARROW_ANGLE) * horizontal_direction;
     float vertical_velocity = velocity * sin(ARROW_ANGLE);
-    createArrow(pos, vec3(horizontal_velocity, vertical_velocity), registry.enemies.get(shooter).damage);
+    createArrow(pos, vec3(horizontal_velocity, vertical_velocity), registry.enemies.get(shooter).damage, registry);
 	sound->playSoundEffect(Sound::ARROW, 0);
 }
 
@@ -429,17 +429,18 @@ void AISystem::throwBomb(Entity thrower, vec3 targetPos)
     const float MAX_BOMB_VELOCITY = 10;
 
     Motion& motion = registry.motions.get(thrower);
+    Shape& shape = registry.shapes.get(thrower);
 
     // Get start position of the bomb
     vec2 horizontal_direction = normalize(vec2(targetPos) - vec2(motion.position));
     const float maxBombDimension = max(BOMB_BB_HEIGHT, BOMB_BB_WIDTH);
     vec3 pos = motion.position;
     if (abs(horizontal_direction.x) > abs(horizontal_direction.y)) {
-        pos.x += (horizontal_direction.x > 0 ? 1 : -1) * (motion.hitbox.x / 2 + maxBombDimension);
+        pos.x += (horizontal_direction.x > 0 ? 1 : -1) * (shape.hitbox.x / 2 + maxBombDimension);
     } else {
-        pos.y += (horizontal_direction.y > 0 ? 1 : -1) * (motion.hitbox.y / 2 + maxBombDimension);
+        pos.y += (horizontal_direction.y > 0 ? 1 : -1) * (shape.hitbox.y / 2 + maxBombDimension);
     }
-    pos.z += motion.hitbox.z / 2 + maxBombDimension;
+    pos.z += shape.hitbox.z / 2 + maxBombDimension;
     horizontal_direction = normalize(vec2(targetPos) - vec2(pos));
 
     // Get distances from start to target
@@ -468,7 +469,7 @@ void AISystem::throwBomb(Entity thrower, vec3 targetPos)
     // Apply horizontal and vertical velocities
     vec2 horizontal_velocity_vector = horizontal_velocity * horizontal_direction;
 
-    Entity bomb = createProjectile(pos, vec3(horizontal_velocity_vector, vertical_velocity), PROJECTILE_TYPE::BOMB_FUSED);
+    Entity bomb = createProjectile(pos, vec3(horizontal_velocity_vector, vertical_velocity), PROJECTILE_TYPE::BOMB_FUSED, registry);
     registry.projectiles.get(bomb).sticksInGround = 1000;
     registry.damagings.emplace(bomb).damage = 2;
 
@@ -483,6 +484,7 @@ void AISystem::archerBehaviour(Entity entity, vec3 targetPosition, float elapsed
         return;
     }
     Motion& motion = registry.motions.get(entity);
+    Presentation& presentation = registry.presentations.get(entity);
     Archer& archer = registry.archers.get(entity);
     float d = distance(motion.position, targetPosition);
 
@@ -491,22 +493,22 @@ void AISystem::archerBehaviour(Entity entity, vec3 targetPosition, float elapsed
         motion.velocity.x = 0;
         motion.velocity.y = 0;
         AnimationController& animationController = registry.animationControllers.get(entity);
-        animationController.changeState(entity, AnimationState::Attack);
+        animationController.changeState(entity, AnimationState::Attack, registry);
     }
     else if (d > DISENGAGE_RANGE) {
         archer.aiming = false;
         archer.drawArrowTime = 0;
         AnimationController& animationController = registry.animationControllers.get(entity);
-        animationController.changeState(entity, AnimationState::Running);
+        animationController.changeState(entity, AnimationState::Running, registry);
     }
 
     if (archer.aiming) {
-        motion.facing = normalize(vec2(targetPosition) - vec2(motion.position));
+        presentation.facing = normalize(vec2(targetPosition) - vec2(motion.position));
         if (archer.drawArrowTime > DRAW_ARROW_TIME) {
             shootArrow(entity, targetPosition);
             archer.drawArrowTime = 0;
             AnimationController& animationController = registry.animationControllers.get(entity);
-            animationController.changeState(entity, AnimationState::Idle);
+            animationController.changeState(entity, AnimationState::Idle, registry);
         }
         else {
             archer.drawArrowTime += elapsed_ms;
@@ -536,6 +538,7 @@ void AISystem::bomberBehaviour(Entity entity, vec3 targetPosition, float elapsed
     const float THROW_BOMB_MAX_DELAY = 3000;
 
     Motion& motion = registry.motions.get(entity);
+    Presentation& presentation = registry.presentations.get(entity);
     Bomber& bomber = registry.bombers.get(entity);
 
     float dist = distance(motion.position, targetPosition);
@@ -549,14 +552,14 @@ void AISystem::bomberBehaviour(Entity entity, vec3 targetPosition, float elapsed
         motion.velocity.x = 0;
         motion.velocity.y = 0;
         AnimationController& animationController = registry.animationControllers.get(entity);
-        animationController.changeState(entity, AnimationState::Idle);
+        animationController.changeState(entity, AnimationState::Idle, registry);
     }
     else {
         bomber.aiming = false;
     }
 
     if (bomber.aiming) {
-        motion.facing = normalize(vec2(targetPosition) - vec2(motion.position));
+        presentation.facing = normalize(vec2(targetPosition) - vec2(motion.position));
         if (bomber.throwBombDelayTimer > bomber.throwBombDelay) {
             throwBomb(entity, targetPosition);
 
@@ -571,7 +574,7 @@ void AISystem::bomberBehaviour(Entity entity, vec3 targetPosition, float elapsed
     else {
         AnimationController& animationController = registry.animationControllers.get(entity);
         if(animationController.currentState != AnimationState::Running) {
-            animationController.changeState(entity, AnimationState::Running);
+            animationController.changeState(entity, AnimationState::Running, registry);
         }
         moveTowardsTarget(entity, targetPosition, elapsed_ms);
     }
@@ -636,6 +639,7 @@ vec2 cohesion(const Motion& motion, const std::vector<Motion>& flockMates) {
 
 void AISystem::swoopAttack(Entity bird, vec3 targetPosition, vec2 movementForce ,float elapsed_ms, const std::vector<Motion>& flockMates) {
     Motion& birdMotion = registry.motions.get(bird);
+    Presentation& birdPresentation = registry.presentations.get(bird);
     Bird& birdComponent = registry.birds.get(bird);
     AnimationController& animationController = registry.animationControllers.get(bird);
 
@@ -652,22 +656,22 @@ void AISystem::swoopAttack(Entity bird, vec3 targetPosition, vec2 movementForce
 
     // Swoop towards player
     if (birdComponent.isSwooping) {
-        animationController.changeState(bird, AnimationState::Swooping);
+        animationController.changeState(bird, AnimationState::Swooping, registry);
 
 		if (birdComponent.swoopTimer == BIRD_SWOOP_DURATION) {
 			sound->playSoundEffect(Sound::BIRD_ATTACK, 0);
 		}
 
-        vec2 direction = alignToDirection(birdMotion, atan2(birdComponent.swoopDirection.y, birdComponent.swoopDirection.x), BIRD_TURNING_SPEED, elapsed_ms);
+        vec2 direction = alignToDirection(birdPresentation, atan2(birdComponent.swoopDirection.y, birdComponent.swoopDirection.x), BIRD_TURNING_SPEED, elapsed_ms);
         vec2 combinedForce = length(movementForce) * direction;
 
         birdMotion.velocity = vec3(combinedForce, -1.0f);
-        birdMotion.facing = normalize(combinedForce);
+        birdPresentation.facing = normalize(combinedForce);
 
         birdComponent.swoopTimer -= elapsed_ms;
         if (birdComponent.swoopTimer <= 0) {
             if (birdMotion.position.z < birdComponent.originalZ) {
-                animationController.changeState(bird, AnimationState::Flying);
+                animationController.changeState(bird, AnimationState::Flying, registry);
                 birdMotion.velocity.z = birdComponent.swoopSpeed;
             } else {
                 birdMotion.position.z = birdComponent.originalZ;
@@ -681,11 +685,12 @@ void AISystem::swoopAttack(Entity bird, vec3 targetPosition, vec2 movementForce
 
 void AISystem::birdBehaviour(Entity bird, vec3 targetPosition, float elapsed_ms) {
     Motion& birdMotion = registry.motions.get(bird);
+    Presentation& birdPresentation = registry.presentations.get(bird);
     Bird& birdComponent = registry.birds.get(bird);
     AnimationController& animationController = registry.animationControllers.get(bird);
     std::vector<Motion> flockMates;
-    for (const auto& entity : registry.birds.entities) {
-        if (entity.getId() != bird.getId() && registry.motions.has(entity)) {
+    for (Entity entity : registry.flock.entities) {
+        if (entity.getId() != bird.getId()) {
             flockMates.push_back(registry.motions.get(entity));
         }
     }
@@ -703,7 +708,7 @@ void AISystem::birdBehaviour(Entity bird, vec3 targetPosition, float elapsed_ms)
     vec2 targetForce = directionToTarget * PLAYER_ATTRACTION_WEIGHT;
     vec2 flockingForce = separationForce + alignmentForce + cohesionForce;
     vec2 movementForce = flockingForce + targetForce;
-    animationController.changeState(bird, AnimationState::Flying);
+    animationController.changeState(bird, AnimationState::Flying, registry);
 
     // Swoop Attack
     swoopAttack(bird, targetPosition, movementForce, elapsed_ms, flockMates);
@@ -715,9 +720,9 @@ void AISystem::birdBehaviour(Entity bird, vec3 targetPosition, float elapsed_ms)
     }
 
     float speed = max(length(movementForce), birdComponent.swarmSpeed);
-    vec2 movementDirection = alignToDirection(birdMotion, atan2(movementForce.y, movementForce.x), BIRD_TURNING_SPEED, elapsed_ms);
+    vec2 movementDirection = alignToDirection(birdPresentation, atan2(movementForce.y, movementForce.x), BIRD_TURNING_SPEED, elapsed_ms);
     birdMotion.velocity = vec3(speed * movementDirection, 0.0f);
-    birdMotion.facing = normalize(movementDirection);
+    birdPresentation.facing = normalize(movementDirection);
 }
 
 void AISystem::wizardBehaviour(Entity entity, vec3 targetPosition, float elapsed_ms) {
@@ -757,7 +762,7 @@ void AISystem::processWizardMoving(Entity entity, vec3 playerPosition, float ela
         wizard.state = WizardState::Aiming;
         motion.velocity.x = 0;
         motion.velocity.y = 0;
-        animationController.changeState(entity, AnimationState::Idle);
+        animationController.changeState(entity, AnimationState::Idle, registry);
     }
     else {
 		moveTowardsTarget(entity, playerPosition, elapsed_ms);
@@ -769,8 +774,10 @@ void AISystem::processWizardAiming(Entity entity, vec3 playerPosition, float ela
 
     float rand = uniform_dist(rng);
     Motion& motion = registry.motions.get(entity);
+    Shape& shape = registry.shapes.get(entity);
+    Presentation& presentation = registry.presentations.get(entity);
     Wizard& wizard = registry.wizards.get(entity);
-    motion.facing = normalize(vec2(playerPosition) - vec2(motion.position));
+    presentation.facing = normalize(vec2(playerPosition) - vec2(motion.position));
 
     bool farFromEdge =
         playerPosition.x > leftBound + EDGE_BUFFER &&
@@ -783,10 +790,10 @@ void AISystem::processWizardAiming(Entity entity, vec3 playerPosition, float ela
 	float howFar = distance(motion.position, playerPosition);
 	std::vector<Entity> obstacles = registry.obstacles.entities;
     float clearDistance;
-    bool clear = pathClear(motion, direction, howFar, obstacles, clearDistance);
+    bool clear = pathClear(motion, shape, direction, howFar, obstacles, clearDistance);
 
 	// face the shooter towards the player
-    motion.facing = direction;
+    presentation.facing = direction;
 
     // choose a random attack (fireball OR lightning)
     if (rand < 0.5 && clear) {
@@ -796,7 +803,7 @@ void AISystem::processWizardAiming(Entity entity, vec3 playerPosition, float ela
 	}
 	else if (farFromEdge) {
 		// start preparing for lightning
-		createTargetArea(playerPosition);
+		createTargetArea(playerPosition, registry);
 		wizard.locked_target = playerPosition;
 		wizard.state = WizardState::Preparing;
     }
@@ -831,8 +838,9 @@ void AISystem::processWizardShooting(Entity entity, vec3 playerPosition, float e
     const float SHOT_COOLDOWN = 5000;
 
 	Motion& motion = registry.motions.get(entity);
+	Presentation& presentation = registry.presentations.get(entity);
 	vec2 direction = normalize(vec2(playerPosition) - vec2(motion.position));
-    motion.facing = direction;
+    presentation.facing = direction;
 
     Wizard& wizard = registry.wizards.get(entity);
 
@@ -849,6 +857,7 @@ void AISystem::shootFireball(Entity shooter, vec3 targetPos) {
     const float FIREBALL_SPEED = 0.5f;
 
     Motion& motion = registry.motions.get(shooter);
+    Shape& shape = registry.shapes.get(shooter);
 
     // Direction to the player
     vec2 direction = normalize(vec2(targetPos) - vec2(motion.position));
@@ -856,8 +865,8 @@ void AISystem::shootFireball(Entity shooter, vec3 targetPos) {
     // Start position of the fireball
     vec3 pos = motion.position;
     // Set offset to avoid collision with the shooter
-    float x_offset = FIREBALL_HITBOX_WIDTH + motion.hitbox.x / 2;
-    float y_offset = FIREBALL_HITBOX_WIDTH + motion.hitbox.y / 2;
+    float x_offset = FIREBALL_HITBOX_WIDTH + shape.hitbox.x / 2;
+    float y_offset = FIREBALL_HITBOX_WIDTH + shape.hitbox.y / 2;
 	// travelling more horizontally so no y offset
     if (abs(direction.x) > abs(direction.y)) {
         y_offset = 0;
@@ -879,7 +888,7 @@ void AISystem::shootFireball(Entity shooter, vec3 targetPos) {
     // Velocity of the fireball
     vec3 velocity = vec3(direction * FIREBALL_SPEED, 0);
 
-    createFireball(pos, direction);
+    createFireball(pos, direction, registry);
 	sound->playSoundEffect(Sound::FIREBALL, 0);
 }
 
@@ -895,7 +904,7 @@ void AISystem::triggerLightning(vec3 target_pos) {
 		float y = radius * sin(angle);
 		vec3 pos = target_pos + vec3(x, y, 0);
 
-		createLightning(pos);
+		createLightning(pos, registry);
     }
 }
 
@@ -906,7 +915,7 @@ void AISystem::step(float elapsed_ms)
         return;
     }
     vec3 playerPosition = registry.motions.get(registry.players.entities.at(0)).position;
-    for (Entity enemy : registry.enemies.entities) {
+    for (Entity enemy : registry.livingEnemies.entities) {
         std::pair<bool, vec3> isPhantomCloser = is_phantom_closer(enemy);
         vec3 targetPosition = isPhantomCloser.first ? isPhantomCloser.second : playerPosition;
         if (registry.boars.has(enemy)) {
@@ -7,7 +7,7 @@
 
 class AISystem {
 public:
-	AISystem(std::default_random_engine& rng, SoundSystem* sound);
+	AISystem(ECSRegistry& registry, std::default_random_engine& rng, SoundSystem* sound);
 	void step(float elapsed_ms);
 	void boarReset(Entity boar);
 
@@ -18,9 +18,9 @@ private:
 
 	bool decideToPathfind(Entity enemy, float baseThinkingTime, float elapsed_ms);
 	void moveTowardsTarget(Entity enemy, vec3 targetPosition, float elapsed_ms);
-	vec2 chooseDirection(Motion& motion, vec3 playerPosition);
-	bool pathClear(Motion& motion, vec2 direction, float howFar, const std::vector<Entity> &obstacles, float& clearDistance);
-	vec2 alignToDirection(Motion& motion, float desiredAngle, float turning_speed, float elapsed_ms);
+	vec2 chooseDirection(const Motion& motion, const Shape& shape, vec3 playerPosition);
+	bool pathClear(const Motion& motion, const Shape& shape, vec2 direction, float howFar, const std::vector<Entity> &obstacles, float& clearDistance);
+	vec2 alignToDirection(const Presentation& presentation, float desiredAngle, float turning_speed, float elapsed_ms);
 	std::pair<bool, vec3> is_phantom_closer(Entity enemy);
 	
 	void boarBehaviour(Entity boar, vec3 playerPosition, float elapsed_ms);
@@ -57,5 +57,6 @@ private:
 	std::default_random_engine rng;
 	std::uniform_real_distribution<float> uniform_dist; // number between 0..1
 
+	ECSRegistry& registry;
 	SoundSystem* sound;
 };
\ No newline at end of file
@@ -16,7 +16,7 @@ void updateAnimation(Animation& animation, float deltaTime)
 	}
 }
 
-void AnimationController::changeState(Entity entity, AnimationState newState)
+void AnimationController::changeState(Entity entity, AnimationState newState, ECSRegistry& registry)
 {
 	if (currentState != newState)
 	{
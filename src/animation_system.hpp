@@ -1,7 +1,10 @@
 #include <unordered_map>
 #include "render_components.hpp"
+#include "pool_allocator.hpp"
 #pragma once
 
+class ECSRegistry;
+
 enum class AnimationState { Idle, Running, Jumping, Dead, Attack, Fading, Flying, Swooping, Default};
 
 // Represents a single animation sequence, including frame timing, frame count, and spritesheet
@@ -22,19 +25,32 @@ struct Animation
 };
 
 // Controls and manages animations for an entity by storing animations mapped to states
+// Nodes and buckets come from the pool of the registry the controller is created for
+using AnimationMap = std::unordered_map<AnimationState, Animation, std::hash<AnimationState>, std::equal_to<AnimationState>,
+	PoolAllocator<std::pair<const AnimationState, Animation>>>;
+
 struct AnimationController	
 {
-	std::unordered_map<AnimationState, Animation> animations;
+	AnimationMap animations;
 	AnimationState currentState;
 
-	AnimationController() : currentState(AnimationState::Idle) {}
+	// Create them through ECSRegistry::emplace_animation_controller, which passes the registry's pool
+	explicit AnimationController(PoolResource* pool)
+		: animations(AnimationMap::allocator_type(pool)), currentState(AnimationState::Idle) {}
 
 	void addAnimation(AnimationState state, float frameTime, int numFrames, TEXTURE_ASSET_ID spritesheet)
 	{
 		animations[state] = Animation(frameTime, numFrames, spritesheet);
 	}
     
-	void changeState(Entity entity, AnimationState newState);
+	void changeState(Entity entity, AnimationState newState, ECSRegistry& registry);
+};
+// approximate: the bucket array plus one node (value and next pointer) per animation
+template <> struct ComponentHeapBytes<AnimationController> {
+	static size_t of(const AnimationController& controller) {
+		return controller.animations.bucket_count() * sizeof(void*) +
+			controller.animations.size() * (sizeof(std::pair<const AnimationState, Animation>) + sizeof(void*));
+	}
 };
 
 void updateAnimation(Animation& animation, float deltaTime);
\ No newline at end of file
@@ -76,8 +76,8 @@ const int PHANTOM_TRAP_NUM_FRAMES = 8;
 const int PHANTOM_TRAP_FADE_FRAME_TIME = 100;
 const int PHANTOM_TRAP_FADE_NUM_FRAMES = 8;
 
-AnimationController& initJeffAnimationController(Entity& jeff) {
-    AnimationController& animationcontroller = registry.animationControllers.emplace(jeff);
+AnimationController& initJeffAnimationController(Entity& jeff, ECSRegistry& registry) {
+    AnimationController& animationcontroller = registry.emplace_animation_controller(jeff);
 	animationcontroller.addAnimation(AnimationState::Idle, JEFF_IDLE_FRAME_TIME, JEFF_IDLE_NUM_FRAMES, TEXTURE_ASSET_ID::JEFF_IDLE);
     animationcontroller.addAnimation(AnimationState::Running, JEFF_RUN_FRAME_TIME, JEFF_RUN_NUM_FRAMES, TEXTURE_ASSET_ID::JEFF_RUN);
 	animationcontroller.addAnimation(AnimationState::Jumping, JEFF_JUMP_FRAME_TIME, JEFF_JUMP_NUM_FRAMES, TEXTURE_ASSET_ID::JEFF_JUMP);
@@ -94,8 +94,8 @@ AnimationController& initJeffAnimationController(Entity& jeff) {
 }
 
 
-AnimationController& initBarbarianAnimationController(Entity& entity) {
-    AnimationController& animationcontroller = registry.animationControllers.emplace(entity);
+AnimationController& initBarbarianAnimationController(Entity& entity, ECSRegistry& registry) {
+    AnimationController& animationcontroller = registry.emplace_animation_controller(entity);
 	animationcontroller.addAnimation(AnimationState::Idle, BARBARIAN_IDLE_FRAME_TIME, BARBARIAN_IDLE_NUM_FRAMES, TEXTURE_ASSET_ID::BARBARIAN_IDLE);
     animationcontroller.addAnimation(AnimationState::Running, BARBARIAN_RUN_FRAME_TIME, BARBARIAN_RUN_NUM_FRAMES, TEXTURE_ASSET_ID::BARBARIAN_RUN);
 	animationcontroller.addAnimation(AnimationState::Dead, BARBARIAN_DEAD_FRAME_TIME, BARBARIAN_DEAD_NUM_FRAMES, TEXTURE_ASSET_ID::BARBARIAN_DEAD);
@@ -108,13 +108,13 @@ AnimationController& initBarbarianAnimationController(Entity& entity) {
 			GEOMETRY_BUFFER_ID::SPRITE
 		});
 
-	animationcontroller.changeState(entity, AnimationState::Running);
+	animationcontroller.changeState(entity, AnimationState::Running, registry);
 
     return animationcontroller;
 }
 
-AnimationController& initBoarAnimationController(Entity& entity) {
-    AnimationController& animationcontroller = registry.animationControllers.emplace(entity);
+AnimationController& initBoarAnimationController(Entity& entity, ECSRegistry& registry) {
+    AnimationController& animationcontroller = registry.emplace_animation_controller(entity);
 	animationcontroller.addAnimation(AnimationState::Idle, BOAR_IDLE_FRAME_TIME, BOAR_IDLE_NUM_FRAMES, TEXTURE_ASSET_ID::BOAR_IDLE);
     animationcontroller.addAnimation(AnimationState::Running, BOAR_RUN_FRAME_TIME, BOAR_RUN_NUM_FRAMES, TEXTURE_ASSET_ID::BOAR_RUN);
 	animationcontroller.addAnimation(AnimationState::Dead, BOAR_IDLE_FRAME_TIME, BOAR_IDLE_NUM_FRAMES, TEXTURE_ASSET_ID::BOAR_IDLE);
@@ -127,13 +127,13 @@ AnimationController& initBoarAnimationController(Entity& entity) {
 			GEOMETRY_BUFFER_ID::SPRITE
 		});
 
-	animationcontroller.changeState(entity, AnimationState::Running);
+	animationcontroller.changeState(entity, AnimationState::Running, registry);
 
     return animationcontroller;
 }
 
-AnimationController& initArcherAnimationController(Entity& entity) {
-    AnimationController& animationcontroller = registry.animationControllers.emplace(entity);
+AnimationController& initArcherAnimationController(Entity& entity, ECSRegistry& registry) {
+    AnimationController& animationcontroller = registry.emplace_animation_controller(entity);
 	animationcontroller.addAnimation(AnimationState::Idle, ARCHER_IDLE_FRAME_TIME, ARCHER_IDLE_NUM_FRAMES, TEXTURE_ASSET_ID::ARCHER_IDLE);
     animationcontroller.addAnimation(AnimationState::Running, ARCHER_RUN_FRAME_TIME, ARCHER_RUN_NUM_FRAMES, TEXTURE_ASSET_ID::ARCHER_RUN);
 	animationcontroller.addAnimation(AnimationState::Dead, ARCHER_DEAD_FRAME_TIME, ARCHER_DEAD_NUM_FRAMES, TEXTURE_ASSET_ID::ARCHER_DEAD);
@@ -147,13 +147,13 @@ AnimationController& initArcherAnimationController(Entity& entity) {
 			GEOMETRY_BUFFER_ID::SPRITE
 		});
 
-	animationcontroller.changeState(entity, AnimationState::Running);
+	animationcontroller.changeState(entity, AnimationState::Running, registry);
 
     return animationcontroller;
 }
 
-AnimationController& initBirdAnimationController(Entity& entity) {
-    AnimationController& animationcontroller = registry.animationControllers.emplace(entity);
+AnimationController& initBirdAnimationController(Entity& entity, ECSRegistry& registry) {
+    AnimationController& animationcontroller = registry.emplace_animation_controller(entity);
 	animationcontroller.addAnimation(AnimationState::Swooping, BIRD_SWOOP_FRAME_TIME, BIRD_SWOOP_NUM_FRAMES, TEXTURE_ASSET_ID::BIRD_SWOOP);
     animationcontroller.addAnimation(AnimationState::Flying, BIRD_FLY_FRAME_TIME, BIRD_FLY_NUM_FRAMES, TEXTURE_ASSET_ID::BIRD_FLY);
 	animationcontroller.addAnimation(AnimationState::Dead, BIRD_DEAD_FRAME_TIME, BIRD_DEAD_NUM_FRAMES, TEXTURE_ASSET_ID::BIRD_DEAD);
@@ -165,13 +165,13 @@ AnimationController& initBirdAnimationController(Entity& entity) {
 			EFFECT_ASSET_ID::ANIMATED_NORMAL,
 			GEOMETRY_BUFFER_ID::SPRITE
 		});
-	animationcontroller.changeState(entity, AnimationState::Flying);
+	animationcontroller.changeState(entity, AnimationState::Flying, registry);
 
 	return animationcontroller;
 }
 
-AnimationController& initWizardAnimationController(Entity& entity) {
-	AnimationController& animationcontroller = registry.animationControllers.emplace(entity);
+AnimationController& initWizardAnimationController(Entity& entity, ECSRegistry& registry) {
+	AnimationController& animationcontroller = registry.emplace_animation_controller(entity);
 	animationcontroller.addAnimation(AnimationState::Idle, WIZARD_IDLE_FRAME_TIME, WIZARD_IDLE_NUM_FRAMES, TEXTURE_ASSET_ID::WIZARD_IDLE);
 	animationcontroller.addAnimation(AnimationState::Running, WIZARD_RUN_FRAME_TIME, WIZARD_RUN_NUM_FRAMES, TEXTURE_ASSET_ID::WIZARD_RUN);
 	animationcontroller.addAnimation(AnimationState::Dead, WIZARD_DEAD_FRAME_TIME, WIZARD_DEAD_NUM_FRAMES, TEXTURE_ASSET_ID::WIZARD_DEAD);
@@ -184,13 +184,13 @@ AnimationController& initWizardAnimationController(Entity& entity) {
 			GEOMETRY_BUFFER_ID::SPRITE
 		});
 
-	animationcontroller.changeState(entity, AnimationState::Running);
+	animationcontroller.changeState(entity, AnimationState::Running, registry);
 
 	return animationcontroller;
 }
 
-AnimationController& initLightningAnimationController(Entity& entity) {
-	AnimationController& animationcontroller = registry.animationControllers.emplace(entity);
+AnimationController& initLightningAnimationController(Entity& entity, ECSRegistry& registry) {
+	AnimationController& animationcontroller = registry.emplace_animation_controller(entity);
 	animationcontroller.addAnimation(AnimationState::Attack, LIGHTNING_FRAME_TIME, LIGHTNING_NUM_FRAMES, TEXTURE_ASSET_ID::LIGHTNING);
 
 	registry.renderRequests.insert(
@@ -201,13 +201,13 @@ AnimationController& initLightningAnimationController(Entity& entity) {
 			GEOMETRY_BUFFER_ID::SPRITE
 		});
 
-	animationcontroller.changeState(entity, AnimationState::Attack);
+	animationcontroller.changeState(entity, AnimationState::Attack, registry);
 
 	return animationcontroller;
 }
 
-AnimationController& initFireballAnimationController(Entity& entity) {
-	AnimationController& animationcontroller = registry.animationControllers.emplace(entity);
+AnimationController& initFireballAnimationController(Entity& entity, ECSRegistry& registry) {
+	AnimationController& animationcontroller = registry.emplace_animation_controller(entity);
 	animationcontroller.addAnimation(AnimationState::Attack, FIREBALL_FRAME_TIME, FIREBALL_NUM_FRAMES, TEXTURE_ASSET_ID::FIREBALL);
 
 	registry.renderRequests.insert(
@@ -218,13 +218,13 @@ AnimationController& initFireballAnimationController(Entity& entity) {
 			GEOMETRY_BUFFER_ID::SPRITE
 		});
 
-	animationcontroller.changeState(entity, AnimationState::Attack);
+	animationcontroller.changeState(entity, AnimationState::Attack, registry);
 
 	return animationcontroller;
 }
 
-AnimationController& initTrollAnimationController(Entity& entity) {
-	AnimationController& animationcontroller = registry.animationControllers.emplace(entity);
+AnimationController& initTrollAnimationController(Entity& entity, ECSRegistry& registry) {
+	AnimationController& animationcontroller = registry.emplace_animation_controller(entity);
 	animationcontroller.addAnimation(AnimationState::Running, TROLL_RUN_FRAME_TIME, TROLL_RUN_NUM_FRAMES, TEXTURE_ASSET_ID::TROLL_RUN);
 	animationcontroller.addAnimation(AnimationState::Dead, TROLL_DEAD_FRAME_TIME, TROLL_DEAD_NUM_FRAMES, TEXTURE_ASSET_ID::TROLL_DEAD);
 
@@ -236,13 +236,13 @@ AnimationController& initTrollAnimationController(Entity& entity) {
 			GEOMETRY_BUFFER_ID::SPRITE
 		});
 
-	animationcontroller.changeState(entity, AnimationState::Running);
+	animationcontroller.changeState(entity, AnimationState::Running, registry);
 
 	return animationcontroller;
 }
 
-AnimationController& initHeartAnimationController(Entity& entity) {
-    AnimationController& animationcontroller = registry.animationControllers.emplace(entity);
+AnimationController& initHeartAnimationController(Entity& entity, ECSRegistry& registry) {
+    AnimationController& animationcontroller = registry.emplace_animation_controller(entity);
 	animationcontroller.addAnimation(AnimationState::Idle, COLLECTIBLE_IDLE_FRAME_TIME, COLLECTIBLE_IDLE_NUM_FRAMES, TEXTURE_ASSET_ID::HEART);
 	animationcontroller.addAnimation(AnimationState::Fading, COLLECTIBLE_FADE_FRAME_TIME, COLLECTIBLE_FADE_NUM_FRAMES, TEXTURE_ASSET_ID::HEART_FADE);
 
@@ -254,13 +254,13 @@ AnimationController& initHeartAnimationController(Entity& entity) {
 			GEOMETRY_BUFFER_ID::SPRITE
 		});
 
-	animationcontroller.changeState(entity, AnimationState::Idle);
+	animationcontroller.changeState(entity, AnimationState::Idle, registry);
 
     return animationcontroller;
 }
 
-AnimationController& initTrapBottleAnimationController(Entity& entity) {
-    AnimationController& animationcontroller = registry.animationControllers.emplace(entity);
+AnimationController& initTrapBottleAnimationController(Entity& entity, ECSRegistry& registry) {
+    AnimationController& animationcontroller = registry.emplace_animation_controller(entity);
 	animationcontroller.addAnimation(AnimationState::Idle, COLLECTIBLE_IDLE_FRAME_TIME, COLLECTIBLE_IDLE_NUM_FRAMES, TEXTURE_ASSET_ID::TRAPCOLLECTABLE);
 	animationcontroller.addAnimation(AnimationState::Fading, COLLECTIBLE_FADE_FRAME_TIME, COLLECTIBLE_FADE_NUM_FRAMES, TEXTURE_ASSET_ID::TRAPCOLLECTABLE_FADE);
 
@@ -272,13 +272,13 @@ AnimationController& initTrapBottleAnimationController(Entity& entity) {
 			GEOMETRY_BUFFER_ID::SPRITE
 		});
 
-	animationcontroller.changeState(entity, AnimationState::Idle);
+	animationcontroller.changeState(entity, AnimationState::Idle, registry);
 
     return animationcontroller;
 }
 
-AnimationController& initPhantomTrapAnimationController(Entity& entity) {
-	AnimationController& animationcontroller = registry.animationControllers.emplace(entity);
+AnimationController& initPhantomTrapAnimationController(Entity& entity, ECSRegistry& registry) {
+	AnimationController& animationcontroller = registry.emplace_animation_controller(entity);
 	animationcontroller.addAnimation(AnimationState::Idle, PHANTOM_TRAP_FRAME_TIME, PHANTOM_TRAP_NUM_FRAMES, TEXTURE_ASSET_ID::PHANTOM_TRAP_BOTTLE);
 	animationcontroller.addAnimation(AnimationState::Fading, PHANTOM_TRAP_FADE_FRAME_TIME, PHANTOM_TRAP_FADE_NUM_FRAMES, TEXTURE_ASSET_ID::PHANTOM_TRAP_BOTTLE_FADE);
 
@@ -290,13 +290,13 @@ AnimationController& initPhantomTrapAnimationController(Entity& entity) {
 			GEOMETRY_BUFFER_ID::SPRITE
 		});
 
-	animationcontroller.changeState(entity, AnimationState::Idle);
+	animationcontroller.changeState(entity, AnimationState::Idle, registry);
 
 	return animationcontroller;
 }
 
-AnimationController& initBomberAnimationController(Entity& entity) {
-	AnimationController& animationcontroller = registry.animationControllers.emplace(entity);
+AnimationController& initBomberAnimationController(Entity& entity, ECSRegistry& registry) {
+	AnimationController& animationcontroller = registry.emplace_animation_controller(entity);
 	animationcontroller.addAnimation(AnimationState::Idle, BOMBER_IDLE_FRAME_TIME, BOMBER_IDLE_NUM_FRAMES, TEXTURE_ASSET_ID::BOMBER_IDLE);
 	animationcontroller.addAnimation(AnimationState::Running, BOMBER_RUN_FRAME_TIME, BOMBER_RUN_NUM_FRAMES, TEXTURE_ASSET_ID::BOMBER_RUN);
 	animationcontroller.addAnimation(AnimationState::Dead, BOMBER_DEAD_FRAME_TIME, BOMBER_DEAD_NUM_FRAMES, TEXTURE_ASSET_ID::BOMBER_DEAD);
@@ -309,13 +309,13 @@ AnimationController& initBomberAnimationController(Entity& entity) {
 			GEOMETRY_BUFFER_ID::SPRITE
 		});
 
-	animationcontroller.changeState(entity, AnimationState::Running);
+	animationcontroller.changeState(entity, AnimationState::Running, registry);
 
 	return animationcontroller;
 }
 
-AnimationController& initExplosionAnimationController(Entity& entity) {
-    AnimationController& animationcontroller = registry.animationControllers.emplace(entity);
+AnimationController& initExplosionAnimationController(Entity& entity, ECSRegistry& registry) {
+    AnimationController& animationcontroller = registry.emplace_animation_controller(entity);
 	animationcontroller.addAnimation(AnimationState::Idle, 50, 10, TEXTURE_ASSET_ID::EXPLOSION);
 
     registry.renderRequests.insert(
@@ -326,13 +326,13 @@ AnimationController& initExplosionAnimationController(Entity& entity) {
 			GEOMETRY_BUFFER_ID::SPRITE
 		});
 
-	animationcontroller.changeState(entity, AnimationState::Idle);
+	animationcontroller.changeState(entity, AnimationState::Idle, registry);
 
     return animationcontroller;
 }
 
-AnimationController& initBowAnimationController(Entity& entity) {
-	AnimationController& animationcontroller = registry.animationControllers.emplace(entity);
+AnimationController& initBowAnimationController(Entity& entity, ECSRegistry& registry) {
+	AnimationController& animationcontroller = registry.emplace_animation_controller(entity);
 	animationcontroller.addAnimation(AnimationState::Idle, COLLECTIBLE_IDLE_FRAME_TIME, COLLECTIBLE_IDLE_NUM_FRAMES, TEXTURE_ASSET_ID::BOW);
 	animationcontroller.addAnimation(AnimationState::Fading, COLLECTIBLE_FADE_FRAME_TIME, COLLECTIBLE_FADE_NUM_FRAMES, TEXTURE_ASSET_ID::BOW_FADE);
 	animationcontroller.addAnimation(AnimationState::Attack, BOW_DRAW_FRAME_TIME, BOW_DRAW_NUM_FRAMES, TEXTURE_ASSET_ID::BOW_DRAW);
@@ -349,8 +349,8 @@ AnimationController& initBowAnimationController(Entity& entity) {
 	return animationcontroller;
 }
 
-AnimationController& initBombAnimationController(Entity& entity) {
-	AnimationController& animationcontroller = registry.animationControllers.emplace(entity);
+AnimationController& initBombAnimationController(Entity& entity, ECSRegistry& registry) {
+	AnimationController& animationcontroller = registry.emplace_animation_controller(entity);
 	animationcontroller.addAnimation(AnimationState::Idle, COLLECTIBLE_IDLE_FRAME_TIME, COLLECTIBLE_IDLE_NUM_FRAMES, TEXTURE_ASSET_ID::BOMB);
 	animationcontroller.addAnimation(AnimationState::Fading, COLLECTIBLE_FADE_FRAME_TIME, COLLECTIBLE_FADE_NUM_FRAMES, TEXTURE_ASSET_ID::BOMB_FADE);
 	animationcontroller.addAnimation(AnimationState::Attack, BOMB_FUSED_FRAME_TIME, BOMB_FUSED_NUM_FRAMES, TEXTURE_ASSET_ID::BOMB_FUSED);
@@ -2,21 +2,21 @@
 
 #include "animation_system.hpp"
 
-AnimationController& initJeffAnimationController(Entity& jeff);
-AnimationController& initBarbarianAnimationController(Entity& entity);
-AnimationController& initBoarAnimationController(Entity& entity);
-AnimationController& initArcherAnimationController(Entity& entity);
-AnimationController& initBirdAnimationController(Entity& entity);
-AnimationController& initWizardAnimationController(Entity& entity);
-AnimationController& initLightningAnimationController(Entity& entity);
-AnimationController& initFireballAnimationController(Entity& entity);
-AnimationController& initTrollAnimationController(Entity& entity);
-AnimationController& initBomberAnimationController(Entity& entity);
+AnimationController& initJeffAnimationController(Entity& jeff, ECSRegistry& registry);
+AnimationController& initBarbarianAnimationController(Entity& entity, ECSRegistry& registry);
+AnimationController& initBoarAnimationController(Entity& entity, ECSRegistry& registry);
+AnimationController& initArcherAnimationController(Entity& entity, ECSRegistry& registry);
+AnimationController& initBirdAnimationController(Entity& entity, ECSRegistry& registry);
+AnimationController& initWizardAnimationController(Entity& entity, ECSRegistry& registry);
+AnimationController& initLightningAnimationController(Entity& entity, ECSRegistry& registry);
+AnimationController& initFireballAnimationController(Entity& entity, ECSRegistry& registry);
+AnimationController& initTrollAnimationController(Entity& entity, ECSRegistry& registry);
+AnimationController& initBomberAnimationController(Entity& entity, ECSRegistry& registry);
 
-AnimationController& initHeartAnimationController(Entity& entity);
-AnimationController& initTrapBottleAnimationController(Entity& entity);
-AnimationController& initBowAnimationController(Entity& entity);
-AnimationController& initBombAnimationController(Entity& entity);
+AnimationController& initHeartAnimationController(Entity& entity, ECSRegistry& registry);
+AnimationController& initTrapBottleAnimationController(Entity& entity, ECSRegistry& registry);
+AnimationController& initBowAnimationController(Entity& entity, ECSRegistry& registry);
+AnimationController& initBombAnimationController(Entity& entity, ECSRegistry& registry);
 
-AnimationController& initExplosionAnimationController(Entity& entity);
-AnimationController& initPhantomTrapAnimationController(Entity& entity);
+AnimationController& initExplosionAnimationController(Entity& entity, ECSRegistry& registry);
+AnimationController& initPhantomTrapAnimationController(Entity& entity, ECSRegistry& registry);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "common.hpp" 
+#include "opengl.hpp"
 
 class Camera {
 private:
@@ -1,4 +1,5 @@
 #include "common.hpp"
+#include "opengl.hpp"
 #include <iostream>
 
 // Note, we could also use the functions from GLM but we write the transformations here to show the uderlying math
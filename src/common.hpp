@@ -5,11 +5,6 @@
 #include <tuple>
 #include <vector>
 
-// glfw (OpenGL)
-#define NOMINMAX
-#include <gl3w.h>
-#include <GLFW/glfw3.h>
-
 // The glm library provides vector and matrix operations as in GLSL
 #include <glm/vec2.hpp>				// vec2
 #include <glm/ext/vector_int2.hpp>  // ivec2
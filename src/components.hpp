@@ -10,6 +10,45 @@ game_save_manager.cpp (serialize and deserialize the attributes you are adding o
 
 */
 
+// Enum class plus the name of every value, both generated from one LIST(X) of X(VALUE, "name") entries.
+// Gameplay compares the values, the names are only used for save files and debug output.
+#define NAMED_ENUM_VALUE(value, name) value,
+#define NAMED_ENUM_NAME(value, name) name,
+#define DECLARE_NAMED_ENUM(Enum, LIST) \
+	enum class Enum { LIST(NAMED_ENUM_VALUE) COUNT }; \
+	inline const char* enum_name(Enum value) { \
+		static const char* const names[] = { LIST(NAMED_ENUM_NAME) }; \
+		return names[(int)value]; \
+	} \
+	inline bool enum_from_name(const std::string& name, Enum& value) { \
+		for (int i = 0; i < (int)Enum::COUNT; i++) \
+			if (name == enum_name((Enum)i)) { value = (Enum)i; return true; } \
+		return false; \
+	}
+
+#define ENEMY_TYPES(X) \
+	X(BOAR, "BOAR") X(BARBARIAN, "BARBARIAN") X(ARCHER, "ARCHER") X(BIRD, "BIRD") \
+	X(WIZARD, "WIZARD") X(TROLL, "TROLL") X(BOMBER, "BOMBER")
+DECLARE_NAMED_ENUM(ENEMY_TYPE, ENEMY_TYPES)
+
+#define DAMAGING_TYPES(X) \
+	X(ARROW, "arrow") X(FIREBALL, "fireball") X(LIGHTNING, "lightning")
+DECLARE_NAMED_ENUM(DAMAGING_TYPE, DAMAGING_TYPES)
+
+#define COLLECTIBLE_TYPES(X) \
+	X(HEART, "HEART") X(TRAP, "TRAP") X(PHANTOM_TRAP, "PHANTOM_TRAP") X(BOW, "BOW") X(BOMB, "BOMB")
+DECLARE_NAMED_ENUM(COLLECTIBLE_TYPE, COLLECTIBLE_TYPES)
+
+#define TRAP_TYPES(X) \
+	X(DAMAGE, "trap") X(PHANTOM, "phantom_trap")
+DECLARE_NAMED_ENUM(TRAP_TYPE, TRAP_TYPES)
+
+// Everything the spawn manager places on the map
+#define SPAWN_TYPES(X) \
+	X(BOAR, "boar") X(BARBARIAN, "barbarian") X(ARCHER, "archer") X(BIRD, "bird") X(WIZARD, "wizard") \
+	X(TROLL, "troll") X(BOMBER, "bomber") X(HEART, "heart") X(COLLECTIBLE_TRAP, "collectible_trap")
+DECLARE_NAMED_ENUM(SPAWN_TYPE, SPAWN_TYPES)
+
 
 // PlayerComponents 
 struct Player {
@@ -47,7 +86,7 @@ struct Enemy
 	int health = 100;
 	int maxHealth = 100;
 	int damage = 10;
-	std::string type;
+	ENEMY_TYPE type = ENEMY_TYPE::BOAR;
 	unsigned int cooldown = 0;
 	float pathfindTime = 0;
 	int points = 1;
@@ -63,7 +102,7 @@ struct Explosion {
 };
 
 struct Damaging {
-	std::string type = "arrow"; // default type
+	DAMAGING_TYPE type = DAMAGING_TYPE::ARROW; // default type
 	unsigned int damage = 10;
 	Entity excludedEntity;
 };
@@ -116,6 +155,15 @@ struct StaminaBar {
 	};
 };
 
+// Attaches an entity to a parent: its position follows the parent's at 'offset' and it is destroyed together with the
+// parent, see ECSRegistry::attach. Used for bars and indicators that hover over a character.
+struct Relationship {
+	Entity parent;
+	vec3 offset = { 0, 0, 0 };
+};
+// the registry re-sorts the hierarchy whenever relationships come or go
+template <> struct ObservedComponent<Relationship> : std::true_type {};
+
 // Collectible Component
 struct Collectible
 {
@@ -123,7 +171,7 @@ struct Collectible
 	float timer = 0; 
 	vec2 position = { 0, 0 };
 	vec2 scale = { 3, 3 };
-	std::string type;
+	COLLECTIBLE_TYPE type = COLLECTIBLE_TYPE::HEART;
 
 };
 
@@ -151,19 +199,45 @@ struct PhantomTrap : public BaseTrap
 	using BaseTrap::BaseTrap;
 };
 
-// All data relevant to the shape and motion of entities
+// The former all-in-one Motion, split by how often it is touched: physics and AI stream Motion every frame, the
+// shape is only read by collision checks and the presentation mostly by the renderer. Every entity with a Motion
+// also has a Shape and a Presentation, create them together with ECSRegistry::emplace_motion.
+
+// Kinematics, hot
 struct Motion {
 	vec3 position = { 0, 0, 0 };
-	float angle = 0;
 	vec3 velocity = { 0, 0, 0 };
 	float speed = 0;			// max voluntary speed
-	vec2 scale = { 10, 10 };	// only for rendering
-	vec2 facing = { 0, 0 };		// direction the entity is facing
+	float gravity = 1.0;			// 1 means affected by gravity normally, 0 is no gravity
+};
+
+// What a collidable is to the collision filter, the factories set it. Which layers are tested against each other
+// is one table in physics_system.cpp, pairs it doesn't list never reach the narrowphase.
+enum class COLLISION_LAYER {
+	NONE,           // cosmetic and UI-anchored motions, collide with nothing
+	MAP_TILE,
+	PLAYER,
+	ENEMY,
+	PROJECTILE,     // arrows, bombs and thrown traps, solid while flying and lying on the ground
+	DAMAGING,       // fireballs, lightning and explosions
+	OBSTACLE,       // rocks, shrubs, trees and cliffs
+	COLLECTIBLE,
+	TRAP,
+	LAYER_COUNT
+};
 
-	// Hitbox
+// Collision shape
+struct Shape {
 	vec3 hitbox = { 0, 0, 0 };
-	float gravity = 1.0;			// 1 means affected by gravity normally, 0 is no gravity
 	bool solid = false;
+	COLLISION_LAYER layer = COLLISION_LAYER::NONE;
+};
+
+// Orientation and size on screen
+struct Presentation {
+	float angle = 0;
+	vec2 scale = { 10, 10 };	// only for rendering
+	vec2 facing = { 0, 0 };		// direction the entity is facing
 };
 
 // Stucture to store collision information
@@ -210,7 +284,7 @@ struct Knocker
 
 struct TrapsCounter {
 	// <trap type, <number of traps, trap text entity>>
-	std::unordered_map<std::string, std::pair<int, Entity>> trapsMap;
+	std::unordered_map<TRAP_TYPE, std::pair<int, Entity>> trapsMap;
 
 	void reset() {
 		// reset trap counts to 0
@@ -228,6 +302,13 @@ struct Obstacle {
 
 };
 
+// Collidable that never moves on the ground plane (obstacles, trees, cliffs, map tiles). Physics keeps these in a
+// hierarchy built once instead of its per-frame grid and never tests two of them against each other.
+struct StaticBody {
+};
+// physics rebuilds its static hierarchy whenever static bodies come or go
+template <> struct ObservedComponent<StaticBody> : std::true_type {};
+
 struct TargetArea {
 };
 
@@ -244,6 +325,12 @@ struct Text {
 	TEXT_ALIGNMENT alignment = TEXT_ALIGNMENT::LEFT;
 	float lineSpacing = 1.3f;
 };
+// short strings live inside the string object itself
+template <> struct ComponentHeapBytes<Text> {
+	static size_t of(const Text& text) {
+		return text.value.capacity() + 1 > sizeof(std::string) ? text.value.capacity() + 1 : 0;
+	}
+};
 
 struct SlideUp {
 	float animationLength = 1500;
@@ -261,6 +348,12 @@ struct TextChar {
     unsigned int advance;    // Offset to advance to next glyph
 };
 
+// Registry memory overlay shown next to the fps counter
+struct MemoryTracker {
+	Entity textEntity;
+	bool toggled = false;
+};
+
 struct FPSTracker {
 	int fps = 0;
 	int counter = 0;
@@ -356,7 +449,7 @@ struct Bomber {
 struct Heart { unsigned int health = 20; };
 struct CollectibleTrap 
 { 
-	std::string type = "trap"; 
+	TRAP_TYPE type = TRAP_TYPE::DAMAGE; 
 };
 struct Bow {};
 struct CollectibleBomb {};
@@ -12,6 +12,10 @@
 #include <vector>
 #include <fstream>
 
+GameSaveManager::GameSaveManager(ECSRegistry& registry) : registry(registry)
+{
+}
+
 void GameSaveManager::init(RenderSystem* renderer, GLFWwindow* window, Camera* camera) {
 	this->renderer = renderer;
 	this->window = window;
@@ -19,7 +23,7 @@ void GameSaveManager::init(RenderSystem* renderer, GLFWwindow* window, Camera* c
 }
 
 // Serialize the game state to a JSON file
-void GameSaveManager::save_game(std::unordered_map<std::string, std::pair<int, Entity>> trapsCounter, std::unordered_map<std::string, float> spawn_delays, std::unordered_map<std::string, int> max_entities, std::unordered_map<std::string, float> next_spawns) {
+void GameSaveManager::save_game(std::unordered_map<TRAP_TYPE, std::pair<int, Entity>> trapsCounter, std::unordered_map<SPAWN_TYPE, float> spawn_delays, std::unordered_map<SPAWN_TYPE, int> max_entities, std::unordered_map<SPAWN_TYPE, float> next_spawns) {
 	json j;
 
 	serialize_containers(j, trapsCounter, spawn_delays, max_entities, next_spawns);
@@ -34,7 +38,8 @@ void GameSaveManager::save_game(std::unordered_map<std::string, std::pair<int, E
 	}
 }
 
-void GameSaveManager::serialize_containers(json& j, std::unordered_map<std::string, std::pair<int, Entity>> trapsCounter, std::unordered_map<std::string, float> spawn_delays, std::unordered_map<std::string, int> max_entities, std::unordered_map<std::string, float> next_spawns) {
+void GameSaveManager::serialize_containers(json& j, std::unordered_map<TRAP_TYPE, std::pair<int, Entity>> trapsCounter, std::unordered_map<SPAWN_TYPE, float> spawn_delays, std::unordered_map<SPAWN_TYPE, int> max_entities, std::unordered_map<SPAWN_TYPE, float> next_spawns) {
+	j[SAVEVERSION] = SAVE_VERSION;
 	j[GAMETIMER] = serialize_game_timer(registry.gameTimer);
 	j[GAMESCORE] = serialize_game_score(registry.gameScore);
 	j[TRAPCOUNTER] = serialize_traps_counter(trapsCounter);
@@ -42,46 +47,28 @@ void GameSaveManager::serialize_containers(json& j, std::unordered_map<std::stri
 	j[MAXENTITIES] = serialize_max_entities(max_entities);
 	j[NEXTSPAWNS] = serialize_next_spawns(next_spawns);
 
-	// Serialize all component containers
-	j[PLAYERS] = serialize_container<Player>(registry.players);
-	j[DASHERS] = serialize_container<Dash>(registry.dashers);
-	j[ENEMIES] = serialize_container<Enemy>(registry.enemies);
-	j[MOTIONS] = serialize_container<Motion>(registry.motions);
-	j[COLLISIONS] = serialize_container<Collision>(registry.collisions);
-	j[COOLDOWNS] = serialize_container<Cooldown>(registry.cooldowns);
-	j[COLLECTIBLES] = serialize_container<Collectible>(registry.collectibles);
-	j[TRAPS] = serialize_container<Trap>(registry.traps);
-	j[DAMAGEDS] = serialize_container<Damaged>(registry.damageds);
-	j[DAMAGINGS] = serialize_container<Damaging>(registry.damagings);
-	j[DEATHTIMERS] = serialize_container<DeathTimer>(registry.deathTimers);
-	j[KNOCKABLES] = serialize_container<Knockable>(registry.knockables);
-	j[KNOCKERS] = serialize_container<Knocker>(registry.knockers);
-	j[TRAPPABLES] = serialize_container<Trappable>(registry.trappables);
-	j[HEALTHBARS] = serialize_container<HealthBar>(registry.healthBars);
-	j[ANIMATIONCONTROLLERS] = serialize_container<AnimationController>(registry.animationControllers);
-	j[STAMINABARS] = serialize_container<StaminaBar>(registry.staminaBars);
-	j[STAMINAS] = serialize_container<Stamina>(registry.staminas);
-	j[TEXTS] = serialize_container<Text>(registry.texts);
-	j[JUMPERS] = serialize_container<Jumper>(registry.jumpers);
-	j[MAPTILES] = serialize_container<MapTile>(registry.mapTiles);
-	j[OBSTACLES] = serialize_container<Obstacle>(registry.obstacles);
-	j[PROJECTILES] = serialize_container<Projectile>(registry.projectiles);
-	j[MESHPTRS] = serialize_mesh_container(registry.meshPtrs); // SPECIAL CASE
-	j[TARGETAREAS] = serialize_container<TargetArea>(registry.targetAreas);
-	j[COLLECTED] = serialize_container<Collected>(registry.collected);
-	j[RENDERREQUESTS] = serialize_container<RenderRequest>(registry.renderRequests);
-	j[BACKGROUNDS] = serialize_container<Background>(registry.backgrounds);
-	j[MIDGROUNDS] = serialize_container<Midground>(registry.midgrounds);
-	j[FOREGROUNDS] = serialize_container<Foreground>(registry.foregrounds);
-	j[COLOURS] = serialize_container<vec4>(registry.colours);
-	j[BOARS] = serialize_container<Boar>(registry.boars);
-	j[BARBARIANS] = serialize_container<Barbarian>(registry.barbarians);
-	j[ARCHERS] = serialize_container<Archer>(registry.archers);
-	j[BIRDS] = serialize_container<Bird>(registry.birds);
-	j[WIZARDS] = serialize_container<Wizard>(registry.wizards);
-	j[TROLLS] = serialize_container<Troll>(registry.trolls);
-	j[HEARTS] = serialize_container<Heart>(registry.hearts);
-	j[COLLECTIBLETRAPS] = serialize_container<CollectibleTrap>(registry.collectibleTraps);
+	// Serialize all component containers, keyed by their member name in the registry
+	registry.for_each_container([&](const char* name, const auto& container) {
+		save_container(j, name, container);
+	});
+}
+
+template <typename Component>
+void GameSaveManager::save_container(json& j, const char* name, const ComponentContainer<Component>& container) {
+	save_container(j, name, container, std::integral_constant<bool, !TransientComponent<Component>::value>());
+}
+
+template <typename Component>
+void GameSaveManager::save_container(json& j, const char* name, const ComponentContainer<Component>& container, std::true_type) {
+	j[name] = serialize_container<Component>(container);
+}
+
+template <typename Component>
+void GameSaveManager::save_container(json& j, const char* name, const ComponentContainer<Component>& container, std::false_type) {
+}
+
+void GameSaveManager::save_container(json& j, const char* name, const ComponentContainer<Mesh*>& container) {
+	j[name] = serialize_mesh_container(container); // SPECIAL CASE
 }
 
 template <typename Component>
@@ -148,37 +135,37 @@ nlohmann::json GameSaveManager::serialize_game_score(const GameScore& gameScore)
 	return j;
 }
 
-nlohmann::json GameSaveManager::serialize_spawn_delays(std::unordered_map<std::string, float> spawn_delays) {
+nlohmann::json GameSaveManager::serialize_spawn_delays(std::unordered_map<SPAWN_TYPE, float> spawn_delays) {
 	nlohmann::json j;
 	for (const auto& delay : spawn_delays) {
-		j[delay.first] = delay.second;
+		j[enum_name(delay.first)] = delay.second;
 	}
 	return j;
 }
 
-nlohmann::json GameSaveManager::serialize_max_entities(std::unordered_map<std::string, int> max_entities) {
+nlohmann::json GameSaveManager::serialize_max_entities(std::unordered_map<SPAWN_TYPE, int> max_entities) {
 	nlohmann::json j;
 	for (const auto& max : max_entities) {
-		j[max.first] = max.second;
+		j[enum_name(max.first)] = max.second;
 	}
 	return j;
 }
 
-nlohmann::json GameSaveManager::serialize_next_spawns(std::unordered_map<std::string, float> next_spawns) {
+nlohmann::json GameSaveManager::serialize_next_spawns(std::unordered_map<SPAWN_TYPE, float> next_spawns) {
 	nlohmann::json j;
 	for (const auto& next : next_spawns) {
-		j[next.first] = next.second;
+		j[enum_name(next.first)] = next.second;
   }
 	return j;
 }
 
-nlohmann::json GameSaveManager::serialize_traps_counter(std::unordered_map<std::string, std::pair<int, Entity>> trapsCounter) {
+nlohmann::json GameSaveManager::serialize_traps_counter(std::unordered_map<TRAP_TYPE, std::pair<int, Entity>> trapsCounter) {
 	nlohmann::json j;
 	for (const auto& trap : trapsCounter) {
 		nlohmann::json trapData;
 		trapData["count"] = trap.second.first;
 		trapData["textEntity"] = trap.second.second.getId();
-		j[trap.first] = trapData;
+		j[enum_name(trap.first)] = trapData;
 	}
 	return j;
 }
@@ -215,7 +202,7 @@ nlohmann::json GameSaveManager::serialize_component<Enemy>(const Enemy& enemy) {
 	j["health"] = enemy.health;
 	j["maxHealth"] = enemy.maxHealth;
 	j["damage"] = enemy.damage;
-	j["type"] = enemy.type;
+	j["type"] = enum_name(enemy.type);
 	j["cooldown"] = enemy.cooldown;
 	j["pathfindTime"] = enemy.pathfindTime;
 	return j;
@@ -225,14 +212,26 @@ template<>
 nlohmann::json GameSaveManager::serialize_component<Motion>(const Motion& motion) {
 	nlohmann::json j;
 	j["position"] = { motion.position.x, motion.position.y, motion.position.z };
-	j["angle"] = motion.angle;
 	j["velocity"] = { motion.velocity.x, motion.velocity.y, motion.velocity.z };
 	j["speed"] = motion.speed;
-	j["scale"] = { motion.scale.x, motion.scale.y };
-	j["facing"] = { motion.facing.x, motion.facing.y };
-	j["hitbox"] = { motion.hitbox.x, motion.hitbox.y, motion.hitbox.z };
 	j["gravity"] = motion.gravity;
-	j["solid"] = motion.solid;
+	return j;
+}
+
+template<>
+nlohmann::json GameSaveManager::serialize_component<Shape>(const Shape& shape) {
+	nlohmann::json j;
+	j["hitbox"] = { shape.hitbox.x, shape.hitbox.y, shape.hitbox.z };
+	j["solid"] = shape.solid;
+	return j;
+}
+
+template<>
+nlohmann::json GameSaveManager::serialize_component<Presentation>(const Presentation& presentation) {
+	nlohmann::json j;
+	j["angle"] = presentation.angle;
+	j["scale"] = { presentation.scale.x, presentation.scale.y };
+	j["facing"] = { presentation.facing.x, presentation.facing.y };
 	return j;
 }
 
@@ -281,7 +280,7 @@ nlohmann::json GameSaveManager::serialize_component<Damaged>(const Damaged& dama
 template<>
 nlohmann::json GameSaveManager::serialize_component<Damaging>(const Damaging& damaging) {
 	nlohmann::json j;
-	j["type"] = damaging.type;
+	j["type"] = enum_name(damaging.type);
 	j["damage"] = damaging.damage;
 	return j;
 }
@@ -570,6 +569,13 @@ bool GameSaveManager::load_game() {
 		}
 		file.close();
 
+		int version = j.value(SAVEVERSION, 1);
+		if (version > SAVE_VERSION) {
+			std::cout << "Save file is from a newer version of the game" << std::endl;
+			return false;
+		}
+		upgrade_save(j, version);
+
 		registry.clear_all_components();
 
 		// group all components that belong to the same entity
@@ -584,6 +590,22 @@ bool GameSaveManager::load_game() {
 	return true;
 }
 
+// Rewrite a save from an older version into the current layout
+void GameSaveManager::upgrade_save(json& j, int version) {
+	// Version 1 kept the hitbox, solid, angle, scale and facing in the motions, before Motion was split up
+	if (version < 2 && j.contains(MOTIONS)) {
+		json& motions = j[MOTIONS];
+		json shapes = { { "entities", motions["entities"] }, { "components", json::array() } };
+		json presentations = { { "entities", motions["entities"] }, { "components", json::array() } };
+		for (json& motion : motions["components"]) {
+			shapes["components"].push_back({ { "hitbox", motion["hitbox"] }, { "solid", motion["solid"] } });
+			presentations["components"].push_back({ { "angle", motion["angle"] }, { "scale", motion["scale"] }, { "facing", motion["facing"] } });
+		}
+		j[SHAPES] = shapes;
+		j[PRESENTATIONS] = presentations;
+	}
+}
+
 // Group all components that belong to the same entity
 void GameSaveManager::groupComponentsForEntities(const json& j) {
 	// group all components that belong to the same entity
@@ -593,7 +615,7 @@ void GameSaveManager::groupComponentsForEntities(const json& j) {
 		auto& container = item.value();
 
 		// skip gameTimer and gameScore
-		if (containerName == GAMETIMER || containerName == GAMESCORE || containerName == TRAPCOUNTER ||
+		if (containerName == SAVEVERSION || containerName == GAMETIMER || containerName == GAMESCORE || containerName == TRAPCOUNTER ||
 			containerName == NEXTSPAWNS || containerName == MAXENTITIES || containerName == SPAWNDELAYS) {
 			continue;
 		}
@@ -639,10 +661,10 @@ void GameSaveManager::deserialize_containers(const json& j) {
 	}
 
 	// set up background components
-	createMapTiles();
-	createCliffs(window);
+	createMapTiles(registry);
+	createCliffs(window, registry);
 	// TODO - creating trees like this
-	// createTrees(renderer);
+	// createTrees(renderer, registry);
 
 	deserialize_game_timer(j);
 	deserialize_game_score(j);
@@ -701,22 +723,22 @@ void GameSaveManager::createEntity(std::vector<std::string> componentNames, std:
 
 void GameSaveManager::createObstacleDeserialization(std::map<std::string, nlohmann::json> componentsMap) {
 	vec2 position = { (float)componentsMap[MOTIONS]["position"][0], (float)componentsMap[MOTIONS]["position"][1] };
-	vec2 scale = { (float)componentsMap[MOTIONS]["scale"][0], (float)componentsMap[MOTIONS]["scale"][1] };
+	vec2 scale = { (float)componentsMap[PRESENTATIONS]["scale"][0], (float)componentsMap[PRESENTATIONS]["scale"][1] };
 	TEXTURE_ASSET_ID textureAssetID = (TEXTURE_ASSET_ID)componentsMap[RENDERREQUESTS]["used_texture"];
-	createObstacle(position, scale, textureAssetID);
+	createObstacle(position, scale, textureAssetID, registry);
 }
 
 void GameSaveManager::createPlayerDeserialization(std::map<std::string, nlohmann::json> componentsMap) {
 	// motion data
 	vec2 position = { (float)componentsMap[MOTIONS]["position"][0], (float)componentsMap[MOTIONS]["position"][1] };
-	Entity jeff = createJeff(position);
+	Entity jeff = createJeff(position, registry);
 
 	// essential values to update
 	Player& player = registry.players.get(jeff);
 	player.health = componentsMap[PLAYERS]["health"];
 
-	Motion& motion = registry.motions.get(jeff);
-	motion.facing = { (float)componentsMap[MOTIONS]["facing"][0], (float)componentsMap[MOTIONS]["facing"][1] };
+	Presentation& presentation = registry.presentations.get(jeff);
+	presentation.facing = { (float)componentsMap[PRESENTATIONS]["facing"][0], (float)componentsMap[PRESENTATIONS]["facing"][1] };
 
 	Stamina& stamina = registry.staminas.get(jeff);
 	stamina.stamina = componentsMap[STAMINAS]["stamina"];
@@ -726,14 +748,14 @@ void GameSaveManager::createPlayerDeserialization(std::map<std::string, nlohmann
 
 	handleKnockable(jeff, componentsMap);
 
-	createPlayerUIHealthBar(camera->getSize());
-	createPlayerUIStaminaBar(camera->getSize());
+	createPlayerUIHealthBar(camera->getSize(), registry);
+	createPlayerUIStaminaBar(camera->getSize(), registry);
 }
 
 void GameSaveManager::createBoarDeserialization(std::map<std::string, nlohmann::json> componentsMap) {
 	// motion data
 	vec2 boarPosition = { (float) componentsMap[MOTIONS]["position"][0], (float) componentsMap[MOTIONS]["position"][1] };
-	Entity boar = createBoar(boarPosition);
+	Entity boar = createBoar(boarPosition, registry);
 
 	handleBoar(boar, componentsMap);
 	handleDasher(boar, componentsMap);
@@ -753,7 +775,7 @@ void GameSaveManager::createBoarDeserialization(std::map<std::string, nlohmann::
 void GameSaveManager::createBarbarianDeserialization(std::map<std::string, nlohmann::json> componentsMap) {
 	// motion data
 	vec2 barbarianPosition = { (float)componentsMap[MOTIONS]["position"][0], (float)componentsMap[MOTIONS]["position"][1] };
-	Entity barbarian = createBarbarian(barbarianPosition);
+	Entity barbarian = createBarbarian(barbarianPosition, registry);
 
 	// essential values to update
 	if (componentsMap.find(DEATHTIMERS) != componentsMap.end()) {
@@ -771,7 +793,7 @@ void GameSaveManager::createBarbarianDeserialization(std::map<std::string, nlohm
 void GameSaveManager::createArcherDeserialization(std::map<std::string, nlohmann::json> componentsMap) {
 	// motion data
 	vec2 archerPosition = { (float)componentsMap[MOTIONS]["position"][0], (float)componentsMap[MOTIONS]["position"][1] };
-	Entity archer = createArcher(archerPosition);
+	Entity archer = createArcher(archerPosition, registry);
 
 	// essential values to update
 	handleArcher(archer, componentsMap);
@@ -792,7 +814,7 @@ void GameSaveManager::createBirdDeserialization(std::map<std::string, nlohmann::
 	
 	// motion data
 	vec2 position = { (float)componentsMap[MOTIONS]["position"][0], (float)componentsMap[MOTIONS]["position"][1] };
-	Entity bird = createBird(position);
+	Entity bird = createBird(position, registry);
 
 	handleBird(bird, componentsMap);
 
@@ -811,7 +833,7 @@ void GameSaveManager::createBirdDeserialization(std::map<std::string, nlohmann::
 void GameSaveManager::createWizardDeserialization(std::map<std::string, nlohmann::json> componentsMap) {
 	// motion data
 	vec2 wizardPosition = { (float)componentsMap[MOTIONS]["position"][0], (float)componentsMap[MOTIONS]["position"][1] };
-	Entity wizard = createWizard(wizardPosition);
+	Entity wizard = createWizard(wizardPosition, registry);
 
 	handleWizard(wizard, componentsMap);
 
@@ -830,7 +852,7 @@ void GameSaveManager::createWizardDeserialization(std::map<std::string, nlohmann
 void GameSaveManager::createTrollDeserialization(std::map<std::string, nlohmann::json> componentsMap) {
 	// motion data
 	vec2 trollPosition = { (float)componentsMap[MOTIONS]["position"][0], (float)componentsMap[MOTIONS]["position"][1] };
-	Entity troll = createTroll(trollPosition);
+	Entity troll = createTroll(trollPosition, registry);
 
 	handleTroll(troll, componentsMap);
 
@@ -849,7 +871,7 @@ void GameSaveManager::createTrollDeserialization(std::map<std::string, nlohmann:
 void GameSaveManager::createHeartDeserialization(std::map<std::string, nlohmann::json> componentsMap) {
 	// motion data
 	vec2 heartPosition = { (float)componentsMap[MOTIONS]["position"][0], (float)componentsMap[MOTIONS]["position"][1] };
-	Entity heart = createHeart(heartPosition);
+	Entity heart = createHeart(heartPosition, registry);
 
 	handleMotion(heart, componentsMap);
 }
@@ -857,14 +879,14 @@ void GameSaveManager::createHeartDeserialization(std::map<std::string, nlohmann:
 void GameSaveManager::createCollectibleTrapDeserialization(std::map<std::string, nlohmann::json> componentsMap) {
 	// motion data
 	vec2 collectibleTrapPosition = { (float)componentsMap[MOTIONS]["position"][0], (float)componentsMap[MOTIONS]["position"][1] };
-	Entity collectibleTrap = createCollectibleTrap(collectibleTrapPosition);
+	Entity collectibleTrap = createCollectibleTrap(collectibleTrapPosition, registry);
 	handleMotion(collectibleTrap, componentsMap);
 }
 
 void GameSaveManager::createTrapDeserialization(std::map<std::string, nlohmann::json> componentsMap) {
 	// motion data
 	vec2 trapPosition = { (float)componentsMap[MOTIONS]["position"][0], (float)componentsMap[MOTIONS]["position"][1] };
-	Entity damageTrap = createDamageTrap(trapPosition);
+	Entity damageTrap = createDamageTrap(trapPosition, registry);
 
 	Trap& damageTrapComponent = registry.traps.get(damageTrap);
 	damageTrapComponent.position = { (float)componentsMap[TRAPS]["position"][0], (float)componentsMap[TRAPS]["position"][1] };
@@ -875,34 +897,35 @@ void GameSaveManager::createTrapDeserialization(std::map<std::string, nlohmann::
 void GameSaveManager::createTreeDeserialization(std::map<std::string, nlohmann::json> componentsMap) {
 	// motion data
 	vec2 position = { (float)componentsMap[MOTIONS]["position"][0], (float)componentsMap[MOTIONS]["position"][1] };
-	createTree(renderer, position);
+	createTree(renderer, position, registry);
 }
 
 void GameSaveManager::createTargetAreaDeserialization(std::map<std::string, nlohmann::json> componentsMap) {
 	vec3 position = { (float)componentsMap[MOTIONS]["position"][0], (float)componentsMap[MOTIONS]["position"][1], 0 };
-	Entity targetArea = createTargetArea(position);
+	Entity targetArea = createTargetArea(position, registry);
 
 	handleMotion(targetArea, componentsMap);
 	handleCooldown(targetArea, componentsMap);
 }
 
 void GameSaveManager::createDamagingsDeserialization(std::map<std::string, nlohmann::json> componentsMap) {
-	std::string type = componentsMap[DAMAGINGS]["type"];
+	DAMAGING_TYPE type = DAMAGING_TYPE::ARROW;
+	enum_from_name(componentsMap[DAMAGINGS]["type"].get<std::string>(), type);
 	float damage = (float) componentsMap[DAMAGINGS]["damage"];
 
 	vec3 position = { (float)componentsMap[MOTIONS]["position"][0], (float)componentsMap[MOTIONS]["position"][1], (float)componentsMap[MOTIONS]["position"][2] };
 	vec3 velocity = { (float)componentsMap[MOTIONS]["velocity"][0], (float)componentsMap[MOTIONS]["velocity"][1], (float)componentsMap[MOTIONS]["velocity"][2] };
 
-	if (type == "arrow") {
-		createArrow(position, velocity, damage);
+	if (type == DAMAGING_TYPE::ARROW) {
+		createArrow(position, velocity, damage, registry);
 	}
-	else if (type == "fireball") {
-		float angle = (float) componentsMap[MOTIONS]["angle"];
+	else if (type == DAMAGING_TYPE::FIREBALL) {
+		float angle = (float) componentsMap[PRESENTATIONS]["angle"];
 		vec2 direction = vec2(cos(angle), sin(angle));
-		createFireball(position, direction);
+		createFireball(position, direction, registry);
 	}
-	else if (type == "lightning") {
-		createLightning(position);
+	else if (type == DAMAGING_TYPE::LIGHTNING) {
+		createLightning(position, registry);
 	}
 }
 
@@ -925,36 +948,44 @@ void GameSaveManager::deserialize_game_score(const json& j) {
 void GameSaveManager::deserialize_spawn_delays(const json& j) {
 	auto& spawnDelaysJ = j.at(SPAWNDELAYS);
 	for (const auto& delay : spawnDelaysJ.items()) {
-		spawnDelays[delay.key()] = delay.value().get<float>();
+		SPAWN_TYPE type;
+		if (enum_from_name(delay.key(), type))
+			spawnDelays[type] = delay.value().get<float>();
 	}
 }
 
 void GameSaveManager::deserialize_max_entities(const json& j) {
 	auto& maxEntitiesJ = j[MAXENTITIES];
 	for (const auto& max : maxEntitiesJ.items()) {
-		maxEntities[max.key()] = max.value().get<int>();
+		SPAWN_TYPE type;
+		if (enum_from_name(max.key(), type))
+			maxEntities[type] = max.value().get<int>();
 	}
 }
 
 void GameSaveManager::deserialize_next_spawns(const json& j) {
 	auto& nextSpawnsJ = j[NEXTSPAWNS];
 	for (const auto& next : nextSpawnsJ.items()) {
-		nextSpawns[next.key()] = next.value().get<float>();
+		SPAWN_TYPE type;
+		if (enum_from_name(next.key(), type))
+			nextSpawns[type] = next.value().get<float>();
     	}
 }
 
 void GameSaveManager::deserialize_traps_counter(const json& j) {
 	for (const auto& trap : j[TRAPCOUNTER].items()) {
-		std::string trapName = trap.key();
+		TRAP_TYPE trapType;
+		if (!enum_from_name(trap.key(), trapType))
+			continue;
 		int count = trap.value()["count"];
 		Entity textEntity;
-		if (trapName == "trap") {
-			textEntity = createItemCountText(camera->getSize(), TEXTURE_ASSET_ID::TRAPCOLLECTABLE);
+		if (trapType == TRAP_TYPE::DAMAGE) {
+			textEntity = createItemCountText(camera->getSize(), TEXTURE_ASSET_ID::TRAPCOLLECTABLE, registry);
 		}
 		else {
-			textEntity = createItemCountText(camera->getSize(), TEXTURE_ASSET_ID::PHANTOM_TRAP_BOTTLE_ONE);
+			textEntity = createItemCountText(camera->getSize(), TEXTURE_ASSET_ID::PHANTOM_TRAP_BOTTLE_ONE, registry);
 		}
-		this->trapsCounter[trapName] = std::make_pair(count, textEntity);
+		this->trapsCounter[trapType] = std::make_pair(count, textEntity);
 	}
 }
 
@@ -966,25 +997,26 @@ void GameSaveManager::handleDeathTimer(Entity& entity, std::map<std::string, nlo
 
 	DeathTimer& deathTimer = registry.deathTimers.emplace(entity);
 	AnimationController& animationController = registry.animationControllers.get(entity);
-	animationController.changeState(entity, AnimationState::Dead);
+	animationController.changeState(entity, AnimationState::Dead, registry);
 	deathTimer.timer = componentsMap[DEATHTIMERS]["timer"];
+	// like an enemy that died in play: the attached bar stays empty until the enemy is destroyed
 	HealthBar& hpbar = registry.healthBars.get(entity);
-	registry.remove_all_components_of(hpbar.meshEntity);
-	registry.remove_all_components_of(hpbar.frameEntity);
-	registry.healthBars.remove(entity);
+	registry.presentations.get(hpbar.meshEntity).scale.x = 0;
 }
 
 void GameSaveManager::handleMotion(Entity& entity, std::map<std::string, nlohmann::json> componentsMap) {
 	Motion& motion = registry.motions.get(entity);
+	Shape& shape = registry.shapes.get(entity);
+	Presentation& presentation = registry.presentations.get(entity);
 	motion.position = vec3((float)componentsMap[MOTIONS]["position"][0], (float)componentsMap[MOTIONS]["position"][1], (float)componentsMap[MOTIONS]["position"][2]);
-	motion.angle = componentsMap[MOTIONS]["angle"];
+	presentation.angle = componentsMap[PRESENTATIONS]["angle"];
 	motion.velocity = { (float)componentsMap[MOTIONS]["velocity"][0], (float)componentsMap[MOTIONS]["velocity"][1], 0 };
 	motion.speed = componentsMap[MOTIONS]["speed"];
-	motion.scale = { (float)componentsMap[MOTIONS]["scale"][0], (float)componentsMap[MOTIONS]["scale"][1] };
-	motion.facing = { (float)componentsMap[MOTIONS]["facing"][0], (float)componentsMap[MOTIONS]["facing"][1] };
-	motion.hitbox = { (float)componentsMap[MOTIONS]["hitbox"][0], (float)componentsMap[MOTIONS]["hitbox"][1], (float)componentsMap[MOTIONS]["hitbox"][2] };
 	motion.gravity = componentsMap[MOTIONS]["gravity"];
-	motion.solid = componentsMap[MOTIONS]["solid"];
+	presentation.scale = { (float)componentsMap[PRESENTATIONS]["scale"][0], (float)componentsMap[PRESENTATIONS]["scale"][1] };
+	presentation.facing = { (float)componentsMap[PRESENTATIONS]["facing"][0], (float)componentsMap[PRESENTATIONS]["facing"][1] };
+	shape.hitbox = { (float)componentsMap[SHAPES]["hitbox"][0], (float)componentsMap[SHAPES]["hitbox"][1], (float)componentsMap[SHAPES]["hitbox"][2] };
+	shape.solid = componentsMap[SHAPES]["solid"];
 }
 
 void GameSaveManager::handleTrappable(Entity& entity, std::map<std::string, nlohmann::json> componentsMap) {
@@ -997,7 +1029,7 @@ void GameSaveManager::handleEnemy(Entity& entity, std::map<std::string, nlohmann
 	Enemy& enemy = registry.enemies.get(entity);
 	enemy.health = componentsMap[ENEMIES]["health"];
 	enemy.damage = componentsMap[ENEMIES]["damage"];
-	enemy.type = componentsMap[ENEMIES]["type"];
+	enum_from_name(componentsMap[ENEMIES]["type"].get<std::string>(), enemy.type);
 	enemy.cooldown = componentsMap[ENEMIES]["cooldown"];
 	enemy.pathfindTime = componentsMap[ENEMIES]["pathfindTime"];
 }
@@ -1041,7 +1073,7 @@ void GameSaveManager::handleBarbarian(Entity& entity, std::map<std::string, nloh
 	Enemy& enemy = registry.enemies.get(entity);
 	enemy.health = componentsMap[ENEMIES]["health"];
 	enemy.damage = componentsMap[ENEMIES]["damage"];
-	enemy.type = componentsMap[ENEMIES]["type"];
+	enum_from_name(componentsMap[ENEMIES]["type"].get<std::string>(), enemy.type);
 	enemy.cooldown = componentsMap[ENEMIES]["cooldown"];
 	enemy.pathfindTime = componentsMap[ENEMIES]["pathfindTime"];
 }
@@ -1076,23 +1108,23 @@ void GameSaveManager::handleTroll(Entity& entity, std::map<std::string, nlohmann
 	troll.desiredAngle = componentsMap[TROLLS]["desiredAngle"];
 }
 
-void GameSaveManager::loadTrapsCounter(std::unordered_map<std::string, std::pair<int, Entity>>& trapCounterWorld) {
+void GameSaveManager::loadTrapsCounter(std::unordered_map<TRAP_TYPE, std::pair<int, Entity>>& trapCounterWorld) {
 	// assign entries from local traps counter to world traps counter
 	for (auto& entry : this->trapsCounter) {
 		trapCounterWorld[entry.first] = entry.second;
-		printf("Trap: %s, Count: %d\n", entry.first.c_str(), entry.second.first);	
+		printf("Trap: %s, Count: %d\n", enum_name(entry.first), entry.second.first);	
 	}
 }
 
-std::unordered_map<std::string, float> GameSaveManager::getSpawnDelays() {
+std::unordered_map<SPAWN_TYPE, float> GameSaveManager::getSpawnDelays() {
 	return this->spawnDelays;
 }
 
-std::unordered_map<std::string, int> GameSaveManager::getMaxEntities() {
+std::unordered_map<SPAWN_TYPE, int> GameSaveManager::getMaxEntities() {
 	return this->maxEntities;
 }
 
-std::unordered_map<std::string, float> GameSaveManager::getNextSpawns() {
+std::unordered_map<SPAWN_TYPE, float> GameSaveManager::getNextSpawns() {
 	return this->nextSpawns;
 }
 
@@ -5,38 +5,68 @@
 #include <render_system.hpp>
 #include "camera.hpp"
 
+// Components that are rebuilt rather than saved, every other container in ECS_CONTAINERS goes into the save file
+template <typename Component> struct TransientComponent : std::false_type {};
+template <> struct TransientComponent<PhantomTrap> : std::true_type {};
+template <> struct TransientComponent<Invulnerable> : std::true_type {};
+template <> struct TransientComponent<SlideUp> : std::true_type {};
+template <> struct TransientComponent<HomingProjectile> : std::true_type {};
+template <> struct TransientComponent<Bounceable> : std::true_type {};
+template <> struct TransientComponent<StaticBody> : std::true_type {};
+template <> struct TransientComponent<Explosion> : std::true_type {};
+template <> struct TransientComponent<PauseMenuComponent> : std::true_type {};
+template <> struct TransientComponent<HelpMenuComponent> : std::true_type {};
+template <> struct TransientComponent<TutorialComponent> : std::true_type {};
+template <> struct TransientComponent<EnemyTutorialComponents> : std::true_type {};
+template <> struct TransientComponent<CollectibleTutorialComponents> : std::true_type {};
+template <> struct TransientComponent<PointLight> : std::true_type {};
+template <> struct TransientComponent<Bomber> : std::true_type {};
+template <> struct TransientComponent<Bow> : std::true_type {};
+template <> struct TransientComponent<CollectibleBomb> : std::true_type {};
+template <> struct TransientComponent<Relationship> : std::true_type {};
+
 class GameSaveManager {
 public:
 	using json = nlohmann::json;
 
+	GameSaveManager(ECSRegistry& registry);
+
 	void init(RenderSystem* renderer, GLFWwindow* window, Camera* camera);
 
 	// Save the game
-	void save_game(std::unordered_map<std::string, std::pair<int, Entity>> trapCounter, std::unordered_map<std::string, float> spawn_delays, std::unordered_map<std::string, int> max_entities, std::unordered_map<std::string, float> next_spawns);
+	void save_game(std::unordered_map<TRAP_TYPE, std::pair<int, Entity>> trapCounter, std::unordered_map<SPAWN_TYPE, float> spawn_delays, std::unordered_map<SPAWN_TYPE, int> max_entities, std::unordered_map<SPAWN_TYPE, float> next_spawns);
 
 	// Load the game
 	bool load_game();
 	
 	// get spawn delays
-	std::unordered_map<std::string, float> getSpawnDelays();
+	std::unordered_map<SPAWN_TYPE, float> getSpawnDelays();
 	// get max entities
-	std::unordered_map<std::string, int> getMaxEntities();
+	std::unordered_map<SPAWN_TYPE, int> getMaxEntities();
 	// get next spawns
-	std::unordered_map<std::string, float> getNextSpawns();
+	std::unordered_map<SPAWN_TYPE, float> getNextSpawns();
   // load trap counter
-	void loadTrapsCounter(std::unordered_map<std::string, std::pair<int, Entity>>& trapCounterWorld);
+	void loadTrapsCounter(std::unordered_map<TRAP_TYPE, std::pair<int, Entity>>& trapCounterWorld);
 
 private:
 
+	ECSRegistry& registry;
 	RenderSystem* renderer;
 	GLFWwindow* window;
 	Camera* camera;
 
-	std::unordered_map<std::string, std::pair<int, Entity>> trapsCounter;
+	std::unordered_map<TRAP_TYPE, std::pair<int, Entity>> trapsCounter;
 
 	// CONSTANTS
+	// Layout of the save file, bump it whenever a saved component changes shape and teach upgrade_save the old one.
+	// Saves written before the field existed are version 1.
+	static const int SAVE_VERSION = 2;
+	std::string SAVEVERSION = "saveVersion";
+
 	// CONTAINERS
 	std::string MOTIONS = "motions";
+	std::string SHAPES = "shapes";
+	std::string PRESENTATIONS = "presentations";
 	std::string PLAYERS = "players";
 	std::string DASHERS = "dashers";
 	std::string ENEMIES = "enemies";
@@ -88,12 +118,23 @@ private:
 	std::string gameSaveFilePath = data_path() + "/save/game_save.json";
 	// Map to store group of components for each entity
 	std::map<int, std::map<std::string, json>> entityComponentGroups;
-	std::unordered_map<std::string, float> spawnDelays;
-	std::unordered_map<std::string, int> maxEntities;
-	std::unordered_map<std::string, float> nextSpawns;
+	std::unordered_map<SPAWN_TYPE, float> spawnDelays;
+	std::unordered_map<SPAWN_TYPE, int> maxEntities;
+	std::unordered_map<SPAWN_TYPE, float> nextSpawns;
 
 	// Serialization
-	void serialize_containers(json& j, std::unordered_map<std::string, std::pair<int, Entity>> trapsCounter, std::unordered_map<std::string, float> spawn_delays, std::unordered_map<std::string, int> max_entities, std::unordered_map<std::string, float> next_spawns);
+	void serialize_containers(json& j, std::unordered_map<TRAP_TYPE, std::pair<int, Entity>> trapsCounter, std::unordered_map<SPAWN_TYPE, float> spawn_delays, std::unordered_map<SPAWN_TYPE, int> max_entities, std::unordered_map<SPAWN_TYPE, float> next_spawns);
+
+	template <typename Component>
+	void save_container(json& j, const char* name, const ComponentContainer<Component>& container);
+	template <typename Component>
+	void save_container(json& j, const char* name, const ComponentContainer<Component>& container, std::true_type);
+	template <typename Component>
+	void save_container(json& j, const char* name, const ComponentContainer<Component>& container, std::false_type);
+	void save_container(json& j, const char* name, const ComponentContainer<Mesh*>& container);
+	// particles are not saved
+	template <typename... Components>
+	void save_container(json& j, const char* name, const Archetype<Components...>& container) {}
 
 	template <typename Component>
 	json serialize_container(const ComponentContainer<Component>& container);
@@ -102,16 +143,17 @@ private:
 	nlohmann::json serialize_game_timer(const GameTimer& gameTimer);
 	nlohmann::json serialize_game_score(const GameScore& gameScore);
 
-	nlohmann::json serialize_spawn_delays(std::unordered_map<std::string, float> spawn_delays);
-	nlohmann::json serialize_max_entities(std::unordered_map<std::string, int> max_entities);
-	nlohmann::json serialize_next_spawns(std::unordered_map<std::string, float> next_spawns);
-	nlohmann::json serialize_traps_counter(const std::unordered_map<std::string, std::pair<int, Entity>> trapCounter);
+	nlohmann::json serialize_spawn_delays(std::unordered_map<SPAWN_TYPE, float> spawn_delays);
+	nlohmann::json serialize_max_entities(std::unordered_map<SPAWN_TYPE, int> max_entities);
+	nlohmann::json serialize_next_spawns(std::unordered_map<SPAWN_TYPE, float> next_spawns);
+	nlohmann::json serialize_traps_counter(const std::unordered_map<TRAP_TYPE, std::pair<int, Entity>> trapCounter);
 
 
 	template <typename Component>
 	nlohmann::json serialize_component(const Component& component);
 
 	// Deserialization
+	void upgrade_save(json& j, int version);
 	void groupComponentsForEntities(const json& j);
 
 	void deserialize_containers(const json& j);
@@ -54,8 +54,8 @@ void GameStateController::beforeEnterState(GAME_STATE newState) {
         return;
     }
     if (newState == GAME_STATE::GAMEOVER) {
-        createGameOverText(world->camera->getSize());
-        registry.slideUps.clear();
+        createGameOverText(world->camera->getSize(), world->registry);
+        world->registry.slideUps.clear();
         return;
     }
     if (newState == GAME_STATE::HELP) {
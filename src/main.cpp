@@ -24,15 +24,15 @@ int main()
 	std::default_random_engine rng = std::default_random_engine(std::random_device()());
 
 	// Global Systems
-	WorldSystem world = WorldSystem(rng);
-	RenderSystem renderer;
-	PhysicsSystem physics;
-	ParticleSystem particles;
-	SoundSystem sound;
-	AISystem ai = AISystem(rng, &sound);
+	WorldSystem world = WorldSystem(registry, rng);
+	RenderSystem renderer(registry);
+	PhysicsSystem physics(registry);
+	ParticleSystem particles(registry);
+	SoundSystem sound(registry);
+	AISystem ai = AISystem(registry, rng, &sound);
 	Camera camera;
-	GameSaveManager saveManager;
-	SpawnManager spawnManager;
+	GameSaveManager saveManager(registry);
+	SpawnManager spawnManager(registry);
 
 	// Initializing window
 	GLFWwindow* window = renderer.create_window();
@@ -74,15 +74,18 @@ int main()
 			physics.step(elapsed_ms);
 			particles.step(elapsed_ms);
 			world.step(elapsed_ms);
+			// sync point, apply the structural changes recorded by the systems so far
+			registry.flush_deferred();
             world.handle_collisions();
 			ai.step(elapsed_ms);
 			renderer.step(elapsed_ms);
 			sound.step(elapsed_ms);
 			spawnManager.step(elapsed_ms);
+			registry.flush_deferred();
 		}
 
 		renderer.draw();
-		
+		registry.advance_frame();
 	}
 	return 0;
 }
@@ -3,7 +3,7 @@
 #include "world_system.hpp"
 
 Entity WorldSystem::createHelpMenu(vec2 windowSize) {
-	auto entity = Entity();
+	auto entity = Entity::create();
 
 	registry.pauseMenuComponents.emplace(entity);
 
@@ -29,7 +29,7 @@ void WorldSystem::exitHelpMenu() {
 }
 
 Entity WorldSystem::createPauseMenu(vec2 windowSize) {
-	auto entity = Entity();
+	auto entity = Entity::create();
 
 	registry.pauseMenuComponents.emplace(entity);
 
@@ -57,7 +57,7 @@ void WorldSystem::exitPauseMenu() {
 
 //Tutorial at the start
 Entity WorldSystem::createTutorial(vec2 windowSize) {
-    auto entity = Entity();
+    auto entity = Entity::create();
     registry.tutorialComponents.emplace(entity);
 
     Foreground& fg = registry.foregrounds.emplace(entity);
@@ -81,7 +81,7 @@ void WorldSystem::exitTutorial() {
 }
 
 Entity WorldSystem::createBoarTutorial(vec2 windowSize) {
-    auto entity = Entity();
+    auto entity = Entity::create();
     registry.enemyTutorialComponents.emplace(entity);
 
     Foreground& fg = registry.foregrounds.emplace(entity);
@@ -98,7 +98,7 @@ Entity WorldSystem::createBoarTutorial(vec2 windowSize) {
     return entity;
 }
 Entity WorldSystem::createBirdTutorial(vec2 windowSize) {
-    auto entity = Entity();
+    auto entity = Entity::create();
     registry.enemyTutorialComponents.emplace(entity);
 
     Foreground& fg = registry.foregrounds.emplace(entity);
@@ -115,7 +115,7 @@ Entity WorldSystem::createBirdTutorial(vec2 windowSize) {
     return entity;
 }
 Entity WorldSystem::createWizardTutorial(vec2 windowSize) {
-    auto entity = Entity();
+    auto entity = Entity::create();
     registry.enemyTutorialComponents.emplace(entity);
 
     Foreground& fg = registry.foregrounds.emplace(entity);
@@ -132,7 +132,7 @@ Entity WorldSystem::createWizardTutorial(vec2 windowSize) {
     return entity;
 }
 Entity WorldSystem::createTrollTutorial(vec2 windowSize) {
-    auto entity = Entity();
+    auto entity = Entity::create();
     registry.enemyTutorialComponents.emplace(entity);
 
     Foreground& fg = registry.foregrounds.emplace(entity);
@@ -149,7 +149,7 @@ Entity WorldSystem::createTrollTutorial(vec2 windowSize) {
     return entity;
 }
 Entity WorldSystem::createArcherTutorial(vec2 windowSize) {
-    auto entity = Entity();
+    auto entity = Entity::create();
     registry.enemyTutorialComponents.emplace(entity);
 
     Foreground& fg = registry.foregrounds.emplace(entity);
@@ -166,7 +166,7 @@ Entity WorldSystem::createArcherTutorial(vec2 windowSize) {
     return entity;
 }
 Entity WorldSystem::createBarbarianTutorial(vec2 windowSize) {
-    auto entity = Entity();
+    auto entity = Entity::create();
     registry.enemyTutorialComponents.emplace(entity);
 
     Foreground& fg = registry.foregrounds.emplace(entity);
@@ -184,7 +184,7 @@ Entity WorldSystem::createBarbarianTutorial(vec2 windowSize) {
 }
 
 Entity WorldSystem::createBomberTutorial(vec2 windowSize) {
-    auto entity = Entity();
+    auto entity = Entity::create();
     registry.enemyTutorialComponents.emplace(entity);
 
     Foreground& fg = registry.foregrounds.emplace(entity);
@@ -208,7 +208,7 @@ void WorldSystem::exitEnemyTutorial() {
 }
 
 Entity WorldSystem::createHeartTutorial(vec2 windowSize) {
-    auto entity = Entity();
+    auto entity = Entity::create();
     registry.collectibleTutorialComponents.emplace(entity);
 
     Foreground& fg = registry.foregrounds.emplace(entity);
@@ -226,7 +226,7 @@ Entity WorldSystem::createHeartTutorial(vec2 windowSize) {
 }
 
 Entity WorldSystem::createTrapTutorial(vec2 windowSize) {
-    auto entity = Entity();
+    auto entity = Entity::create();
     registry.collectibleTutorialComponents.emplace(entity);
 
     Foreground& fg = registry.foregrounds.emplace(entity);
@@ -244,7 +244,7 @@ Entity WorldSystem::createTrapTutorial(vec2 windowSize) {
 }
 
 Entity WorldSystem::createPhantomTrapTutorial(vec2 windowSize) {
-    auto entity = Entity();
+    auto entity = Entity::create();
     registry.collectibleTutorialComponents.emplace(entity);
 
     Foreground& fg = registry.foregrounds.emplace(entity);
@@ -262,7 +262,7 @@ Entity WorldSystem::createPhantomTrapTutorial(vec2 windowSize) {
 }
 
 Entity WorldSystem::createBowTutorial(vec2 windowSize) {
-    auto entity = Entity();
+    auto entity = Entity::create();
     registry.collectibleTutorialComponents.emplace(entity);
 
     Foreground& fg = registry.foregrounds.emplace(entity);
@@ -280,7 +280,7 @@ Entity WorldSystem::createBowTutorial(vec2 windowSize) {
 }
 
 Entity WorldSystem::createBombTutorial(vec2 windowSize) {
-    auto entity = Entity();
+    auto entity = Entity::create();
     registry.collectibleTutorialComponents.emplace(entity);
 
     Foreground& fg = registry.foregrounds.emplace(entity);
@@ -307,14 +307,14 @@ void WorldSystem::createTitleScreen() {
 	registry.clear_all_components();
 
 	vec2 windowSize = camera->getSize();
-	createTitleScreenBackground(windowSize);
-	// createTitleScreenText(windowSize, "Watch Out!", 5.f, vec2(windowSize.x / 2 - 400.f, windowSize.y / 2 + 100));
-	createTitleScreenTitle(windowSize);
-	createTitleScreenText(windowSize, "Press Enter to Begin", 1.f, vec2(windowSize.x / 2 - 155.f, windowSize.y / 2 - 200));
-	/*createTitleScreenText(windowSize, "Press L to Load Progress", 1.f, vec2(windowSize.x / 2 - 185.f, windowSize.y / 2 - 200));*/
-	createTitleScreenText(windowSize, "Press Q to Quit", 1.f, vec2(windowSize.x / 2 - 115.f, windowSize.y / 2 - 300));
+	createTitleScreenBackground(windowSize, registry);
+	// createTitleScreenText(windowSize, "Watch Out!", 5.f, vec2(windowSize.x / 2 - 400.f, windowSize.y / 2 + 100), registry);
+	createTitleScreenTitle(windowSize, registry);
+	createTitleScreenText(windowSize, "Press Enter to Begin", 1.f, vec2(windowSize.x / 2 - 155.f, windowSize.y / 2 - 200), registry);
+	/*createTitleScreenText(windowSize, "Press L to Load Progress", 1.f, vec2(windowSize.x / 2 - 185.f, windowSize.y / 2 - 200), registry);*/
+	createTitleScreenText(windowSize, "Press Q to Quit", 1.f, vec2(windowSize.x / 2 - 115.f, windowSize.y / 2 - 300), registry);
 	std::string teamText = "Team 17 Electric Boogaloo: Carlo, Katie, Linus, Tarun & Yan Naing";
-	createTitleScreenText(windowSize, teamText, 1.f, vec2(windowSize.x - 950.f, windowSize.y - 50));
+	createTitleScreenText(windowSize, teamText, 1.f, vec2(windowSize.x - 950.f, windowSize.y - 50), registry);
 	camera->followPosition({ world_size_x / 2.f, world_size_y / 2.f });
 
 	soundSetUp();
@@ -325,10 +325,10 @@ void WorldSystem::createTitleScreenTutorial() {
     registry.clear_all_components();
 
     vec2 windowSize = camera->getSize();
-    createTitleScreenBackground(windowSize);
-    createTitleScreenText(windowSize, "Do you need a tutorial?", 1.f, vec2(windowSize.x / 2 - 155.f, windowSize.y / 2 + 200));
-    createTitleScreenText(windowSize, "Yes (Y)", 1.f, vec2(windowSize.x / 2 - 25.f, windowSize.y / 2 - 100));
-    createTitleScreenText(windowSize, "No (N)", 1.f, vec2(windowSize.x / 2 - 20.f, windowSize.y / 2 - 200));
+    createTitleScreenBackground(windowSize, registry);
+    createTitleScreenText(windowSize, "Do you need a tutorial?", 1.f, vec2(windowSize.x / 2 - 155.f, windowSize.y / 2 + 200), registry);
+    createTitleScreenText(windowSize, "Yes (Y)", 1.f, vec2(windowSize.x / 2 - 25.f, windowSize.y / 2 - 100), registry);
+    createTitleScreenText(windowSize, "No (N)", 1.f, vec2(windowSize.x / 2 - 20.f, windowSize.y / 2 - 200), registry);
     camera->followPosition({ world_size_x / 2.f, world_size_y / 2.f });
 
     gameStateController.setGameState(GAME_STATE::TITLE_TUTORIAL);
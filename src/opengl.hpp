@@ -0,0 +1,6 @@
+#pragma once
+
+// glfw (OpenGL)
+#define NOMINMAX
+#include <gl3w.h>
+#include <GLFW/glfw3.h>
@@ -3,6 +3,10 @@
 #include "physics_system.hpp"
 #include "world_init.hpp"
 
+ParticleSystem::ParticleSystem(ECSRegistry& registry) : registry(registry)
+{
+}
+
 ParticleSystem::~ParticleSystem()
 {
     for (auto& it : vbos) {
@@ -21,16 +25,17 @@ void ParticleSystem::init(RenderSystem* renderer)
 
 void ParticleSystem::step(float elapsed_ms)
 {
-    for (size_t i = 0; i < registry.particles.size(); i++) {
-        Entity entity = registry.particles.entities[i];
-        Particle& particle = registry.particles.components[i];
-        particle.position += particle.velocity * elapsed_ms;
-        particle.velocity.z -= GRAVITATIONAL_CONSTANT * particle.gravity;
-        particle.life -= elapsed_ms;
-        if (particle.life < 0) {
-            registry.remove_all_components_of(entity);
+    registry.particles.each_chunk([&](size_t count, Entity* entities, ParticleMotion* motions, Particle*) {
+        for (size_t i = 0; i < count; i++) {
+            ParticleMotion& motion = motions[i];
+            motion.position += motion.velocity * elapsed_ms;
+            motion.velocity.z -= GRAVITATIONAL_CONSTANT * motion.gravity;
+            motion.life -= elapsed_ms;
+            if (motion.life < 0) {
+                registry.defer_destroy(entities[i]);
+            }
         }
-    }
+    });
 }
 
 void ParticleSystem::draw(const GLuint program)
@@ -40,13 +45,15 @@ void ParticleSystem::draw(const GLuint program)
     size_t amount = registry.particles.size();
     transforms[PARTICLE::SMOKE].reserve(amount);
     transforms[PARTICLE::DASH].reserve(amount);
-    for (Particle& particle : registry.particles.components) {
-        Transform transform;
-        transform.translate(worldToVisual(particle.position));
-        transform.rotate(particle.angle);
-        transform.scale(particle.scale);
-        transforms[particle.type].push_back(transform.mat);
-    }
+    registry.particles.each_chunk([&](size_t count, Entity*, ParticleMotion* motions, Particle* particles) {
+        for (size_t i = 0; i < count; i++) {
+            Transform transform;
+            transform.translate(worldToVisual(motions[i].position));
+            transform.rotate(particles[i].angle);
+            transform.scale(particles[i].scale);
+            transforms[particles[i].type].push_back(transform.mat);
+        }
+    });
 
     drawDash(program, projection);
     drawSmoke(program, projection);
@@ -114,30 +121,38 @@ void ParticleSystem::drawDash(const GLuint program, mat3& projection)
 
 Entity ParticleSystem::createSmokeParticle(vec3 position, vec2 size)
 {
-    Entity entity = Entity();
+    Entity entity = Entity::create();
+
+    ParticleMotion motion;
+    motion.position = position;
+    motion.velocity = vec3((uniform_dist(rng) - 0.5) / 10, (uniform_dist(rng) - 0.5) / 10, 0.1);
+    motion.gravity = 0;
+    motion.life = 1000;
 
-    Particle& particle = registry.particles.emplace(entity);
-    particle.position = position;
-    particle.velocity = vec3((uniform_dist(rng) - 0.5) / 10, (uniform_dist(rng) - 0.5) / 10, 0.1);
+    Particle particle;
     particle.scale = size;
-    particle.gravity = 0;
-    particle.life = 1000;
     particle.type = PARTICLE::SMOKE;
 
+    registry.particles.insert(entity, motion, particle);
+
     return entity;
 }
 
 Entity ParticleSystem::createDashParticle(vec3 position, vec2 size)
 {
-    Entity entity = Entity();
+    Entity entity = Entity::create();
 
-    Particle& particle = registry.particles.emplace(entity);
-    particle.position = position;
-    particle.velocity = vec3(0);
+    ParticleMotion motion;
+    motion.position = position;
+    motion.velocity = vec3(0);
+    motion.gravity = 0;
+    motion.life = 100;
+
+    Particle particle;
     particle.scale = size;
-    particle.gravity = 0;
-    particle.life = 100;
     particle.type = PARTICLE::DASH;
 
+    registry.particles.insert(entity, motion, particle);
+
     return entity;
 }
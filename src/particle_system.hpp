@@ -1,5 +1,6 @@
 #pragma once
 
+#include "opengl.hpp"
 #include "tiny_ecs_registry.hpp"
 #include <random>
 
@@ -7,6 +8,7 @@ class RenderSystem;
 
 class ParticleSystem {
 public:
+	ParticleSystem(ECSRegistry& registry);
 	~ParticleSystem();
 	void init(RenderSystem* renderer);
 	void draw(const GLuint program);
@@ -17,6 +19,7 @@ public:
 	Entity createDashParticle(vec3 position, vec2 size);
 
 private:
+	ECSRegistry& registry;
 	RenderSystem* renderer;
 	std::unordered_map<PARTICLE, GLuint> vbos;
 	std::unordered_map<PARTICLE, std::vector<mat3>> transforms;
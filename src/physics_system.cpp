@@ -4,31 +4,62 @@
 #include <iostream>
 #include <glm/gtx/string_cast.hpp>
 
-static std::vector<vec2> getPolygonOfBoundingBox(const Motion& motion)
+static OrientedBox getBoxOfBoundingBox(const Motion& motion, const Shape& shape, float angle)
 {
 	vec2 pos = { motion.position.x, motion.position.z };
-	std::vector<vec2> polygon{
-		pos + rotate(vec2(+motion.hitbox.x, +motion.hitbox.z) / 2.f, motion.angle),
-		pos + rotate(vec2(-motion.hitbox.x, +motion.hitbox.z) / 2.f, motion.angle),
-		pos + rotate(vec2(-motion.hitbox.x, -motion.hitbox.z) / 2.f, motion.angle),
-		pos + rotate(vec2(+motion.hitbox.x, -motion.hitbox.z) / 2.f, motion.angle)
-	};
-	return polygon;
+	OrientedBox box{ {
+		pos + rotate(vec2(+shape.hitbox.x, +shape.hitbox.z) / 2.f, angle),
+		pos + rotate(vec2(-shape.hitbox.x, +shape.hitbox.z) / 2.f, angle),
+		pos + rotate(vec2(-shape.hitbox.x, -shape.hitbox.z) / 2.f, angle),
+		pos + rotate(vec2(+shape.hitbox.x, -shape.hitbox.z) / 2.f, angle)
+	} };
+	return box;
 }
 
-static bool collides(const Motion& motionA, const Motion& motionB, const std::vector<vec2>& polygonA, const std::vector<vec2>& polygonB)
+// Collision filter: the pairs of layers that are tested against each other, in either order. Pairs of layers not
+// listed here (every pair with NONE or MAP_TILE among them) are dropped in the broadphase, before any narrowphase.
+static const COLLISION_LAYER COLLIDING_LAYERS[][2] = {
+	{ COLLISION_LAYER::PLAYER,     COLLISION_LAYER::ENEMY },       // melee damage, recoil
+	{ COLLISION_LAYER::PLAYER,     COLLISION_LAYER::PROJECTILE },  // arrows, recoil off landed projectiles
+	{ COLLISION_LAYER::PLAYER,     COLLISION_LAYER::DAMAGING },
+	{ COLLISION_LAYER::PLAYER,     COLLISION_LAYER::OBSTACLE },
+	{ COLLISION_LAYER::PLAYER,     COLLISION_LAYER::COLLECTIBLE },
+	{ COLLISION_LAYER::PLAYER,     COLLISION_LAYER::TRAP },
+	{ COLLISION_LAYER::ENEMY,      COLLISION_LAYER::ENEMY },
+	{ COLLISION_LAYER::ENEMY,      COLLISION_LAYER::PROJECTILE },
+	{ COLLISION_LAYER::ENEMY,      COLLISION_LAYER::DAMAGING },
+	{ COLLISION_LAYER::ENEMY,      COLLISION_LAYER::OBSTACLE },    // charging boars stun themselves
+	{ COLLISION_LAYER::ENEMY,      COLLISION_LAYER::TRAP },
+	{ COLLISION_LAYER::PROJECTILE, COLLISION_LAYER::PROJECTILE },
+	{ COLLISION_LAYER::PROJECTILE, COLLISION_LAYER::OBSTACLE },    // stops them
+	{ COLLISION_LAYER::DAMAGING,   COLLISION_LAYER::OBSTACLE },    // fireballs burn out
+	{ COLLISION_LAYER::OBSTACLE,   COLLISION_LAYER::COLLECTIBLE }, // tree meshes push collectibles out
+};
+
+// Box on the ground plane with the same extents as the early outs of collides(), so the broadphase never drops a
+// pair collides() would accept
+static void broadphaseBox(const Motion& motion, const Shape& shape, vec2& min, vec2& max)
+{
+	vec2 halfExtent = { glm::max(shape.hitbox.x, shape.hitbox.z) / 2.f, shape.hitbox.y / 2.f };
+	vec2 center = { motion.position.x, motion.position.y };
+	min = center - halfExtent;
+	max = center + halfExtent;
+}
+
+// 'boxesOverlap' is the separating axis test of the two bounding boxes, done for all pairs ahead of the pair loop
+static bool collides(const Motion& motionA, const Shape& shapeA, const Motion& motionB, const Shape& shapeB, bool boxesOverlap)
 {
 	// Check if there's overlap along the Y axis
-	if (motionA.position.y > motionB.position.y + ((motionB.hitbox.y + motionA.hitbox.y) / 2.0f)) {
+	if (motionA.position.y > motionB.position.y + ((shapeB.hitbox.y + shapeA.hitbox.y) / 2.0f)) {
 		return false;
 	}
-	if (motionA.position.y + ((motionA.hitbox.y + motionB.hitbox.y) / 2.0f) < motionB.position.y) {
+	if (motionA.position.y + ((shapeA.hitbox.y + shapeB.hitbox.y) / 2.0f) < motionB.position.y) {
 		return false;
 	}
 
 	// Check if there's overlap of the maximum possible extent along the XZ plane
-	float maxA = max(motionA.hitbox.x, motionA.hitbox.z);
-	float maxB = max(motionB.hitbox.x, motionB.hitbox.z);
+	float maxA = max(shapeA.hitbox.x, shapeA.hitbox.z);
+	float maxB = max(shapeB.hitbox.x, shapeB.hitbox.z);
 	if (motionA.position.x > motionB.position.x + ((maxA + maxB) / 2.0f)) {
 		return false;
 	}
@@ -43,22 +74,13 @@ static bool collides(const Motion& motionA, const Motion& motionB, const std::ve
 	}
 
 	// Check if the polygons collide
-	return polygonsCollide(polygonA, polygonB);
+	return boxesOverlap;
 }
 
 void PhysicsSystem::handleBoundsCheck() {
-	ComponentContainer<Motion>& motion_container = registry.motions;
-
-	for (uint i = 0; i < motion_container.components.size(); i++) {
-		if (registry.birds.has(motion_container.entities[i]) || 
-			registry.mapTiles.has(motion_container.entities[i]) ||
-			registry.explosions.has(motion_container.entities[i])) {
-			continue;
-		}
-
-		Motion& motion = motion_container.components[i];
-		float halfScaleX = abs(motion.scale.x) / 2;
-		float halfScaleY = abs(motion.scale.y) / 2;
+	registry.view<Motion, Presentation>(Exclude<Bird, MapTile, Explosion>()).each([](Entity, Motion& motion, Presentation& presentation) {
+		float halfScaleX = abs(presentation.scale.x) / 2;
+		float halfScaleY = abs(presentation.scale.y) / 2;
 
 		// Check left and right bounds
 		if (motion.position.x - halfScaleX < leftBound) {
@@ -75,68 +97,129 @@ void PhysicsSystem::handleBoundsCheck() {
 		else if (motion.position.y + halfScaleY > bottomBound) {
 			motion.position.y = bottomBound - halfScaleY;
 		}
+	});
+}
+
+void PhysicsSystem::rebuildStaticBodies()
+{
+	staticItems.clear();
+	for (Entity entity : registry.staticBodies.entities) {
+		if (!registry.motions.has(entity) || !collidesWithAnything(registry.shapes.get(entity).layer))
+			continue;
+		StaticBVH::Item item;
+		broadphaseBox(registry.motions.get(entity), registry.shapes.get(entity), item.min, item.max);
+		item.id = entity.index();
+		staticItems.push_back(item);
 	}
+	staticBodies.build(staticItems);
+	staticBodiesChanged = false;
 }
 
 void PhysicsSystem::checkCollisions()
 {
 	// Check for collisions between moving entities
 	ComponentContainer<Motion>& motions = registry.motions;
+	if (staticBodiesChanged)
+		rebuildStaticBodies();
 
-	std::vector<std::vector<vec2>> boundingBoxPolygons;
-	boundingBoxPolygons.reserve(motions.size());
-	for (Entity entity : motions.entities) {
-		Motion& motion = motions.get(entity);
-		boundingBoxPolygons.push_back(getPolygonOfBoundingBox(motion));
-	}
+	// Shapes are looked up once per entity so the pair loop only reads the two dense arrays
+	std::vector<const Shape*> shapes;
+	shapes.reserve(motions.size());
+	boundingBoxes.resize(motions.size());
+	for (uint i = 0; i < motions.components.size(); i++) {
+		Entity entity = motions.entities[i];
+		const Motion& motion = motions.components[i];
+		const Shape& shape = registry.shapes.get(entity);
+		shapes.push_back(&shape);
+		// layers that collide with nothing stay out of the broadphase altogether
+		if (!collidesWithAnything(shape.layer))
+			continue;
+		boundingBoxes[i] = getBoxOfBoundingBox(motion, shape, registry.presentations.get(entity).angle);
 
+		if (registry.staticBodies.has(entity)) {
+			if (entity.index() >= staticSlots.size())
+				staticSlots.resize(entity.index() + 1);
+			staticSlots[entity.index()] = i;
+			continue;
+		}
+		vec2 boxMin, boxMax;
+		broadphaseBox(motion, shape, boxMin, boxMax);
+		broadphase.update(entity, i, boxMin, boxMax);
+	}
+	broadphase.sweep();
+
+	candidatePairs.clear();
+	broadphase.for_each_pair([this, &shapes](uint32_t a, uint32_t b) {
+		if (layersCollide(shapes[a]->layer, shapes[b]->layer))
+			candidatePairs.push_back(a < b ? std::make_pair(a, b) : std::make_pair(b, a));
+	});
+	// Moving bodies against the static ones, pairs of two static bodies are never generated
 	for (uint i = 0; i < motions.components.size(); i++) {
+		if (registry.staticBodies.has(motions.entities[i]) || !collidesWithAnything(shapes[i]->layer))
+			continue;
+		vec2 boxMin, boxMax;
+		broadphaseBox(motions.components[i], *shapes[i], boxMin, boxMax);
+		staticBodies.query(boxMin, boxMax, [this, i, &motions, &shapes](uint32_t index) {
+			uint slot = staticSlots[index];
+			if (slot < motions.size() && motions.entities[slot].index() == index && layersCollide(shapes[i]->layer, shapes[slot]->layer))
+				candidatePairs.push_back(i < slot ? std::make_pair(i, slot) : std::make_pair(slot, i));
+		});
+	}
+	// Pairs in the order of the full double loop the broadphase replaces, so collision handling stays deterministic
+	std::sort(candidatePairs.begin(), candidatePairs.end());
+
+	// Every pair is tested on the boxes taken at the start of the step, like the polygons of the old double loop.
+	// Destroys are deferred until after the loop, so the motion indices of the pairs stay valid throughout.
+	candidateOverlaps.resize(candidatePairs.size());
+	orientedBoxesCollide(boundingBoxes.data(), candidatePairs.data(), candidatePairs.size(), candidateOverlaps.data());
+	destroyedSlots.assign(motions.size(), 0);
+
+	for (size_t k = 0; k < candidatePairs.size(); k++) {
+		uint i = candidatePairs[k].first;
+		uint j = candidatePairs[k].second;
+		// an entity a collision destroyed takes no part in the rest of this frame's pairs
+		if (destroyedSlots[i] || destroyedSlots[j])
+			continue;
 		Entity entity_i = motions.entities[i];
 		Motion& motion_i = motions.components[i];
-
-		for (uint j = i + 1; j < motions.components.size(); j++) {
-			Entity entity_j = motions.entities[j];
-			Motion& motion_j = motions.components[j];
-
-			// skip obstacle to obstacle collision
-			if (registry.obstacles.has(entity_i) && registry.obstacles.has(entity_j)) continue;
-
-			if (collides(motion_i, motion_j, boundingBoxPolygons.at(i), boundingBoxPolygons.at(j))) {
-				if (registry.meshPtrs.has(entity_i)) {
-					if (meshCollides(entity_i, entity_j)) {
-						handle_mesh_collision(entity_i, entity_j);
-						collisions.push_back(std::make_pair(entity_i, entity_j));
-						collisions.push_back(std::make_pair(entity_j, entity_i));
-					}
-				}
-				else if (registry.meshPtrs.has(entity_j)) {
-					if (meshCollides(entity_j, entity_i)) {
-						handle_mesh_collision(entity_j, entity_i);
-						collisions.push_back(std::make_pair(entity_i, entity_j));
-						collisions.push_back(std::make_pair(entity_j, entity_i));
-					}
+		const Shape& shape_i = *shapes[i];
+		Entity entity_j = motions.entities[j];
+		Motion& motion_j = motions.components[j];
+		const Shape& shape_j = *shapes[j];
+
+		if (collides(motion_i, shape_i, motion_j, shape_j, candidateOverlaps[k])) {
+			if (registry.meshPtrs.has(entity_i)) {
+				if (meshCollides(entity_i, entity_j)) {
+					destroyedSlots[j] = handle_mesh_collision(entity_i, entity_j);
+					collisions.push_back(std::make_pair(entity_i, entity_j));
 				}
-				else {
-					// Collision detected
+			}
+			else if (registry.meshPtrs.has(entity_j)) {
+				if (meshCollides(entity_j, entity_i)) {
+					destroyedSlots[i] = handle_mesh_collision(entity_j, entity_i);
 					collisions.push_back(std::make_pair(entity_i, entity_j));
-					collisions.push_back(std::make_pair(entity_j, entity_i));
-
-					// Push each other
-					if (motions.components[i].solid && motions.components[j].solid) {
-						if (registry.obstacles.has(entity_i)) { //obstacle collision
-							handle_obstacle_collision(entity_i, entity_j);
-						}
-						else if (registry.obstacles.has(entity_j)) {
-							handle_obstacle_collision(entity_j, entity_i);
-						}
-						else {
-							recoil_entities(entity_i, entity_j);
-						}
+				}
+			}
+			else {
+				// Collision detected
+				collisions.push_back(std::make_pair(entity_i, entity_j));
+
+				// Push each other
+				if (shape_i.solid && shape_j.solid) {
+					if (registry.obstacles.has(entity_i)) { //obstacle collision
+						handle_obstacle_collision(entity_i, entity_j);
+					}
+					else if (registry.obstacles.has(entity_j)) {
+						handle_obstacle_collision(entity_j, entity_i);
+					}
+					else {
+						recoil_entities(entity_i, entity_j);
 					}
 				}
 			}
 		}
 	}
+	registry.flush_deferred();
 }
 
 static vec3 tranformVertex(vec3 vertex, vec3 translation, float rotation, vec3 scaling)
@@ -155,50 +238,18 @@ static vec3 tranformVertex(vec3 vertex, vec3 translation, float rotation, vec3 s
 	return rotatedVertex;
 }
 
-bool polygonsCollide(const std::vector<vec2>& polygon1, const std::vector<vec2>& polygon2) {
-	// Check if two polygons are intersecting
-	for (int i = 0; i < 2; i++) {
-		std::vector<vec2> polygon = i == 0 ? polygon1 : polygon2;
-		for (int i1 = 0; i1 < polygon.size(); i1++) {
-			int i2 = (i1 + 1) % polygon.size();
-			vec2 p1 = polygon[i1];
-			vec2 p2 = polygon[i2];
-
-			vec2 normal = { p2.y - p1.y, p1.x - p2.x };
-
-			float minA = normal.x * polygon1[0].x + normal.y * polygon1[0].y;
-			float maxA = minA;
-			for (int j = 0; j < polygon1.size(); j++) {
-				float projected = normal.x * polygon1[j].x + normal.y * polygon1[j].y;
-				if (projected < minA) minA = projected;
-				if (projected > maxA) maxA = projected;
-			}
-
-			float minB = normal.x * polygon2[0].x + normal.y * polygon2[0].y;
-			float maxB = minB;
-			for (int j = 0; j < polygon2.size(); j++) {
-				float projected = normal.x * polygon2[j].x + normal.y * polygon2[j].y;
-				if (projected < minB) minB = projected;
-				if (projected > maxB) maxB = projected;
-			}
-
-			if (maxA < minB || maxB < minA) {
-				return false;
-			}
-		}
-	}
-	return true;
-}
-
 bool PhysicsSystem::meshCollides(Entity& mesh_entity, Entity& other_entity) {
 	Mesh& mesh = *(registry.meshPtrs.get(mesh_entity));
 	Motion& mesh_motion = registry.motions.get(mesh_entity);
+	Presentation& mesh_presentation = registry.presentations.get(mesh_entity);
 	Motion& other_motion = registry.motions.get(other_entity);
+	Shape& other_shape = registry.shapes.get(other_entity);
+	Presentation& other_presentation = registry.presentations.get(other_entity);
 	// Polygon vertices
-	std::vector<vec2> otherPolygon;
-	float halfWidth = other_motion.hitbox.x / 2;
-	float halfDepth = other_motion.hitbox.y / 2;
-	float halfHeight = other_motion.hitbox.z / 2;
+	ConvexPolygon otherPolygon;
+	float halfWidth = other_shape.hitbox.x / 2;
+	float halfDepth = other_shape.hitbox.y / 2;
+	float halfHeight = other_shape.hitbox.z / 2;
 	vec2 horizontalDirection = normalize(vec2(mesh_motion.position) - vec2(other_motion.position));
 
 	// Initialize with big numbers that will always be overwritten
@@ -211,7 +262,7 @@ bool PhysicsSystem::meshCollides(Entity& mesh_entity, Entity& other_entity) {
 			for (auto k : { -1, 1 }) {
 				// Get vertex in world space
 				vec3 vertex = vec3(halfWidth * i, halfDepth * j, halfHeight * k);
-				vertex = tranformVertex(vertex, other_motion.position, other_motion.angle, vec3(1));
+				vertex = tranformVertex(vertex, other_motion.position, other_presentation.angle, vec3(1));
 
 				// Get vertex along collision axis relative to the mesh
 				vec2 horizontalVector = vec2(vertex) - vec2(mesh_motion.position);
@@ -239,16 +290,16 @@ bool PhysicsSystem::meshCollides(Entity& mesh_entity, Entity& other_entity) {
 
 	std::vector<uint16_t>& faces = mesh.vertex_indices;
 	for (int i = 0; i < faces.size(); i += 3) {
-		std::vector<vec2> meshPolygon;
+		ConvexPolygon meshPolygon;
 
 		vec3 collisionVertex;
 		// Get the vertices of the face
 		for (int j = 0; j < 3; j++) {
 			vec2 v = mesh.vertices[faces[i + j]].position;
 			vec3 vertex = { v.x, 0, -v.y };
-			vec3 scaling = { mesh_motion.scale.x, 0, mesh_motion.scale.y / zConversionFactor };
+			vec3 scaling = { mesh_presentation.scale.x, 0, mesh_presentation.scale.y / zConversionFactor };
 			vec3 translation = vec3(0);
-			vertex = tranformVertex(vertex, translation, mesh_motion.angle, scaling);
+			vertex = tranformVertex(vertex, translation, mesh_presentation.angle, scaling);
 			meshPolygon.push_back({ vertex.x, vertex.z });
 		}
 
@@ -262,27 +313,22 @@ bool PhysicsSystem::meshCollides(Entity& mesh_entity, Entity& other_entity) {
 
 void PhysicsSystem::updatePositions(float elapsed_ms)
 {
-	for (Entity entity : registry.motions.entities) {
-		if(registry.explosions.has(entity)) {
-			// don't need to update explosion position
-			continue;
-		}
-
-		Motion& motion = registry.motions.get(entity);
-
+	// explosions don't need their position updated
+	registry.view<Motion, Shape>(Exclude<Explosion>()).each([this, elapsed_ms](Entity entity, Motion& motion, Shape& shape) {
 		// Z-position of entity when it is on the ground
-		float groundZ = getElevation(vec2(motion.position)) + motion.hitbox.z / 2;
+		float groundZ = getElevation(vec2(motion.position)) + shape.hitbox.z / 2;
 
 		// Set player velocity
 		if (registry.players.has(entity) && motion.position.z <= groundZ) {
 			Player& player_comp = registry.players.get(entity);
+			Presentation& presentation = registry.presentations.get(entity);
 
 			float player_speed = motion.speed;
 			if (!player_comp.isMoving) player_speed = 0;
 			else if (player_comp.isRunning) player_speed *= 2;
 
-			motion.velocity.x = (player_speed * motion.facing).x;
-			motion.velocity.y = (player_speed * motion.facing).y;
+			motion.velocity.x = (player_speed * presentation.facing).x;
+			motion.velocity.y = (player_speed * presentation.facing).y;
 		}
 
 		// Update the entity's position based on its velocity and elapsed time
@@ -293,9 +339,9 @@ void PhysicsSystem::updatePositions(float elapsed_ms)
 		// Apply gravity if above the ground
 		if (motion.position.z > groundZ) {
 			// Don't apply gravity to fireballs
-			if (registry.damagings.has(entity) && registry.damagings.get(entity).type == "fireball")
+			if (registry.damagings.has(entity) && registry.damagings.get(entity).type == DAMAGING_TYPE::FIREBALL)
 			{ 
-				continue;
+				return;
 			}
 			motion.velocity.z -= motion.gravity * GRAVITATIONAL_CONSTANT * elapsed_ms;
 		}
@@ -332,7 +378,7 @@ void PhysicsSystem::updatePositions(float elapsed_ms)
     		motion.velocity.z = -motion.velocity.z * BOUNCE_FACTOR;
 	
 				registry.bounceables.get(entity).numBounces -= 1;
-				continue;
+				return;
       }
 
 			motion.position.z = groundZ;
@@ -382,15 +428,17 @@ void PhysicsSystem::updatePositions(float elapsed_ms)
 				}
 			}
 		}
-	}
+	});
 }
 
-float calculate_x_overlap(Entity entity1, Entity entity2) {
+float calculate_x_overlap(Entity entity1, Entity entity2, ECSRegistry& registry) {
 	Motion& motion1 = registry.motions.get(entity1);
+	Shape& shape1 = registry.shapes.get(entity1);
 	Motion& motion2 = registry.motions.get(entity2);
+	Shape& shape2 = registry.shapes.get(entity2);
 
-	float x1_half_scale = motion1.hitbox.x / 2;
-	float x2_half_scale = motion2.hitbox.x / 2;
+	float x1_half_scale = shape1.hitbox.x / 2;
+	float x2_half_scale = shape2.hitbox.x / 2;
 
 	// Determine the edges of the hitboxes for x
 	float left1 = motion1.position.x - x1_half_scale;
@@ -402,12 +450,14 @@ float calculate_x_overlap(Entity entity1, Entity entity2) {
 	return max(0.f, min(right1, right2) - max(left1, left2));
 }
 
-float calculate_y_overlap(Entity entity1, Entity entity2) {
+float calculate_y_overlap(Entity entity1, Entity entity2, ECSRegistry& registry) {
 	Motion& motion1 = registry.motions.get(entity1);
+	Shape& shape1 = registry.shapes.get(entity1);
 	Motion& motion2 = registry.motions.get(entity2);
+	Shape& shape2 = registry.shapes.get(entity2);
 
-	float y1_half_scale = motion1.hitbox.y / 2;
-	float y2_half_scale = motion2.hitbox.y / 2;
+	float y1_half_scale = shape1.hitbox.y / 2;
+	float y2_half_scale = shape2.hitbox.y / 2;
 
 	// Determine the edges of the hitboxes for y
 	float top1 = motion1.position.y - y1_half_scale;
@@ -419,26 +469,28 @@ float calculate_y_overlap(Entity entity1, Entity entity2) {
 	return max(0.f, min(bottom1, bottom2) - max(top1, top2));
 }
 
-void PhysicsSystem::handle_mesh_collision(Entity mesh, Entity entity)
+bool PhysicsSystem::handle_mesh_collision(Entity mesh, Entity entity)
 {
 
 	Motion& meshMotion = registry.motions.get(mesh);
+	Shape& meshShape = registry.shapes.get(mesh);
 	Motion& entityMotion = registry.motions.get(entity);
+	Shape& entityShape = registry.shapes.get(entity);
 
 	if (registry.projectiles.has(entity)) {
 		entityMotion.velocity = vec3(0);
-		return;
+		return false;
 	}
 
 	// Example - fireball
-	if (registry.damagings.has(entity) && registry.damagings.get(entity).type == "fireball") {
-		// Destroy the damaging
-		registry.remove_all_components_of(entity);
-		return;
+	if (registry.damagings.has(entity) && registry.damagings.get(entity).type == DAMAGING_TYPE::FIREBALL) {
+		// Destroy the damaging once checkCollisions is done with the motion indices
+		registry.defer_destroy(entity);
+		return true;
 	}
 
-	float x_overlap = max(0.f, (meshMotion.hitbox.x / 8 + entityMotion.hitbox.x / 2) - abs(meshMotion.position.x - entityMotion.position.x));
-	float y_overlap = max(0.f, (meshMotion.hitbox.y / 8 + entityMotion.hitbox.y / 2) - abs(meshMotion.position.y - entityMotion.position.y));;
+	float x_overlap = max(0.f, (meshShape.hitbox.x / 8 + entityShape.hitbox.x / 2) - abs(meshMotion.position.x - entityMotion.position.x));
+	float y_overlap = max(0.f, (meshShape.hitbox.y / 8 + entityShape.hitbox.y / 2) - abs(meshMotion.position.y - entityMotion.position.y));;
 
 	// Calculate the direction of the collision
 	float x_direction = meshMotion.position.x < entityMotion.position.x ? -1 : 1;
@@ -456,6 +508,7 @@ void PhysicsSystem::handle_mesh_collision(Entity mesh, Entity entity)
 	if (entityMotion.velocity.z > 0) {
 		entityMotion.velocity.z = 0;
 	}
+	return false;
 }
 
 void PhysicsSystem::handle_obstacle_collision(Entity obstacle, Entity entity)
@@ -469,9 +522,9 @@ void PhysicsSystem::handle_obstacle_collision(Entity obstacle, Entity entity)
 	}
 
 	// Calculate x overlap
-	float x_overlap = calculate_x_overlap(obstacle, entity);
+	float x_overlap = calculate_x_overlap(obstacle, entity, registry);
 	// Calculate y overlap
-	float y_overlap = calculate_y_overlap(obstacle, entity);
+	float y_overlap = calculate_y_overlap(obstacle, entity, registry);
 
 	// Calculate the direction of the collision
 	float x_direction = obstacleM.position.x < entityM.position.x ? -1 : 1;
@@ -493,9 +546,9 @@ void PhysicsSystem::handle_obstacle_collision(Entity obstacle, Entity entity)
 
 void PhysicsSystem::recoil_entities(Entity entity1, Entity entity2) {
 	// Calculate x overlap
-	float x_overlap = calculate_x_overlap(entity1, entity2);
+	float x_overlap = calculate_x_overlap(entity1, entity2, registry);
 	// Calculate y overlap
-	float y_overlap = calculate_y_overlap(entity1, entity2);
+	float y_overlap = calculate_y_overlap(entity1, entity2, registry);
 
 	Motion& motion1 = registry.motions.get(entity1);
 	Motion& motion2 = registry.motions.get(entity2);
@@ -516,6 +569,18 @@ void PhysicsSystem::recoil_entities(Entity entity1, Entity entity2) {
 	}
 }
 
+PhysicsSystem::PhysicsSystem(ECSRegistry& registry) :
+	registry(registry),
+	broadphase((float)tile_x / BROADPHASE_CELLS_PER_TILE, x_tiles * BROADPHASE_CELLS_PER_TILE, y_tiles * BROADPHASE_CELLS_PER_TILE)
+{
+	for (const auto& pair : COLLIDING_LAYERS) {
+		layerMasks[(int)pair[0]] |= 1u << (int)pair[1];
+		layerMasks[(int)pair[1]] |= 1u << (int)pair[0];
+	}
+	registry.staticBodies.on_add.push_back([this](Entity, StaticBody&) { staticBodiesChanged = true; });
+	registry.staticBodies.on_remove.push_back([this](Entity, StaticBody&) { staticBodiesChanged = true; });
+}
+
 void PhysicsSystem::init(SoundSystem* sound)
 {
 	this->sound = sound;
@@ -527,16 +592,16 @@ void PhysicsSystem::step(float elapsed_ms)
 	checkCollisions();
 };
 
-std::vector<vec3> boundingBoxVertices(Motion& motion)
+std::array<vec3, 8> boundingBoxVertices(const Motion& motion, const Shape& shape, const Presentation& presentation)
 {
-	std::vector<vec3> vertices;
-	vertices.reserve(8);
+	std::array<vec3, 8> vertices;
+	int n = 0;
 	for (auto i : { -0.5f, 0.5f }) {
 		for (auto j : { -0.5f, 0.5f }) {
 			for (auto k : { -0.5f, 0.5f }) {
 				vec3 vertex = vec3(i, j, k);
-				vertex = tranformVertex(vertex, motion.position, motion.angle, motion.hitbox);
-				vertices.push_back(vertex);
+				vertex = tranformVertex(vertex, motion.position, presentation.angle, shape.hitbox);
+				vertices[n++] = vertex;
 			}
 		}
 	}
@@ -5,32 +5,71 @@
 #include "components.hpp"
 #include "tiny_ecs_registry.hpp"
 #include "sound_system.hpp"
+#include "spatial_hash.hpp"
+#include "static_bvh.hpp"
+#include "separating_axis.hpp"
+
+#include <array>
 
 // A simple physics system that moves rigid bodies and checks for collision
 class PhysicsSystem
 {
 public:
+	PhysicsSystem(ECSRegistry& registry);
 	void init(SoundSystem* sound);
 	void step(float elapsed_ms);
 
-	// Array to store collision pairs
+	// Colliding pairs of this frame, each pair once: handle_collisions looks at it from both sides
 	std::vector<std::pair<Entity, Entity>> collisions;
 
+	// Whether the collision filter lets pairs of these layers through, see COLLIDING_LAYERS in physics_system.cpp
+	bool layersCollide(COLLISION_LAYER a, COLLISION_LAYER b) const {
+		return (layerMasks[(int)a] >> (int)b) & 1;
+	}
+	bool collidesWithAnything(COLLISION_LAYER layer) const {
+		return layerMasks[(int)layer] != 0;
+	}
+
 private:
+	ECSRegistry& registry;
 	SoundSystem* sound;
 
+	// Bit b of layerMasks[a] is set when layers a and b collide
+	uint32_t layerMasks[(int)COLLISION_LAYER::LAYER_COUNT] = {};
+
+	// Broadphase of checkCollisions, kept across frames, and the candidate pairs (motion indices) of the last frame
+	SpatialHash broadphase;
+	std::vector<std::pair<uint, uint>> candidatePairs;
+
+	// Narrowphase input and output of checkCollisions: the turned hitbox of every motion index and whether the
+	// boxes of candidatePairs[k] overlap, all pairs tested in one batch
+	std::vector<OrientedBox> boundingBoxes;
+	std::vector<uint8_t> candidateOverlaps;
+	std::vector<uint8_t> destroyedSlots; // motion indices whose entity a collision destroyed this frame
+
+	// StaticBody entities skip the grid: they sit in a hierarchy that is only rebuilt when static bodies come or go
+	// (world creation or load) and that moving bodies are queried against
+	StaticBVH staticBodies;
+	bool staticBodiesChanged = true;
+	std::vector<StaticBVH::Item> staticItems;
+	std::vector<uint> staticSlots; // motion index of every static body this frame, by Entity::index()
+	void rebuildStaticBodies();
+
 	void updatePositions(float elapsed_ms);
 	void checkCollisions();
 	void handleBoundsCheck();
 	void recoil_entities(Entity motion1, Entity motion2);
-	void handle_mesh_collision(Entity entityM, Entity other_entity);
+	// Returns true if other_entity is destroyed (at the next flush_deferred)
+	bool handle_mesh_collision(Entity entityM, Entity other_entity);
 	void handle_obstacle_collision(Entity entityM, Entity obstacleM);
 	bool meshCollides(Entity& mesh_entity, Entity& other_entity);
 };
 
-std::vector<vec3> boundingBoxVertices(Motion& motion);
-bool polygonsCollide(const std::vector<vec2>& polygon1, const std::vector<vec2>& polygon2);
+std::array<vec3, 8> boundingBoxVertices(const Motion& motion, const Shape& shape, const Presentation& presentation);
 
 const float GRAVITATIONAL_CONSTANT = 0.01;
 const float BOUNCE_FACTOR = 0.5f;
 const float FRICTION_FACTOR = 0.95f;
+
+// Broadphase cells are a fraction of a map tile so the grid lines up with the tile_x/tile_y world grid
+const int BROADPHASE_CELLS_PER_TILE = 4;
@@ -0,0 +1,130 @@
+#pragma once
+
+// stdlib
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+// Small-object memory of a registry: size-class free lists carved out of large blocks. Freed memory goes back onto
+// its list and is handed out again, so once a game has run for a while, hash nodes and buckets of components are
+// recycled instead of going through the general-purpose heap. Blocks are only returned by release() or the
+// destructor. Not thread safe, a pool belongs to one registry and the thread that runs it. Components get their
+// registry's pool passed in when they are created (see ECSRegistry::emplace_animation_controller).
+class PoolResource
+{
+public:
+	enum : size_t {
+		MIN_CLASS_BYTES = 16,
+		CLASS_COUNT = 6,                            // 16, 32, 64, 128, 256 and 512 bytes
+		MAX_CLASS_BYTES = MIN_CLASS_BYTES << (CLASS_COUNT - 1),
+		BLOCK_BYTES = 64 * 1024
+	};
+
+	PoolResource() {}
+	~PoolResource() { release(); }
+	PoolResource(const PoolResource&) = delete;
+	PoolResource& operator=(const PoolResource&) = delete;
+
+	void* allocate(size_t bytes)
+	{
+		if (bytes > MAX_CLASS_BYTES)
+			return ::operator new(bytes);
+		size_t c = size_class(bytes);
+		in_use += MIN_CLASS_BYTES << c;
+		if (FreeNode* node = free_lists[c]) {
+			free_lists[c] = node->next;
+			return node;
+		}
+		size_t size = MIN_CLASS_BYTES << c;
+		if (cursor + size > end) {
+			blocks.emplace_back(new char[BLOCK_BYTES]);
+			cursor = blocks.back().get();
+			end = cursor + BLOCK_BYTES;
+		}
+		void* p = cursor;
+		cursor += size;
+		return p;
+	}
+
+	void deallocate(void* p, size_t bytes)
+	{
+		if (bytes > MAX_CLASS_BYTES) {
+			::operator delete(p);
+			return;
+		}
+		size_t c = size_class(bytes);
+		in_use -= MIN_CLASS_BYTES << c;
+		FreeNode* node = static_cast<FreeNode*>(p);
+		node->next = free_lists[c];
+		free_lists[c] = node;
+	}
+
+	// Returns every block at once, only valid when nothing allocated from the pool is still alive
+	void release()
+	{
+		assert(in_use == 0 && "Releasing a pool that still has live allocations");
+		blocks.clear();
+		cursor = end = nullptr;
+		for (FreeNode*& list : free_lists)
+			list = nullptr;
+	}
+
+	// Bytes held in blocks and bytes of those handed out right now
+	size_t reserved_bytes() const { return blocks.size() * BLOCK_BYTES; }
+	size_t used_bytes() const { return in_use; }
+
+private:
+	struct FreeNode { FreeNode* next; };
+
+	static size_t size_class(size_t bytes)
+	{
+		size_t c = 0;
+		while ((MIN_CLASS_BYTES << c) < bytes)
+			c++;
+		return c;
+	}
+
+	FreeNode* free_lists[CLASS_COUNT] = {};
+	std::vector<std::unique_ptr<char[]>> blocks;
+	char* cursor = nullptr;
+	char* end = nullptr;
+	size_t in_use = 0;
+};
+
+// Standard allocator on top of a PoolResource, the C++14 stand-in for std::pmr::polymorphic_allocator.
+// Without a pool (default construction or nullptr) it falls back to operator new. A copy of a container, such
+// as a snapshot of a component, allocates from the heap rather than from the pool of the original.
+template <typename T>
+struct PoolAllocator
+{
+	using value_type = T;
+
+	PoolResource* pool;
+
+	PoolAllocator() : pool(nullptr) {}
+	explicit PoolAllocator(PoolResource* pool) : pool(pool) {}
+	template <typename U>
+	PoolAllocator(const PoolAllocator<U>& other) : pool(other.pool) {}
+
+	PoolAllocator select_on_container_copy_construction() const { return PoolAllocator(); }
+
+	T* allocate(size_t n)
+	{
+		return static_cast<T*>(pool ? pool->allocate(n * sizeof(T)) : ::operator new(n * sizeof(T)));
+	}
+
+	void deallocate(T* p, size_t n)
+	{
+		if (pool)
+			pool->deallocate(p, n * sizeof(T));
+		else
+			::operator delete(p);
+	}
+};
+
+template <typename T, typename U>
+bool operator==(const PoolAllocator<T>& a, const PoolAllocator<U>& b) { return a.pool == b.pool; }
+template <typename T, typename U>
+bool operator!=(const PoolAllocator<T>& a, const PoolAllocator<U>& b) { return a.pool != b.pool; }
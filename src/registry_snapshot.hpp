@@ -0,0 +1,69 @@
+#pragma once
+
+// stdlib
+#include <atomic>
+
+// internal
+#include "tiny_ecs_registry.hpp"
+
+// Double-buffered read-only copy of the containers that rendering, AI and sound read, taken at the end of a
+// simulation tick. Readers work on last tick's state while the next tick mutates the registry, possibly on
+// another thread. capture() writes the buffer nobody reads and then publishes it, so a reader has to be done with
+// a frame before the second capture after it (one tick of slack, the usual frame sync).
+// Nothing captures one yet: every system still runs on the main thread against the live registry. Whichever system
+// first moves to a worker thread has to read all of its state from the frame, or it mixes two ticks.
+class RegistrySnapshot
+{
+public:
+	// The part of an AnimationController a renderer needs: the animation that is playing. The controller's map of
+	// every animation stays in the registry, copying it each tick would cost an allocation per node.
+	struct AnimationFrame
+	{
+		AnimationState state = AnimationState::Idle;
+		Animation animation;
+
+		AnimationFrame() = default;
+		AnimationFrame(const AnimationController& controller) : state(controller.currentState)
+		{
+			auto playing = controller.animations.find(controller.currentState);
+			if (playing != controller.animations.end())
+				animation = playing->second;
+		}
+	};
+
+	struct Frame
+	{
+		uint32_t frame = 0; // registry frame the copy was taken in, 0 before the first capture
+
+		ComponentContainer<Motion> motions;
+		ComponentContainer<Presentation> presentations;
+		ComponentContainer<RenderRequest> renderRequests;
+		ComponentContainer<AnimationFrame> animations;
+		ComponentContainer<Player> players;   // player health
+		ComponentContainer<Enemy> enemies;    // enemy health
+	};
+
+	// Copy the selected containers of 'registry' into the back buffer and make it the current frame
+	void capture(ECSRegistry& registry)
+	{
+		Frame& back = frames[1 - published.load(std::memory_order_relaxed)];
+		back.frame = registry.current_frame();
+		back.motions.copy_from(registry.motions);
+		back.presentations.copy_from(registry.presentations);
+		back.renderRequests.copy_from(registry.renderRequests);
+		back.animations.copy_from(registry.animationControllers);
+		back.players.copy_from(registry.players);
+		back.enemies.copy_from(registry.enemies);
+		published.store(1 - published.load(std::memory_order_relaxed), std::memory_order_release);
+	}
+
+	// The last captured frame
+	const Frame& current() const
+	{
+		return frames[published.load(std::memory_order_acquire)];
+	}
+
+private:
+	Frame frames[2];
+	std::atomic<unsigned int> published{ 0 };
+};
@@ -189,13 +189,19 @@ enum class PARTICLE {
 	DASH
 };
 
-struct Particle
+// Particles live in the registry.particles archetype, the fields simulated every frame are kept apart from the ones
+// only drawing reads
+struct ParticleMotion
 {
-	PARTICLE type = PARTICLE::SMOKE;
 	vec3 position = { 0, 0, 0 };
-	float angle = 0;
 	vec3 velocity = { 0, 0, 0 };
-	vec2 scale = { 10, 10 };
 	float gravity = 1.0;			// 1 means affected by gravity normally, 0 is no gravity
 	float life = 10000.f;
+};
+
+struct Particle
+{
+	PARTICLE type = PARTICLE::SMOKE;
+	float angle = 0;
+	vec2 scale = { 10, 10 };
 };
\ No newline at end of file
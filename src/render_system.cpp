@@ -29,7 +29,7 @@ void RenderSystem::drawText(Entity entity, const mat4& projection_screen) {
 
 	glActiveTexture(GL_TEXTURE0);
 
-	std::vector<vec2> renderPositions = getTextRenderPositions(text.value, fg.scale.x, text.lineSpacing, text.alignment, fg.position);
+	std::vector<vec2> renderPositions = getTextRenderPositions(text.value, fg.scale.x, text.lineSpacing, text.alignment, fg.position, registry);
 
 	float lineIndex = 0;
 	float startX = renderPositions[lineIndex].x;
@@ -101,24 +101,25 @@ void RenderSystem::drawMesh(Entity entity, const mat3& projection, const mat4& p
 	Transform3D modelMatrix;
 	if (registry.motions.has(entity)) {
 		Motion& motion = registry.motions.get(entity);
+		Presentation& presentation = registry.presentations.get(entity);
 		if (registry.midgrounds.has(entity) || registry.backgrounds.has(entity)) {
 			vec2 visualPos = worldToVisual(vec3(motion.position.x, motion.position.y, motion.position.z));
 			if (registry.meshPtrs.has(entity)) {
-				visualPos.y += motion.scale.y / 20; // corrects the render location of the tree sprite
+				visualPos.y += presentation.scale.y / 20; // corrects the render location of the tree sprite
 			}
 			transform.translate(visualPos);
 		}
 		else {
 			transform.translate(motion.position);
 		}
-		transform.rotate(motion.angle);
-		transform.scale(motion.scale);
+		transform.rotate(presentation.angle);
+		transform.scale(presentation.scale);
 
 		modelMatrix.translate(motion.position);
-		modelMatrix.rotate(motion.angle);
+		modelMatrix.rotate(presentation.angle);
 		// TODO: Add a flat component for determining this
 		bool flat = registry.mapTiles.has(entity);
-		modelMatrix.scale(vec2(motion.scale.x, motion.scale.y / yConversionFactor), flat);
+		modelMatrix.scale(vec2(presentation.scale.x, presentation.scale.y / yConversionFactor), flat);
 	}
 	//else {
 	//	registry.list_all_components_of(entity);
@@ -302,8 +303,8 @@ void RenderSystem::bindAnimationAttributes(const GLuint program, const Entity &e
     GLint numFrames_loc = glGetUniformLocation(program, "num_frames");
     GLint currentFrame_loc = glGetUniformLocation(program, "current_frame");
 
-    AnimationController animationController = registry.animationControllers.get(entity);
-    Animation currentAnimation = animationController.animations[animationController.currentState];
+    AnimationController& animationController = registry.animationControllers.get(entity);
+    const Animation& currentAnimation = animationController.animations[animationController.currentState];
     glUniform1f(numFrames_loc, currentAnimation.numFrames);       // Set numFrames value
     glUniform1f(currentFrame_loc, currentAnimation.currentFrame); // Set currentFrame value
     gl_has_errors();
@@ -391,7 +392,7 @@ void RenderSystem::bindPointLights(const GLuint program, const Entity& entity, c
 }
 
 // Returns true if entity a is further from the camera
-bool renderComparison(Entity a, Entity b)
+bool renderComparison(Entity a, Entity b, ECSRegistry& registry)
 {
 	if (!registry.motions.has(a)) {
 		return false;
@@ -438,11 +439,10 @@ void RenderSystem::draw()
 		drawMesh(entity, projection_2D, projection_screen);
 	}
 	
-	// Copy entities and sort
-	std::vector<Entity> renderOrder = registry.midgrounds.entities;
-	std::sort(renderOrder.begin(), renderOrder.end(), renderComparison);
+	// Midgrounds are kept in render order, entities only move a little between frames so repairing it is cheap
+	registry.midgrounds.repair_order();
 	// Draw all midground textured meshes that have a position and size component
-	for (Entity entity : renderOrder) {
+	for (Entity entity : registry.midgrounds.entities) {
 		drawMesh(entity, projection_2D, projection_screen);
 	}
 
@@ -453,6 +453,8 @@ void RenderSystem::draw()
 	for (Entity entity : registry.foregrounds.entities) {
 		if(entity == registry.fpsTracker.textEntity && !registry.fpsTracker.toggled) {
 			continue; //skip rendering fps if not toggled
+		} else if(entity == registry.memoryTracker.textEntity && !registry.memoryTracker.toggled) {
+			continue;
 		} else if(registry.texts.has(entity)) {
 			drawText(entity, projection_screen);
 		} else {
@@ -500,17 +502,18 @@ void RenderSystem::step(float elapsed_ms)
 
 	for (Entity entity : registry.projectiles.entities) {
 		Motion& motion = registry.motions.get(entity);
+		Presentation& presentation = registry.presentations.get(entity);
 		if (length(motion.velocity) == 0) {
 			Projectile& projectile = registry.projectiles.get(entity);
 			projectile.sticksInGround -= elapsed_ms;
 			if (projectile.sticksInGround <= 0) {
 	
 				if(projectile.type == PROJECTILE_TYPE::TRAP) {
-					createDamageTrap({motion.position.x, motion.position.y});
+					createDamageTrap({motion.position.x, motion.position.y}, registry);
 				} else if(projectile.type == PROJECTILE_TYPE::PHANTOM_TRAP) {
-					createPhantomTrap({motion.position.x, motion.position.y});
+					createPhantomTrap({motion.position.x, motion.position.y}, registry);
 				} else if(projectile.type == PROJECTILE_TYPE::BOMB_FUSED) {
-					createExplosion(motion.position);
+					createExplosion(motion.position, registry);
 					sound->playSoundEffect(Sound::EXPLOSION, 0);
 				}
 				registry.remove_all_components_of(entity);
@@ -518,13 +521,14 @@ void RenderSystem::step(float elapsed_ms)
 			continue;
 		}
 		vec2 direction = normalize(worldToVisual(motion.velocity));
-		motion.angle = atan2(direction.y, direction.x);
+		presentation.angle = atan2(direction.y, direction.x);
 	}
 	update_animations();
 	update_hpbars();
 	update_staminabars();
 	updateEntityFacing();
-	updateCollectedPosition();
+	// bars and indicators follow the entities they are attached to
+	registry.update_hierarchy();
 	updateSlideUps(elapsed_ms);
 }
 
@@ -547,31 +551,32 @@ void RenderSystem::update_animations() {
 }
 
 void RenderSystem::update_jeff_animation() {
-	for (Entity entity : registry.players.entities) {
-		Player& player = registry.players.get(entity);
-		Motion& motion = registry.motions.get(entity);
-		AnimationController& animationController = registry.animationControllers.get(entity);
+	auto players = registry.view<Player, Presentation, AnimationController>();
+	for (Entity entity : players) {
+		Player& player = players.get<Player>(entity);
+		Presentation& presentation = players.get<Presentation>(entity);
+		AnimationController& animationController = players.get<AnimationController>(entity);
 		
 		// Determine if player is moving
 		player.isMoving = player.goingUp || player.goingDown || player.goingLeft || player.goingRight;
 
 		// Determine the player's facing direction
 		if (player.goingRight) {
-			motion.scale = vec2(std::abs(motion.scale.x), std::abs(motion.scale.y));  // Right
+			presentation.scale = vec2(std::abs(presentation.scale.x), std::abs(presentation.scale.y));  // Right
 		} else if (player.goingLeft) {
-			motion.scale = vec2(-std::abs(motion.scale.x), std::abs(motion.scale.y)); // Left
+			presentation.scale = vec2(-std::abs(presentation.scale.x), std::abs(presentation.scale.y)); // Left
 		}
 
 		Jumper& playerJumper = registry.jumpers.get(entity);
 
 		// Animation state logic
 		if (playerJumper.isJumping) {
-			animationController.changeState(entity, AnimationState::Jumping);
+			animationController.changeState(entity, AnimationState::Jumping, registry);
 		} else if (player.isMoving) {
-			animationController.changeState(entity, AnimationState::Running);
+			animationController.changeState(entity, AnimationState::Running, registry);
 		} else {
 			// Player is idle if no movement keys are pressed
-			animationController.changeState(entity, AnimationState::Idle);
+			animationController.changeState(entity, AnimationState::Idle, registry);
 		}
 	}
 }
@@ -583,7 +588,7 @@ void RenderSystem::update_bow_animations() {
 		if(ac.currentState == AnimationState::Attack && 
 			ac.animations[ac.currentState].currentFrame == 0 &&
 			ac.animations[ac.currentState].elapsedTime == 0) {
-			ac.changeState(entity, AnimationState::Default);
+			ac.changeState(entity, AnimationState::Default, registry);
 		}	
 	}
 }
@@ -608,12 +613,13 @@ void RenderSystem::turn_damaged_red(std::vector<Entity>& was_damaged)
 	}
 }
 
-void handleHpBarBoundsCheck() {
+void handleHpBarBoundsCheck(ECSRegistry& registry) {
 	for(Entity& entity : registry.enemies.entities) {
 		HealthBar& hpbar = registry.healthBars.get(entity);
 		Motion& motion = registry.motions.get(hpbar.meshEntity);
-		float halfScaleX = motion.scale.x / 2;
-		float halfScaleY = visualToWorldY(motion.scale.y) / 2;
+		Presentation& presentation = registry.presentations.get(hpbar.meshEntity);
+		float halfScaleX = presentation.scale.x / 2;
+		float halfScaleY = visualToWorldY(presentation.scale.y) / 2;
 
 		if(motion.position.x - halfScaleX  < 0) {
 			motion.position.x = halfScaleX;
@@ -622,7 +628,7 @@ void handleHpBarBoundsCheck() {
 		}
 
 		if(motion.position.y - halfScaleY - motion.position.z < 0) {
-			motion.position.y = visualToWorldY(motion.scale.y);
+			motion.position.y = visualToWorldY(presentation.scale.y);
 			motion.position.z = -5;
 		} else if(motion.position.y + halfScaleY > world_size_y) {
 			motion.position.y = world_size_y - halfScaleY;
@@ -633,40 +639,6 @@ void handleHpBarBoundsCheck() {
 	}
 }
 
-void updateHpBarPositionHelper(const std::vector<Entity>& entities) {
-    for (Entity entity : entities) {
-	    HealthBar& healthBar = registry.healthBars.get(entity);
-        Motion& motion = registry.motions.get(entity);
-        Motion& healthBarMotion =  registry.motions.get(healthBar.meshEntity);
-		float topOffset = 25;
-         // place above character
-		 if(registry.players.has(entity)) {
-			topOffset += healthBar.height + 5;
-		 }
-		healthBarMotion.position.x = motion.position.x - (healthBar.width / 2);
-        healthBarMotion.position.y = motion.position.y;
-		healthBarMotion.position.z = motion.position.z + visualToWorldY(motion.scale.y) / 2 + topOffset;
-		Motion& hpFrameMotion =  registry.motions.get(healthBar.frameEntity);
-		hpFrameMotion.position = healthBarMotion.position;
-    }   
-}
-
-void RenderSystem::updateCollectedPosition() {
-	Entity& playerE = registry.players.entities[0];
-	Motion& playerM = registry.motions.get(playerE);
-	HealthBar& hpBar = registry.healthBars.get(playerE);
-
-    for (Entity entity : registry.collected.entities) {
-        Motion& collectedM =  registry.motions.get(entity);
-        // place above character
-        float topOffset = 30;
-		float horizontalOffset = hpBar.width / 2;
-		collectedM.position.x = playerM.position.x + horizontalOffset + 15;
-        collectedM.position.y = playerM.position.y;
-		collectedM.position.z = playerM.position.z + visualToWorldY(playerM.scale.y) / 2 + topOffset;
-    }   
-}
-
 void RenderSystem::updateSlideUps(float elapsed_ms) {
 	for (Entity entity : registry.slideUps.entities) {
 		SlideUp& slideUp = registry.slideUps.get(entity);
@@ -713,7 +685,8 @@ void RenderSystem::updateSlideUps(float elapsed_ms) {
 	}
 }
 
-void updateHpBarMeter() {
+// Enemy bars are only resized for enemies whose health changed since frame 'since'
+void updateHpBarMeter(ECSRegistry& registry, uint32_t since) {
 	Entity entity = registry.players.entities[0];
 	Player& player = registry.players.get(entity);
 	
@@ -726,8 +699,8 @@ void updateHpBarMeter() {
 	text.value = ss.str();
 
 	HealthBar& playerHPBar = registry.healthBars.get(entity);
-	Motion& playerHPMotion = registry.motions.get(playerHPBar.meshEntity);
-	playerHPMotion.scale.x = playerHPBar.width * player.health/100.f;
+	Presentation& playerHPPresentation = registry.presentations.get(playerHPBar.meshEntity);
+	playerHPPresentation.scale.x = playerHPBar.width * player.health/100.f;
 
 	if(player.health <= 30.0f) {
 		vec4 red = {1.0f, 0.0f, 0.0f, 1.0f};
@@ -750,22 +723,19 @@ void updateHpBarMeter() {
 		registry.colours.get(playerHPBar.frameEntity) = green;
 	}
 	
-	for (Entity entity : registry.enemies.entities) {
-		Enemy& enemy = registry.enemies.get(entity);
+	registry.enemies.changed_since(since, [&registry](Entity entity, Enemy& enemy) {
+		if (!registry.healthBars.has(entity)) {
+			return;
+		}
 		HealthBar& hpbar = registry.healthBars.get(entity);
-		Motion& motion = registry.motions.get(hpbar.meshEntity);
-		motion.scale.x = hpbar.width * enemy.health/enemy.maxHealth;
-	}
-}
-
-void updateHpBarPosition() {
-	updateHpBarPositionHelper(registry.players.entities);
-    updateHpBarPositionHelper(registry.enemies.entities);
+		Presentation& presentation = registry.presentations.get(hpbar.meshEntity);
+		presentation.scale.x = hpbar.width * enemy.health/enemy.maxHealth;
+	});
 }
 
 void RenderSystem::update_hpbars() {
-	updateHpBarMeter();
-	updateHpBarPosition();
+	updateHpBarMeter(registry, hp_meter_frame);
+	hp_meter_frame = registry.current_frame();
 }
 
 void RenderSystem::update_staminabars() {
@@ -776,34 +746,24 @@ void RenderSystem::update_staminabars() {
 	Foreground& fg = registry.foregrounds.get(playerUI.staminaMeshEntity);
 	Stamina& stamina = registry.staminas.get(entity);
 	StaminaBar& staminaBar = registry.staminaBars.get(entity);
-	Motion& playerMotion = registry.motions.get(entity);
-	Motion& staminaBarMotion =  registry.motions.get(staminaBar.meshEntity);
-	Motion& staminaBarFrameMotion =  registry.motions.get(staminaBar.frameEntity);
+	Presentation& staminaBarPresentation = registry.presentations.get(staminaBar.meshEntity);
 
 	// update meter
 	fg.scale.x = playerUI.staminaMaxSize.x * stamina.stamina/stamina.max_stamina;
-	staminaBarMotion.scale.x = staminaBar.width * stamina.stamina/stamina.max_stamina;
+	staminaBarPresentation.scale.x = staminaBar.width * stamina.stamina/stamina.max_stamina;
 	Text& text = registry.texts.get(playerUI.staminaTextEntity);
 	std::stringstream ss;
 	ss << "Stamina" << std::string(8, ' ') << std::to_string((int)stamina.stamina) << "/100";
 	text.value = ss.str();
-
-	// update position
-    // place above character
-	float topOffset = 25;
-	staminaBarMotion.position.x = playerMotion.position.x - (staminaBar.width / 2);
-    staminaBarMotion.position.y = playerMotion.position.y;
-	staminaBarMotion.position.z = playerMotion.position.z + visualToWorldY(playerMotion.scale.y) / 2 + topOffset;
-	staminaBarFrameMotion.position = staminaBarMotion.position;
 }
 
 void RenderSystem::updateEntityFacing() {
-	for (Motion& motion : registry.motions.components) {
-    if (motion.facing.x > 0) {
-      motion.scale.x = abs(motion.scale.x);
+	for (Presentation& presentation : registry.presentations.components) {
+    if (presentation.facing.x > 0) {
+      presentation.scale.x = abs(presentation.scale.x);
     }
-    else if (motion.facing.x < 0) {
-      motion.scale.x = -1.0f * abs(motion.scale.x);
+    else if (presentation.facing.x < 0) {
+      presentation.scale.x = -1.0f * abs(presentation.scale.x);
     }
 	}
 }
@@ -910,7 +870,7 @@ vec2 RenderSystem::worldToScreen(vec3 worldPos) {
 	return { screenPosX, screenPosY };
 }
 
-std::vector<vec2> getTextRenderPositions(std::string textValue, float scale, float lineSpacing, TEXT_ALIGNMENT alignment, vec2 alignmentPos) {
+std::vector<vec2> getTextRenderPositions(std::string textValue, float scale, float lineSpacing, TEXT_ALIGNMENT alignment, vec2 alignmentPos, ECSRegistry& registry) {
     std::vector<vec2> renderPositions;
     float textLength = 0;
     float lineIndex = 0;
@@ -170,6 +170,8 @@ public:
 	void initializeGlMeshes();
 	Mesh& getMesh(GEOMETRY_BUFFER_ID id) { return meshes[(int)id]; };
 
+	RenderSystem(ECSRegistry& registry);
+
 	// Destroy resources associated to one or all entities created by the system
 	~RenderSystem();
 
@@ -188,11 +190,15 @@ public:
 	vec3 mouseToWorld(vec2 mousePos);
 
 private:
+	ECSRegistry& registry;
 	SoundSystem* sound;
 	Camera* camera;
 	ParticleSystem* particles;
 	const float AMBIENT_LIGHT = 0.2;
 
+	// Frame the enemy hp meters were last brought up to date in, see update_hpbars
+	uint32_t hp_meter_frame = 0;
+
 	// Internal drawing functions for each entity type
 	void drawMesh(Entity entity, const mat3& projection, const mat4& projection_screen);
 
@@ -218,7 +224,6 @@ private:
 
 	void updateEntityFacing();
 
-    void updateCollectedPosition();
 
 	void updateSlideUps(float elapsed_ms);
 	void updateExplosions(float elapsed_ms);
@@ -227,13 +232,15 @@ private:
 	GLFWwindow* window;
 };
 
-std::vector<vec2> getTextRenderPositions(std::string textValue, float scale, float lineSpacing, TEXT_ALIGNMENT alignment, vec2 alignmentPos);
+std::vector<vec2> getTextRenderPositions(std::string textValue, float scale, float lineSpacing, TEXT_ALIGNMENT alignment, vec2 alignmentPos, ECSRegistry& registry);
 
 bool loadEffectFromFile(
 	const std::string& vs_path, const std::string& fs_path, GLuint& out_program);
 
 float worldToVisualY(float y, float z);
 float visualToWorldY(float y);
+// Returns true if entity a is drawn before (further from the camera than) entity b
+bool renderComparison(Entity a, Entity b, ECSRegistry& registry);
 vec2 worldToVisual(vec3 pos);
 static const float yConversionFactor = 1 / sqrt(2);
 static const float zConversionFactor = 1 / sqrt(2);
\ No newline at end of file
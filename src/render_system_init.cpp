@@ -373,6 +373,12 @@ void RenderSystem::initText() {
 }
 
 
+RenderSystem::RenderSystem(ECSRegistry& registry) : registry(registry)
+{
+	ECSRegistry* world = &registry;
+	registry.midgrounds.keep_sorted([world](Entity a, Entity b) { return renderComparison(a, b, *world); });
+}
+
 RenderSystem::~RenderSystem()
 {
 	// Don't need to free gl resources since they last for as long as the program,
@@ -0,0 +1,107 @@
+// internal
+#include "separating_axis.hpp"
+
+// stdlib
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define SEPARATING_AXIS_SSE 1
+#include <xmmintrin.h>
+#endif
+
+// Range of the vertices projected onto 'normal'
+static void project(const glm::vec2* vertices, int count, glm::vec2 normal, float& min, float& max)
+{
+	min = max = normal.x * vertices[0].x + normal.y * vertices[0].y;
+	for (int i = 1; i < count; i++) {
+		float projected = normal.x * vertices[i].x + normal.y * vertices[i].y;
+		if (projected < min) min = projected;
+		if (projected > max) max = projected;
+	}
+}
+
+// Whether one of the edge normals of 'edges' separates the two vertex sets
+static bool separatedByEdgeOf(const glm::vec2* edges, int edgeCount, const glm::vec2* vertices1, int count1, const glm::vec2* vertices2, int count2)
+{
+	for (int i1 = 0; i1 < edgeCount; i1++) {
+		int i2 = (i1 + 1) % edgeCount;
+		glm::vec2 p1 = edges[i1];
+		glm::vec2 p2 = edges[i2];
+		glm::vec2 normal = { p2.y - p1.y, p1.x - p2.x };
+
+		float minA, maxA, minB, maxB;
+		project(vertices1, count1, normal, minA, maxA);
+		project(vertices2, count2, normal, minB, maxB);
+		if (maxA < minB || maxB < minA)
+			return true;
+	}
+	return false;
+}
+
+bool polygonsCollide(const ConvexPolygon& polygon1, const ConvexPolygon& polygon2)
+{
+	if (polygon1.count == 0 || polygon2.count == 0)
+		return false;
+	return !separatedByEdgeOf(polygon1.vertices, polygon1.count, polygon1.vertices, polygon1.count, polygon2.vertices, polygon2.count) &&
+		!separatedByEdgeOf(polygon2.vertices, polygon2.count, polygon1.vertices, polygon1.count, polygon2.vertices, polygon2.count);
+}
+
+bool orientedBoxesCollide(const OrientedBox& box1, const OrientedBox& box2)
+{
+	// Opposite edges of a box share their axis, so two edges per box cover all four axes
+	return !separatedByEdgeOf(box1.corners, 3, box1.corners, 4, box2.corners, 4) &&
+		!separatedByEdgeOf(box2.corners, 3, box1.corners, 4, box2.corners, 4);
+}
+
+#ifdef SEPARATING_AXIS_SSE
+// Lane-wise: whether the axis (nx, ny) separates the corners a* from the corners b*
+static inline __m128 separatedAlong(__m128 nx, __m128 ny, const __m128* ax, const __m128* ay, const __m128* bx, const __m128* by)
+{
+	__m128 minA = _mm_add_ps(_mm_mul_ps(nx, ax[0]), _mm_mul_ps(ny, ay[0]));
+	__m128 maxA = minA;
+	__m128 minB = _mm_add_ps(_mm_mul_ps(nx, bx[0]), _mm_mul_ps(ny, by[0]));
+	__m128 maxB = minB;
+	for (int c = 1; c < 4; c++) {
+		__m128 a = _mm_add_ps(_mm_mul_ps(nx, ax[c]), _mm_mul_ps(ny, ay[c]));
+		__m128 b = _mm_add_ps(_mm_mul_ps(nx, bx[c]), _mm_mul_ps(ny, by[c]));
+		minA = _mm_min_ps(minA, a);
+		maxA = _mm_max_ps(maxA, a);
+		minB = _mm_min_ps(minB, b);
+		maxB = _mm_max_ps(maxB, b);
+	}
+	return _mm_or_ps(_mm_cmplt_ps(maxA, minB), _mm_cmplt_ps(maxB, minA));
+}
+
+// Lane-wise: whether the normal of edge c0 -> c1 of the boxes x/y separates them
+static inline __m128 separatedByEdge(const __m128* x, const __m128* y, int c0, int c1, const __m128* ax, const __m128* ay, const __m128* bx, const __m128* by)
+{
+	return separatedAlong(_mm_sub_ps(y[c1], y[c0]), _mm_sub_ps(x[c0], x[c1]), ax, ay, bx, by);
+}
+#endif
+
+void orientedBoxesCollide(const OrientedBox* boxes, const std::pair<unsigned int, unsigned int>* pairs, size_t count, uint8_t* overlapping)
+{
+	size_t k = 0;
+#ifdef SEPARATING_AXIS_SSE
+	for (; k + 4 <= count; k += 4) {
+		// Corner c of the four pairs side by side, pair k + l in lane l
+		__m128 ax[4], ay[4], bx[4], by[4];
+		const OrientedBox* a[4] = { &boxes[pairs[k].first], &boxes[pairs[k + 1].first], &boxes[pairs[k + 2].first], &boxes[pairs[k + 3].first] };
+		const OrientedBox* b[4] = { &boxes[pairs[k].second], &boxes[pairs[k + 1].second], &boxes[pairs[k + 2].second], &boxes[pairs[k + 3].second] };
+		for (int c = 0; c < 4; c++) {
+			ax[c] = _mm_setr_ps(a[0]->corners[c].x, a[1]->corners[c].x, a[2]->corners[c].x, a[3]->corners[c].x);
+			ay[c] = _mm_setr_ps(a[0]->corners[c].y, a[1]->corners[c].y, a[2]->corners[c].y, a[3]->corners[c].y);
+			bx[c] = _mm_setr_ps(b[0]->corners[c].x, b[1]->corners[c].x, b[2]->corners[c].x, b[3]->corners[c].x);
+			by[c] = _mm_setr_ps(b[0]->corners[c].y, b[1]->corners[c].y, b[2]->corners[c].y, b[3]->corners[c].y);
+		}
+
+		__m128 separated = separatedByEdge(ax, ay, 0, 1, ax, ay, bx, by);
+		separated = _mm_or_ps(separated, separatedByEdge(ax, ay, 1, 2, ax, ay, bx, by));
+		separated = _mm_or_ps(separated, separatedByEdge(bx, by, 0, 1, ax, ay, bx, by));
+		separated = _mm_or_ps(separated, separatedByEdge(bx, by, 1, 2, ax, ay, bx, by));
+		int mask = _mm_movemask_ps(separated);
+		for (int l = 0; l < 4; l++)
+			overlapping[k + l] = !((mask >> l) & 1);
+	}
+#endif
+	for (; k < count; k++)
+		overlapping[k] = orientedBoxesCollide(boxes[pairs[k].first], boxes[pairs[k].second]);
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+// stdlib
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <utility>
+
+// glm
+#include <glm/vec2.hpp>
+
+// Convex polygon with its corners stored inline, building one for a test costs no allocation
+struct ConvexPolygon
+{
+	enum : int { MAX_VERTICES = 8 };
+
+	glm::vec2 vertices[MAX_VERTICES];
+	int count = 0;
+
+	void push_back(glm::vec2 vertex)
+	{
+		assert(count < MAX_VERTICES && "Too many vertices for a ConvexPolygon");
+		vertices[count++] = vertex;
+	}
+};
+
+// Rectangle turned on the plane, corners in order around it
+struct OrientedBox
+{
+	glm::vec2 corners[4];
+};
+
+// Separating axis tests, true when the shapes overlap (touching counts)
+bool polygonsCollide(const ConvexPolygon& polygon1, const ConvexPolygon& polygon2);
+bool orientedBoxesCollide(const OrientedBox& box1, const OrientedBox& box2);
+
+// Tests many pairs of boxes at once: overlapping[k] is set to whether boxes[pairs[k].first] and
+// boxes[pairs[k].second] overlap. With SSE four pairs share one pass, one per lane, the rest goes through the
+// scalar test.
+void orientedBoxesCollide(const OrientedBox* boxes, const std::pair<unsigned int, unsigned int>* pairs, size_t count, uint8_t* overlapping);
@@ -2,7 +2,7 @@
 #include "tiny_ecs_registry.hpp"
 #include <chrono>
 
-SoundSystem::SoundSystem()
+SoundSystem::SoundSystem(ECSRegistry& registry) : registry(registry)
 {
 }
 
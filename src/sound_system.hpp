@@ -9,6 +9,8 @@
 
 #include "common.hpp"
 
+class ECSRegistry;
+
 enum class Music {
 	BACKGROUND,
 	PLAYER_DEATH
@@ -35,7 +37,7 @@ enum class Sound {
 class SoundSystem
 {
 public:
-	SoundSystem();
+	SoundSystem(ECSRegistry& registry);
 	~SoundSystem();
 
 	bool mute = false;
@@ -137,6 +139,7 @@ public:
 	void controlBirdSound();
 
 private:
+	ECSRegistry& registry;
 	std::map<Music, Mix_Music*> loadedMusic;
 	std::map<Sound, Mix_Chunk*> loadedSoundEffects;
 	std::map<Music, int> musicTracks;
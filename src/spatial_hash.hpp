@@ -0,0 +1,161 @@
+#pragma once
+
+// stdlib
+#include <algorithm>
+#include <cmath>
+#include <stdint.h>
+#include <vector>
+
+// internal
+#include "tiny_ecs.hpp"
+
+// Uniform grid broadphase over the ground plane. Every entity is registered in all cells its box overlaps and
+// pairs are only looked for inside a cell, so finding the overlapping pairs costs about the number of entities
+// instead of its square. The grid is kept across frames: update() only touches the cells of an entity whose box
+// crossed a cell border, and sweep() drops the entities that were not updated since the previous sweep.
+// Positions outside the grid are clamped onto its border cells.
+class SpatialHash
+{
+public:
+	SpatialHash(float cell_size, int columns, int rows)
+		: cell_size(cell_size), columns(columns), rows(rows), cells(columns * rows) {}
+
+	// Sets the box of 'entity', inserting it if it is new. 'slot' is the caller's index of the entity this frame,
+	// for_each_pair() hands slots back.
+	void update(Entity entity, uint32_t slot, glm::vec2 min, glm::vec2 max)
+	{
+		unsigned int index = entity.index();
+		if (index >= proxy_of.size())
+			proxy_of.resize(index + 1, NO_PROXY);
+		uint32_t p = proxy_of[index];
+		if (p == NO_PROXY) {
+			p = (uint32_t)proxies.size();
+			proxy_of[index] = p;
+			proxies.emplace_back();
+			Proxy& proxy = proxies.back();
+			proxy.cell_min = cell_of(min);
+			proxy.cell_max = cell_of(max);
+			for_each_cell(proxy, [p](std::vector<uint32_t>& cell) { cell.push_back(p); });
+		}
+		else {
+			Proxy& proxy = proxies[p];
+			glm::ivec2 cell_min = cell_of(min);
+			glm::ivec2 cell_max = cell_of(max);
+			if (cell_min != proxy.cell_min || cell_max != proxy.cell_max) {
+				for_each_cell(proxy, [p](std::vector<uint32_t>& cell) { erase_from(cell, p); });
+				proxy.cell_min = cell_min;
+				proxy.cell_max = cell_max;
+				for_each_cell(proxy, [p](std::vector<uint32_t>& cell) { cell.push_back(p); });
+			}
+		}
+		Proxy& proxy = proxies[p];
+		proxy.entity_index = index;
+		proxy.slot = slot;
+		proxy.min = min;
+		proxy.max = max;
+		proxy.stamp = stamp;
+	}
+
+	// Removes every entity update() was not called for since the last sweep (destroyed or lost its motion)
+	void sweep()
+	{
+		for (uint32_t p = 0; p < proxies.size();) {
+			if (proxies[p].stamp != stamp)
+				remove_proxy(p);
+			else
+				p++;
+		}
+		stamp++;
+	}
+
+	// Calls f(slot_a, slot_b) once for every pair of entities whose boxes overlap (borders touching counts)
+	template <typename Function>
+	void for_each_pair(Function f) const
+	{
+		for (int c = 0; c < (int)cells.size(); c++) {
+			const std::vector<uint32_t>& cell = cells[c];
+			glm::ivec2 cell_position(c % columns, c / columns);
+			for (size_t i = 0; i < cell.size(); i++) {
+				const Proxy& a = proxies[cell[i]];
+				for (size_t j = i + 1; j < cell.size(); j++) {
+					const Proxy& b = proxies[cell[j]];
+					if (a.min.x > b.max.x || b.min.x > a.max.x || a.min.y > b.max.y || b.min.y > a.max.y)
+						continue;
+					// A pair sharing several cells is reported by the one holding the lower corner of the overlap
+					if (cell_of(glm::max(a.min, b.min)) != cell_position)
+						continue;
+					f(a.slot, b.slot);
+				}
+			}
+		}
+	}
+
+	size_t size() const { return proxies.size(); }
+
+	void clear()
+	{
+		for (std::vector<uint32_t>& cell : cells)
+			cell.clear();
+		proxies.clear();
+		std::fill(proxy_of.begin(), proxy_of.end(), NO_PROXY);
+	}
+
+private:
+	enum : uint32_t { NO_PROXY = UINT32_MAX };
+
+	struct Proxy
+	{
+		unsigned int entity_index = 0;
+		uint32_t slot = 0;
+		uint32_t stamp = 0;
+		glm::vec2 min = glm::vec2(0);
+		glm::vec2 max = glm::vec2(0);
+		glm::ivec2 cell_min = glm::ivec2(0); // inclusive range of cells the box overlaps
+		glm::ivec2 cell_max = glm::ivec2(0);
+	};
+
+	glm::ivec2 cell_of(glm::vec2 position) const
+	{
+		// NaN positions land in cell 0
+		int x = position.x > 0 ? (int)std::min(position.x / cell_size, (float)(columns - 1)) : 0;
+		int y = position.y > 0 ? (int)std::min(position.y / cell_size, (float)(rows - 1)) : 0;
+		return glm::ivec2(x, y);
+	}
+
+	template <typename Function>
+	void for_each_cell(const Proxy& proxy, Function f)
+	{
+		for (int y = proxy.cell_min.y; y <= proxy.cell_max.y; y++)
+			for (int x = proxy.cell_min.x; x <= proxy.cell_max.x; x++)
+				f(cells[y * columns + x]);
+	}
+
+	static void erase_from(std::vector<uint32_t>& cell, uint32_t p)
+	{
+		auto it = std::find(cell.begin(), cell.end(), p);
+		*it = cell.back();
+		cell.pop_back();
+	}
+
+	// Swap-removes proxy p, the cells of the proxy moved into its place are renumbered
+	void remove_proxy(uint32_t p)
+	{
+		for_each_cell(proxies[p], [p](std::vector<uint32_t>& cell) { erase_from(cell, p); });
+		proxy_of[proxies[p].entity_index] = NO_PROXY;
+		uint32_t last = (uint32_t)proxies.size() - 1;
+		if (p != last) {
+			for_each_cell(proxies[last], [p, last](std::vector<uint32_t>& cell) { *std::find(cell.begin(), cell.end(), last) = p; });
+			proxies[p] = proxies[last];
+			proxy_of[proxies[p].entity_index] = p;
+		}
+		proxies.pop_back();
+	}
+
+	float cell_size;
+	int columns;
+	int rows;
+	std::vector<std::vector<uint32_t>> cells; // proxy ids, row major
+	std::vector<Proxy> proxies;
+	std::vector<uint32_t> proxy_of;           // proxy id by Entity::index()
+	uint32_t stamp = 1;
+};
@@ -10,6 +10,10 @@
 #include "particle_system.hpp"
 #include "common.hpp"
 
+SpawnManager::SpawnManager(ECSRegistry& registry) : registry(registry)
+{
+}
+
 void SpawnManager::init(Camera* camera, SoundSystem* soundSystem, ParticleSystem* particleSystem)
 {
 	this->camera = camera;
@@ -21,11 +25,11 @@ void SpawnManager::setTutorialMode(bool mode) {
 	isTutorialModeOn = mode;
 }
 
-vec2 SpawnManager::get_spawn_location(const std::string& entity_type, bool initial)
+vec2 SpawnManager::get_spawn_location(SPAWN_TYPE entity_type, bool initial)
 {
     vec2 spawn_location{};
     // spawn collectibles
-    if (entity_type == "heart" || entity_type == "collectible_trap") {
+    if (entity_type == SPAWN_TYPE::HEART || entity_type == SPAWN_TYPE::COLLECTIBLE_TRAP) {
         // spawn at random location on the map
         float posX = uniform_dist(rng) * (rightBound - leftBound) + leftBound;
         float posY = uniform_dist(rng) * (bottomBound - topBound) + topBound;
@@ -81,13 +85,13 @@ void SpawnManager::initialSpawn(float elapsed_ms) {
     int maxEntitySize = 1;
 
     for (int i = 0; i < currentEnemyIdx; i++) {
-        std::string entity_type = entity_types[i];
+        SPAWN_TYPE entity_type = entity_types[i];
         int currentEntitySize = registry.spawnable_lists.at(entity_type)->size();
         if (currentEntitySize < maxEntitySize) {
             vec2 spawn_location = get_spawn_location(entity_type, isTutorialModeOn);
             spawn_func f = spawn_functions.at(entity_type);
-            (*f)(spawn_location);
-            std::cout << "Spawning " + entity_type << std::endl;
+            (*f)(spawn_location, registry);
+            std::cout << "Spawning " << enum_name(entity_type) << std::endl;
         }
     }
 
@@ -96,10 +100,10 @@ void SpawnManager::initialSpawn(float elapsed_ms) {
     // spawn new enemy
     if (initialSpawnTime <= 0) {
         // spawn current enemy
-		std::string entity_type = entity_types[currentEnemyIdx];
+		SPAWN_TYPE entity_type = entity_types[currentEnemyIdx];
 		vec2 spawn_location = get_spawn_location(entity_type, true);
 		spawn_func f = spawn_functions.at(entity_type);
-		(*f)(spawn_location);
+		(*f)(spawn_location, registry);
 		currentEnemyIdx++;
 		initialSpawnTime = initialSpawnInterval;
         soundSystem->playSoundEffect(Sound::LEVELUP, 0);
@@ -116,7 +120,7 @@ void SpawnManager::inGameSpawn(float elapsed_ms) {
 
 void SpawnManager::spawnEnemies(float elapsed_ms) {
     for (int i = 0; i < entity_types.size(); i++) {
-        std::string entity_type = entity_types[i];
+        SPAWN_TYPE entity_type = entity_types[i];
 
 		next_spawn.at(entity_type) -= elapsed_ms;
 
@@ -128,7 +132,7 @@ void SpawnManager::spawnEnemies(float elapsed_ms) {
             spawn_func f = spawn_functions.at(entity_type);
             for (int j = 0; j < num_to_spawn; j++) {
                 vec2 spawn_location = get_spawn_location(entity_type, false);
-                (*f)(spawn_location);
+                (*f)(spawn_location, registry);
             }
 
 			next_spawn.at(entity_type) = spawn_delays.at(entity_type);
@@ -138,17 +142,17 @@ void SpawnManager::spawnEnemies(float elapsed_ms) {
 
 void SpawnManager::spawnCollectibles(float elapsed_ms) {
 	// collectible
-	spawnCollectible("collectible_trap", elapsed_ms); // collectible_trap
+	spawnCollectible(SPAWN_TYPE::COLLECTIBLE_TRAP, elapsed_ms); // collectible_trap
     // heart
-	spawnCollectible("heart", elapsed_ms); // heart
+	spawnCollectible(SPAWN_TYPE::HEART, elapsed_ms); // heart
 }
 
-void SpawnManager::spawnCollectible(std::string collectible, float elapsed_ms) {
+void SpawnManager::spawnCollectible(SPAWN_TYPE collectible, float elapsed_ms) {
     next_spawn.at(collectible) -= elapsed_ms;
     if (next_spawn.at(collectible) <= 0) {
         vec2 trap_spawn_location = get_spawn_location(collectible, false);
         spawn_func f = spawn_functions.at(collectible);
-        (*f)(trap_spawn_location);
+        (*f)(trap_spawn_location, registry);
         next_spawn.at(collectible) = spawn_delays.at(collectible);
     }
 }
@@ -157,12 +161,14 @@ void SpawnManager::spawnParticles(float elapsed_ms)
 {
     Entity& player = registry.players.entities[0];
     Motion& playerMotion = registry.motions.get(player);
+    Shape& playerShape = registry.shapes.get(player);
+    Presentation& playerPresentation = registry.presentations.get(player);
 
     // SPAWN SMOKE ------------------------------------------------
     vec3 position = playerMotion.position;
-    float direction = (playerMotion.scale.x > 0) ? 1.f : -1.f;
-    position.x += direction * playerMotion.hitbox.x / 2;
-    position.z += playerMotion.hitbox.z / 3;
+    float direction = (playerPresentation.scale.x > 0) ? 1.f : -1.f;
+    position.x += direction * playerShape.hitbox.x / 2;
+    position.z += playerShape.hitbox.z / 3;
     vec2 size = { 20, 20 };
 	particleSystem->createSmokeParticle(position, size);
     particleSystem->createSmokeParticle(position, size);
@@ -170,7 +176,7 @@ void SpawnManager::spawnParticles(float elapsed_ms)
 
     for (Entity fireball : registry.damagings.entities) {
         Damaging& damaging = registry.damagings.get(fireball);
-        if (damaging.type != "fireball") {
+        if (damaging.type != DAMAGING_TYPE::FIREBALL) {
             continue;
         }
         vec3 position = registry.motions.get(fireball).position;
@@ -183,7 +189,7 @@ void SpawnManager::spawnParticles(float elapsed_ms)
 
     // SPAWN DASH SPRITES ------------------------------------------------
     if (registry.dashers.get(player).isDashing) {
-        float facing = playerMotion.scale.x > 0 ? 1 : -1;
+        float facing = playerPresentation.scale.x > 0 ? 1 : -1;
         particleSystem->createDashParticle(playerMotion.position, vec2(JEFF_BB_WIDTH * facing, JEFF_BB_HEIGHT));
     }
 }
@@ -194,12 +200,12 @@ void SpawnManager::despawnCollectibles(float elapsed_ms) {
         collectible.timer += elapsed_ms;
 
         if (collectible.timer >= collectible.duration) {
-            registry.remove_all_components_of(collectibleEntity);
+            registry.defer_destroy(collectibleEntity);
         }
         else if (collectible.timer >= collectible.duration / 2) {
             AnimationController& animatedCollectible = registry.animationControllers.get(collectibleEntity);
             if (animatedCollectible.currentState != AnimationState::Fading) {
-                animatedCollectible.changeState(collectibleEntity, AnimationState::Fading);
+                animatedCollectible.changeState(collectibleEntity, AnimationState::Fading, registry);
             }
         }
     }
@@ -210,7 +216,7 @@ void SpawnManager::despawnTraps(float elapsed_ms) {
         Trap& trap = registry.traps.get(trapE);
         trap.duration -= elapsed_ms;
         if (trap.duration <= 0) {
-            registry.remove_all_components_of(trapE);
+            registry.defer_destroy(trapE);
         }
     }
 
@@ -218,7 +224,7 @@ void SpawnManager::despawnTraps(float elapsed_ms) {
         PhantomTrap& trap = registry.phantomTraps.get(trapE);
         trap.duration -= elapsed_ms;
         if (trap.duration <= 0) {
-            registry.remove_all_components_of(trapE);
+            registry.defer_destroy(trapE);
         }
     }
 }
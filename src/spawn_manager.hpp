@@ -11,6 +11,7 @@
 class SpawnManager
 {
 public:
+	SpawnManager(ECSRegistry& registry);
 	void init(Camera* camera, SoundSystem* soundSystem, ParticleSystem* particleSystem);
 
 	void step(float elapsed_ms);
@@ -20,6 +21,7 @@ public:
 	void setTutorialMode(bool mode);
 
 private:
+	ECSRegistry& registry;
 	Camera* camera;
 	SoundSystem* soundSystem;
 	ParticleSystem* particleSystem;
@@ -33,105 +35,105 @@ private:
 	float difficultyTime = 10000.f;
 
 	// Constants
-	std::vector<std::string> entity_types = {
-		"bird",
-		"boar",
-		"barbarian",
-		"archer",
-		"wizard",
-		"troll",
-		"bomber",
-		"heart", // collectible
-		"collectible_trap" // collectible
+	std::vector<SPAWN_TYPE> entity_types = {
+		SPAWN_TYPE::BIRD,
+		SPAWN_TYPE::BOAR,
+		SPAWN_TYPE::BARBARIAN,
+		SPAWN_TYPE::ARCHER,
+		SPAWN_TYPE::WIZARD,
+		SPAWN_TYPE::TROLL,
+		SPAWN_TYPE::BOMBER,
+		SPAWN_TYPE::HEART, // collectible
+		SPAWN_TYPE::COLLECTIBLE_TRAP // collectible
 	};
 
-	const std::unordered_map<std::string, float> spawn_delays_og = {
-		{"boar", 30000.0},
-		{"barbarian", 40000.0f},
-		{"archer", 50000.0f},
-		{"bird", 20000.0f},
-		{"wizard", 60000.0f},
-		{"troll", 70000.0f},
-		{"bomber", 90000.0f},
-		{"heart", 10000.0f},
-		{"collectible_trap", 10000.0f}
+	const std::unordered_map<SPAWN_TYPE, float> spawn_delays_og = {
+		{SPAWN_TYPE::BOAR, 30000.0},
+		{SPAWN_TYPE::BARBARIAN, 40000.0f},
+		{SPAWN_TYPE::ARCHER, 50000.0f},
+		{SPAWN_TYPE::BIRD, 20000.0f},
+		{SPAWN_TYPE::WIZARD, 60000.0f},
+		{SPAWN_TYPE::TROLL, 70000.0f},
+		{SPAWN_TYPE::BOMBER, 90000.0f},
+		{SPAWN_TYPE::HEART, 10000.0f},
+		{SPAWN_TYPE::COLLECTIBLE_TRAP, 10000.0f}
 	};
 
-	std::unordered_map<std::string, float> spawn_delays = {
-		{"boar", 30000.0},
-		{"barbarian", 40000.0f},
-		{"archer", 50000.0f},
-		{"bird", 20000.0f},
-		{"wizard", 60000.0f},
-		{"troll", 70000.0f},
-		{"bomber", 90000.0f},
-		{"heart", 10000.0f},
-		{"collectible_trap", 10000.0f}
+	std::unordered_map<SPAWN_TYPE, float> spawn_delays = {
+		{SPAWN_TYPE::BOAR, 30000.0},
+		{SPAWN_TYPE::BARBARIAN, 40000.0f},
+		{SPAWN_TYPE::ARCHER, 50000.0f},
+		{SPAWN_TYPE::BIRD, 20000.0f},
+		{SPAWN_TYPE::WIZARD, 60000.0f},
+		{SPAWN_TYPE::TROLL, 70000.0f},
+		{SPAWN_TYPE::BOMBER, 90000.0f},
+		{SPAWN_TYPE::HEART, 10000.0f},
+		{SPAWN_TYPE::COLLECTIBLE_TRAP, 10000.0f}
 	};
 
-	std::unordered_map<std::string, float> next_spawn = {
-		{"boar", 30000.0},
-		{"barbarian", 40000.0f},
-		{"archer", 50000.0f},
-		{"bird", 20000.0f},
-		{"wizard", 60000.0f},
-		{"troll", 70000.0f},
-		{"bomber", 90000.0f},
-		{"heart", 10000.0f},
-		{"collectible_trap", 10000.0f}
+	std::unordered_map<SPAWN_TYPE, float> next_spawn = {
+		{SPAWN_TYPE::BOAR, 30000.0},
+		{SPAWN_TYPE::BARBARIAN, 40000.0f},
+		{SPAWN_TYPE::ARCHER, 50000.0f},
+		{SPAWN_TYPE::BIRD, 20000.0f},
+		{SPAWN_TYPE::WIZARD, 60000.0f},
+		{SPAWN_TYPE::TROLL, 70000.0f},
+		{SPAWN_TYPE::BOMBER, 90000.0f},
+		{SPAWN_TYPE::HEART, 10000.0f},
+		{SPAWN_TYPE::COLLECTIBLE_TRAP, 10000.0f}
 	};
 
 	// By how many entities to increase at spawn delay
-	const std::unordered_map<std::string, int> spawn_size = {
-		{"boar", 2},
-		{"barbarian", 2},
-		{"archer", 1},
-		{"bird", 2},
-		{"wizard", 1},
-		{"troll", 1},
-		{"bomber", 1},
-		{"heart", 2},
-		{"collectible_trap", 2}
+	const std::unordered_map<SPAWN_TYPE, int> spawn_size = {
+		{SPAWN_TYPE::BOAR, 2},
+		{SPAWN_TYPE::BARBARIAN, 2},
+		{SPAWN_TYPE::ARCHER, 1},
+		{SPAWN_TYPE::BIRD, 2},
+		{SPAWN_TYPE::WIZARD, 1},
+		{SPAWN_TYPE::TROLL, 1},
+		{SPAWN_TYPE::BOMBER, 1},
+		{SPAWN_TYPE::HEART, 2},
+		{SPAWN_TYPE::COLLECTIBLE_TRAP, 2}
 	};
 
-	const std::unordered_map<std::string, int> max_entities_og = {
-		{"boar", 5},
-		{"barbarian", 4},
-		{"archer", 3},
-		{"bird", 8},
-		{"wizard", 4},
-		{"troll", 5},
-		{"bomber", 3},
-		{"heart", 2},
-		{"collectible_trap", 2}
+	const std::unordered_map<SPAWN_TYPE, int> max_entities_og = {
+		{SPAWN_TYPE::BOAR, 5},
+		{SPAWN_TYPE::BARBARIAN, 4},
+		{SPAWN_TYPE::ARCHER, 3},
+		{SPAWN_TYPE::BIRD, 8},
+		{SPAWN_TYPE::WIZARD, 4},
+		{SPAWN_TYPE::TROLL, 5},
+		{SPAWN_TYPE::BOMBER, 3},
+		{SPAWN_TYPE::HEART, 2},
+		{SPAWN_TYPE::COLLECTIBLE_TRAP, 2}
 	};
 
-	std::unordered_map<std::string, int> max_entities = {
-		{"boar", 5},
-		{"barbarian", 4},
-		{"archer", 3},
-		{"bird", 8},
-		{"wizard", 4},
-		{"troll", 5},
-		{"bomber", 3},
-		{"heart", 2},
-		{"collectible_trap", 2}
+	std::unordered_map<SPAWN_TYPE, int> max_entities = {
+		{SPAWN_TYPE::BOAR, 5},
+		{SPAWN_TYPE::BARBARIAN, 4},
+		{SPAWN_TYPE::ARCHER, 3},
+		{SPAWN_TYPE::BIRD, 8},
+		{SPAWN_TYPE::WIZARD, 4},
+		{SPAWN_TYPE::TROLL, 5},
+		{SPAWN_TYPE::BOMBER, 3},
+		{SPAWN_TYPE::HEART, 2},
+		{SPAWN_TYPE::COLLECTIBLE_TRAP, 2}
 	};
 
-	using spawn_func = Entity(*)(vec2);
-	const std::unordered_map<std::string, spawn_func> spawn_functions = {
-		{"boar", createBoar},
-		{"barbarian", createBarbarian},
-		{"archer", createArcher},
-		{"bird", createBird},
-		{"wizard", createWizard},
-		{"troll", createTroll},
-		{"bomber", createBomber},
-		{"heart", createHeart},
-		{"collectible_trap", createCollectibleTrap}
+	using spawn_func = Entity(*)(vec2, ECSRegistry&);
+	const std::unordered_map<SPAWN_TYPE, spawn_func> spawn_functions = {
+		{SPAWN_TYPE::BOAR, createBoar},
+		{SPAWN_TYPE::BARBARIAN, createBarbarian},
+		{SPAWN_TYPE::ARCHER, createArcher},
+		{SPAWN_TYPE::BIRD, createBird},
+		{SPAWN_TYPE::WIZARD, createWizard},
+		{SPAWN_TYPE::TROLL, createTroll},
+		{SPAWN_TYPE::BOMBER, createBomber},
+		{SPAWN_TYPE::HEART, createHeart},
+		{SPAWN_TYPE::COLLECTIBLE_TRAP, createCollectibleTrap}
 	};
 
-	vec2 get_spawn_location(const std::string& entity_type, bool initial);
+	vec2 get_spawn_location(SPAWN_TYPE entity_type, bool initial);
 	bool hasAllEnemiesSpawned();
 
 	void initialSpawn(float elapsed_ms);
@@ -139,7 +141,7 @@ private:
 
 	void spawnEnemies(float elapsed_ms);
 	void spawnCollectibles(float elapsed_ms);
-	void spawnCollectible(std::string collectible, float elapsed_ms);
+	void spawnCollectible(SPAWN_TYPE collectible, float elapsed_ms);
 	void spawnParticles(float elapsed_ms);
 
 	void despawnCollectibles(float elapsed_ms);
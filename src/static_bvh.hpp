@@ -0,0 +1,121 @@
+#pragma once
+
+// stdlib
+#include <algorithm>
+#include <assert.h>
+#include <stdint.h>
+#include <vector>
+
+// glm
+#include <glm/glm.hpp>
+
+// Bounding volume hierarchy over boxes on the ground plane that never move (obstacles, trees, cliffs, map tiles).
+// It is built once from all boxes and then only queried: a query walks the tree down to the leaves whose bounds
+// overlap the query box, so a moving body only meets the few static ones near it.
+class StaticBVH
+{
+public:
+	struct Item
+	{
+		glm::vec2 min;
+		glm::vec2 max;
+		uint32_t id; // handed back by query()
+	};
+
+	// Replaces the hierarchy with one over 'boxes', splitting at the median of the longest axis
+	void build(const std::vector<Item>& boxes)
+	{
+		items = boxes;
+		nodes.clear();
+		if (!items.empty())
+			build_node(0, (uint32_t)items.size());
+	}
+
+	// Calls f(id) for every item whose box overlaps [min, max] (borders touching counts)
+	template <typename Function>
+	void query(glm::vec2 min, glm::vec2 max, Function f) const
+	{
+		if (nodes.empty())
+			return;
+		uint32_t stack[MAX_DEPTH];
+		uint32_t top = 0;
+		stack[top++] = 0;
+		while (top > 0) {
+			uint32_t n = stack[--top];
+			const Node& node = nodes[n];
+			if (!overlaps(node.min, node.max, min, max))
+				continue;
+			if (node.count > 0) {
+				for (uint32_t i = node.first; i < node.first + node.count; i++)
+					if (overlaps(items[i].min, items[i].max, min, max))
+						f(items[i].id);
+			}
+			else {
+				assert(top + 2 <= MAX_DEPTH && "Static BVH deeper than its query stack");
+				stack[top++] = node.first;
+				stack[top++] = n + 1;
+			}
+		}
+	}
+
+	size_t size() const { return items.size(); }
+
+	void clear()
+	{
+		items.clear();
+		nodes.clear();
+	}
+
+private:
+	enum : uint32_t {
+		LEAF_SIZE = 4,
+		MAX_DEPTH = 64
+	};
+
+	// Inner nodes have count 0, their left child follows them and 'first' is the right child.
+	// Leaves list items [first, first + count).
+	struct Node
+	{
+		glm::vec2 min;
+		glm::vec2 max;
+		uint32_t first;
+		uint32_t count;
+	};
+
+	static bool overlaps(glm::vec2 min_a, glm::vec2 max_a, glm::vec2 min_b, glm::vec2 max_b)
+	{
+		return min_a.x <= max_b.x && min_b.x <= max_a.x && min_a.y <= max_b.y && min_b.y <= max_a.y;
+	}
+
+	uint32_t build_node(uint32_t first, uint32_t count)
+	{
+		uint32_t n = (uint32_t)nodes.size();
+		nodes.emplace_back();
+		glm::vec2 min = items[first].min;
+		glm::vec2 max = items[first].max;
+		for (uint32_t i = first + 1; i < first + count; i++) {
+			min = glm::min(min, items[i].min);
+			max = glm::max(max, items[i].max);
+		}
+		nodes[n].min = min;
+		nodes[n].max = max;
+		if (count <= LEAF_SIZE) {
+			nodes[n].first = first;
+			nodes[n].count = count;
+			return n;
+		}
+
+		int axis = max.x - min.x >= max.y - min.y ? 0 : 1;
+		uint32_t half = count / 2;
+		std::nth_element(items.begin() + first, items.begin() + first + half, items.begin() + first + count,
+			[axis](const Item& a, const Item& b) { return a.min[axis] + a.max[axis] < b.min[axis] + b.max[axis]; });
+		build_node(first, half);
+		uint32_t right = build_node(first + half, count - half);
+		nodes[n].first = right;
+		nodes[n].count = 0;
+		return n;
+	}
+
+	std::vector<Item> items;
+	std::vector<Node> nodes;
+};
@@ -5,5 +5,192 @@
 // internal
 #include "tiny_ecs.hpp"
 
-// All we need to store besides the containers is the id of every entity and callbacks to be able to remove entities across containers
-unsigned int Entity::id_count = 1;
\ No newline at end of file
+// stdlib
+#include <atomic>
+#include <mutex>
+
+thread_local std::vector<ContainerInterface*>* ContainerInterface::declared_containers = nullptr;
+
+// All we need to store besides the containers is the id of every entity and callbacks to be able to remove entities
+// across containers.
+//
+// Ids are handed out by one shared pool and a cache per thread. A thread takes INDEX_BLOCK fresh indices from the
+// pool at once under the lock and then creates entities from its block without synchronisation, so worker threads
+// can create entities without contending. Released indices go onto the free list of the releasing thread (the one
+// that owns the registry, in practice the main thread), which reuses them without locking. Once that list holds
+// more than the thread keeps for itself, its oldest indices go back to the pool in blocks, where every thread's
+// refill takes them before cutting fresh ones. Entities made by workers and destroyed by the main thread are thus
+// recycled too. A thread that exits gives its unused indices back to the pool.
+namespace
+{
+	const unsigned int INDEX_BLOCK = 256;
+	const unsigned int PAGE_BITS = 12;
+	const unsigned int PAGE_SIZE = 1u << PAGE_BITS;
+	const unsigned int PAGE_COUNT = (Entity::INDEX_MASK >> PAGE_BITS) + 1;
+
+	// Released indices in release order, a ring that only allocates when it outgrows its capacity
+	class IndexQueue
+	{
+	public:
+		size_t size() const { return count; }
+
+		void push_back(unsigned int index)
+		{
+			if (count == ring.size())
+				grow();
+			ring[(head + count) & (ring.size() - 1)] = index;
+			count++;
+		}
+
+		unsigned int pop_front()
+		{
+			unsigned int index = ring[head];
+			head = (head + 1) & (ring.size() - 1);
+			count--;
+			return index;
+		}
+
+	private:
+		void grow()
+		{
+			std::vector<unsigned int> larger(std::max<size_t>(2 * ring.size(), 2048));
+			for (size_t i = 0; i < count; i++)
+				larger[i] = ring[(head + i) & (ring.size() - 1)];
+			ring.swap(larger);
+			head = 0;
+		}
+
+		std::vector<unsigned int> ring; // capacity is a power of two
+		size_t head = 0;
+		size_t count = 0;
+	};
+
+	// State shared by all threads. Generations live in fixed pages so the table never moves while other threads read
+	// it, pages are added under the lock and published through the atomic page pointers.
+	struct IndexPool
+	{
+		std::mutex lock;
+		std::atomic<unsigned int> reserved{ 1 };             // next never used index, entity 0 is the default initialization
+		std::atomic<unsigned int*> pages[PAGE_COUNT] = {};
+		std::vector<unsigned int> returned;                  // indices given back by other threads, reused first
+
+		~IndexPool()
+		{
+			for (auto& page : pages)
+				delete[] page.load();
+		}
+	};
+
+	// Function static so entities constructed during static initialization (e.g. members of the global registry) are safe
+	IndexPool& pool()
+	{
+		static IndexPool shared;
+		return shared;
+	}
+
+	unsigned int& generation_of(unsigned int index)
+	{
+		return pool().pages[index >> PAGE_BITS].load(std::memory_order_acquire)[index & (PAGE_SIZE - 1)];
+	}
+
+	struct ThreadIndices
+	{
+		unsigned int next = 0; // [next, end) is the fresh block of this thread
+		unsigned int end = 0;
+		std::vector<unsigned int> spare; // taken over from exited threads, used like fresh ones
+		IndexQueue free;
+
+		~ThreadIndices()
+		{
+			IndexPool& shared = pool();
+			std::lock_guard<std::mutex> guard(shared.lock);
+			for (; next < end; next++)
+				shared.returned.push_back(next);
+			shared.returned.insert(shared.returned.end(), spare.begin(), spare.end());
+			while (free.size() > 0)
+				shared.returned.push_back(free.pop_front());
+		}
+
+		// Hands the 'count' oldest released indices to the pool for the other threads
+		void give_back(size_t count)
+		{
+			IndexPool& shared = pool();
+			std::lock_guard<std::mutex> guard(shared.lock);
+			for (size_t i = 0; i < count; i++)
+				shared.returned.push_back(free.pop_front());
+		}
+
+		// Takes the next block from the pool, indices returned by other threads before fresh ones
+		void refill()
+		{
+			IndexPool& shared = pool();
+			std::lock_guard<std::mutex> guard(shared.lock);
+			if (!shared.returned.empty()) {
+				size_t take = std::min<size_t>(shared.returned.size(), INDEX_BLOCK);
+				spare.assign(shared.returned.end() - take, shared.returned.end());
+				shared.returned.resize(shared.returned.size() - take);
+				return;
+			}
+
+			unsigned int first = shared.reserved.load(std::memory_order_relaxed);
+			assert(first + INDEX_BLOCK - 1 <= Entity::INDEX_MASK && "Ran out of entity indices");
+			for (unsigned int p = first >> PAGE_BITS; p <= (first + INDEX_BLOCK - 1) >> PAGE_BITS; p++)
+				if (!shared.pages[p].load(std::memory_order_relaxed))
+					shared.pages[p].store(new unsigned int[PAGE_SIZE](), std::memory_order_release);
+			next = first;
+			end = first + INDEX_BLOCK;
+			shared.reserved.store(end, std::memory_order_release);
+		}
+	};
+
+	ThreadIndices& thread_indices()
+	{
+		static thread_local ThreadIndices indices;
+		return indices;
+	}
+}
+
+Entity Entity::create()
+{
+	ThreadIndices& local = thread_indices();
+	unsigned int index;
+	if (local.free.size() > MIN_FREE_INDICES) {
+		// oldest released index first, its generation was bumped on release
+		index = local.free.pop_front();
+	}
+	else {
+		if (local.spare.empty() && local.next == local.end)
+			local.refill();
+		if (!local.spare.empty()) {
+			index = local.spare.back();
+			local.spare.pop_back();
+		}
+		else
+			index = local.next++;
+	}
+	return Entity((generation_of(index) << INDEX_BITS) | index, NoAllocation());
+}
+
+bool Entity::isAlive(Entity e)
+{
+	unsigned int index = e.index();
+	return index != 0 && index < pool().reserved.load(std::memory_order_acquire) && generation_of(index) == e.generation();
+}
+
+void Entity::release(Entity e)
+{
+	if (!isAlive(e))
+		return;
+	unsigned int index = e.index();
+	generation_of(index) = (generation_of(index) + 1) & GENERATION_MASK;
+	ThreadIndices& local = thread_indices();
+	local.free.push_back(index);
+	// beyond what this thread keeps for reuse, the oldest go to the pool a block at a time
+	if (local.free.size() >= MIN_FREE_INDICES + INDEX_BLOCK)
+		local.give_back(INDEX_BLOCK);
+}
+
+Entity Entity::at_index(unsigned int index)
+{
+	return Entity((generation_of(index) << INDEX_BITS) | index, NoAllocation());
+}
@@ -5,48 +5,255 @@
 #pragma once
 
 #include <algorithm>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <unordered_map>
 #include <set>
 #include <functional>
 #include <typeindex>
 #include <assert.h>
+#include <stdint.h>
 #include <glm/glm.hpp>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 
 
 
+// Index of the lowest set bit, mask must not be 0
+inline unsigned int lowest_set_bit(uint64_t mask)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward64(&index, mask);
+	return (unsigned int)index;
+#else
+	return (unsigned int)__builtin_ctzll(mask);
+#endif
+}
+
+// Branch hint for conditions that almost always hold
+#ifdef _MSC_VER
+#define ECS_LIKELY(condition) (condition)
+#else
+#define ECS_LIKELY(condition) __builtin_expect(!!(condition), 1)
+#endif
+
 // Unique identifyer for all entities
+// The 32-bit id packs a slot index (low INDEX_BITS) and a generation (high bits). Destroyed entities give their index
+// back through release(), it is reused later with a bumped generation so stale handles never alias the new entity.
+// Entities can be created on any thread, each thread draws indices from a block of its own (see tiny_ecs.cpp).
+// release() belongs to the thread that owns the entity's registry, isAlive() is safe anywhere but only meaningful
+// for entities no other thread is releasing at the same time.
 class Entity
 {
 	unsigned int id;
-	static unsigned int id_count; // starts from 1, entit 0 is the default initialization
 public:
-	Entity()
-	{
-		id = id_count++;
-		// Note, indices of already deleted entities arent re-used in this simple implementation.
-	}
+	static const unsigned int INDEX_BITS = 20;
+	static const unsigned int INDEX_MASK = (1u << INDEX_BITS) - 1;
+	static const unsigned int GENERATION_MASK = (1u << (32 - INDEX_BITS)) - 1;
+	// released indices are only reused once this many are waiting on the releasing thread, so a slot's generation
+	// wraps around very slowly
+	static const unsigned int MIN_FREE_INDICES = 1024;
+
+	// The null handle: refers to no entity, is never alive and allocates nothing. Members and locals that are
+	// assigned later start out as this.
+	Entity() : id(0) {}
+	// A new entity with an index of its own, destroy it through the registry so the index is released again
+	static Entity create();
 	operator unsigned int() { return id; } // this enables automatic casting to int
 	unsigned int getId() const { return id; } //gets ID
+	unsigned int index() const { return id & INDEX_MASK; }
+	unsigned int generation() const { return id >> INDEX_BITS; }
+
+	// True until the entity is released, false for stale handles whose index has been handed out again
+	static bool isAlive(Entity e);
+	// Give the index of e back for reuse, releasing an entity that is already dead does nothing
+	static void release(Entity e);
+	// Handle of the entity currently using 'index', only meaningful while that entity is alive
+	static Entity at_index(unsigned int index);
+
+private:
+	struct NoAllocation {};
+	Entity(unsigned int id, NoAllocation) : id(id) {}
+};
+
+class Query;
+
+// Memory held by a container, see ECSRegistry::list_all_components. Storage is counted by capacity, not size.
+struct ContainerMemory
+{
+	size_t count = 0;           // stored components
+	size_t capacity = 0;        // components that fit before the dense storage grows
+	size_t component_bytes = 0; // dense storage: components, entity list and versions
+	size_t index_bytes = 0;     // lookup from entity to component: sparse pages, bitset or locations
+	size_t heap_bytes = 0;      // owned by the components themselves, see ComponentHeapBytes
+
+	size_t total() const { return component_bytes + index_bytes + heap_bytes; }
+
+	ContainerMemory& operator+=(const ContainerMemory& other) {
+		count += other.count;
+		capacity += other.capacity;
+		component_bytes += other.component_bytes;
+		index_bytes += other.index_bytes;
+		heap_bytes += other.heap_bytes;
+		return *this;
+	}
+};
+
+// Heap memory a component owns beyond sizeof(Component), specialize next to components holding strings or containers
+template <typename Component>
+struct ComponentHeapBytes
+{
+	static size_t of(const Component&) { return 0; }
 };
 
 // Common interface to refer to all containers in the ECS registry
 struct ContainerInterface
 {
+	ContainerInterface()
+	{
+		if (declared_containers)
+			declared_containers->push_back(this);
+	}
+
 	virtual void clear() = 0;
-	virtual size_t size() = 0;
+	virtual size_t size() const = 0;
 	virtual void remove(Entity e) = 0;
-	virtual bool has(Entity entity) = 0;
+	virtual bool has(Entity entity) const = 0;
+	virtual ContainerMemory memory() const = 0;
+
+	// Per-entity component signatures of the owning registry (indexed by Entity::index()) and this container's bit in them.
+	// Left unset for containers that live outside a registry.
+	std::vector<uint64_t>* signatures = nullptr;
+	uint64_t signature_bit = 0;
+
+	// Frame counter of the owning registry, stamped into the version of every component that is added or patched
+	const uint32_t* frame = nullptr;
+	uint32_t current_frame() const { return frame ? *frame : 0; }
+
+	// Queries that have to re-check entities whenever this container gains or loses one
+	std::vector<Query*> queries;
+
+	// While a registry constructs its members, every container created is collected here so it can check ECS_CONTAINERS
+	// Per thread so registries can be constructed on several threads at once
+	static thread_local std::vector<ContainerInterface*>* declared_containers;
+
+protected:
+	// Called by the containers after e was added or removed: keeps the signature of e and the watching queries in sync
+	void mark(Entity e, bool present);
+};
+
+// Opt a component type into lifecycle callbacks by specializing this to std::true_type next to the component, e.g.
+//   template <> struct ObservedComponent<Motion> : std::true_type {};
+// Containers of types that are not opted in compile the notifications away.
+template <typename Component>
+struct ObservedComponent : std::false_type {};
+
+// Callbacks for an observed component type, a base of its ComponentContainer
+template <typename Component, bool Enabled = ObservedComponent<Component>::value>
+class ComponentObservers
+{
+public:
+	using Callback = std::function<void(Entity, Component&)>;
+
+	std::vector<Callback> on_add;    // after the component was inserted
+	std::vector<Callback> on_remove; // before the component is removed (also on clear)
+	std::vector<Callback> on_change; // after the component was modified through patch()
+
+protected:
+	void notify_add(Entity e, Component& c) { for (Callback& f : on_add) f(e, c); }
+	void notify_remove(Entity e, Component& c) { for (Callback& f : on_remove) f(e, c); }
+	void notify_change(Entity e, Component& c) { for (Callback& f : on_change) f(e, c); }
+};
+
+// Unobserved types: no callback lists, the calls are empty and inline away
+template <typename Component>
+class ComponentObservers<Component, false>
+{
+protected:
+	void notify_add(Entity, Component&) {}
+	void notify_remove(Entity, Component&) {}
+	void notify_change(Entity, Component&) {}
 };
 
 // A container that stores components of type 'Component' and associated entities
-template <typename Component> // A component can be any class
-class ComponentContainer : public ContainerInterface
+// Storage is a sparse set: a paged sparse array maps Entity -> index into the packed (dense) components/entities
+// vectors, so has() and get() are a single indexed load instead of a hash lookup.
+// Empty components (tags) get the bitset specialization below
+template <typename Component, bool IsTag = std::is_empty<Component>::value> // A component can be any class
+class ComponentContainer final : public ContainerInterface, public ComponentObservers<Component>
 {
 private:
-	// The hash map from Entity -> array index.
-	std::unordered_map<unsigned int, unsigned int> map_entity_componentID; // the entity is cast to uint to be hashable.
-	bool registered = false;
+	// Sparse index is split into fixed-size pages that are only allocated once an entity in their range is inserted
+	enum : unsigned int {
+		PAGE_BITS = 12,
+		PAGE_SIZE = 1u << PAGE_BITS,
+		PAGE_MASK = PAGE_SIZE - 1,
+		INVALID_INDEX = 0xFFFFFFFFu
+	};
+
+	// The sparse pages from Entity -> array index, INVALID_INDEX marks an absent entity
+	std::vector<std::unique_ptr<unsigned int[]>> sparse_pages;
+
+	// Frame in which each component was last added or patched, parallel to components
+	std::vector<uint32_t> versions;
+
+	// Set by keep_sorted(), the order the dense arrays are kept in. Empty for unordered containers.
+	std::function<bool(Entity, Entity)> ordering;
+
+	// Reused by sort() so sorting does not allocate once the container has reached its size
+	std::vector<unsigned int> sort_order;
+
+	// Exchange two dense entries, keeping the sparse index valid so get() works in the middle of a sort
+	void swap_entries(unsigned int i, unsigned int j)
+	{
+		std::swap(components[i], components[j]);
+		std::swap(entities[i], entities[j]);
+		std::swap(versions[i], versions[j]);
+		slot(entities[i].index()) = i;
+		slot(entities[j].index()) = j;
+	}
+
+	// Insertion step: moves entry i towards the front until its predecessor is not ordered after it
+	void sift_down(unsigned int i)
+	{
+		for (; i > 0 && ordering(entities[i], entities[i - 1]); i--)
+			swap_entries(i - 1, i);
+	}
+
+	unsigned int* find_slot(unsigned int index) const
+	{
+		unsigned int page = index >> PAGE_BITS;
+		if (page >= sparse_pages.size() || !sparse_pages[page])
+			return nullptr;
+		return &sparse_pages[page][index & PAGE_MASK];
+	}
+
+	unsigned int& slot(unsigned int index)
+	{
+		unsigned int page = index >> PAGE_BITS;
+		if (page >= sparse_pages.size())
+			sparse_pages.resize(page + 1);
+		if (!sparse_pages[page])
+		{
+			sparse_pages[page].reset(new unsigned int[PAGE_SIZE]);
+			std::fill(sparse_pages[page].get(), sparse_pages[page].get() + PAGE_SIZE, (unsigned int)INVALID_INDEX);
+		}
+		return sparse_pages[page][index & PAGE_MASK];
+	}
+
+	// The slot is keyed by the entity index, the stored entity tells apart generations that share it
+	unsigned int index_of(Entity e) const
+	{
+		const unsigned int* s = find_slot(e.index());
+		if (!s || *s == INVALID_INDEX || entities[*s].getId() != e.getId())
+			return INVALID_INDEX;
+		return *s;
+	}
 public:
 	// Container of all components of type 'Component'
 	std::vector<Component> components;
@@ -64,11 +271,18 @@ public:
 	{
 		// Usually, every entity should only have one instance of each component type
 		assert(!(check_for_duplicates && has(e)) && "Entity already contained in ECS registry");
+		assert(Entity::isAlive(e) && "Entity was already destroyed");
 
-		map_entity_componentID[e] = (unsigned int)components.size();
+		slot(e.index()) = (unsigned int)components.size();
 		components.push_back(std::move(c)); // the move enforces move instead of copy constructor
 		entities.push_back(e);
-		return components.back();
+		versions.push_back(current_frame());
+		if (ordering)
+			sift_down((unsigned int)components.size() - 1);
+		Component& inserted = components[index_of(e)];
+		mark(e, true);
+		this->notify_add(e, inserted);
+		return inserted;
 	};
 
 	// The emplace function takes the the provided arguments Args, creates a new object of type Component, and inserts it into the ECS system
@@ -84,62 +298,752 @@ public:
 	// A wrapper to return the component of an entity
 	Component& get(Entity e) {
 		assert(has(e) && "Entity not contained in ECS registry");
-		return components[map_entity_componentID[e]];
+		return components[index_of(e)];
+	}
+	const Component& get(Entity e) const {
+		assert(has(e) && "Entity not contained in ECS registry");
+		return components[index_of(e)];
+	}
+
+	// Modify the component of e through f(Component&), bumps its version and lets on_change observers know
+	template <class Function>
+	Component& patch(Entity e, Function f) {
+		unsigned int i = index_of(e);
+		assert(i != INVALID_INDEX && "Entity not contained in ECS registry");
+		f(components[i]);
+		versions[i] = current_frame();
+		this->notify_change(e, components[i]);
+		return components[i];
+	}
+
+	// Marks the component of e as changed after it was written through get()
+	void touch(Entity e) {
+		patch(e, [](Component&) {});
+	}
+
+	// Frame in which the component of e was last added or patched
+	uint32_t version(Entity e) const {
+		unsigned int i = index_of(e);
+		assert(i != INVALID_INDEX && "Entity not contained in ECS registry");
+		return versions[i];
+	}
+
+	// Calls f(Entity, Component&) for every component added or patched in 'frame' or later. Consumers keep the frame
+	// they last caught up on, anything changed later in that same frame is simply visited twice.
+	template <class Function>
+	void changed_since(uint32_t frame, Function f) {
+		for (size_t i = 0; i < components.size(); i++)
+			if (versions[i] >= frame)
+				f(entities[i], components[i]);
 	}
 
 	// Check if entity has a component of type 'Component'
-	bool has(Entity entity) {
-		return map_entity_componentID.count(entity) > 0;
+	bool has(Entity entity) const {
+		return index_of(entity) != INVALID_INDEX;
 	}
 
 	// Remove an component and pack the container to re-use the empty space
 	void remove(Entity e)
 	{
-		if (has(e))
+		unsigned int cID = index_of(e);
+		if (cID != INVALID_INDEX)
 		{
-			// Get the current position
-			int cID = map_entity_componentID[e];
+			this->notify_remove(e, components[cID]);
+
+			// Ordered containers shift the tail down by one instead, so the order survives
+			if (ordering) {
+				for (unsigned int i = cID; i + 1 < components.size(); i++)
+					swap_entries(i, i + 1);
+				cID = (unsigned int)components.size() - 1;
+			}
 
 			// Move the last element to position cID using the move operator
 			// Note, components[cID] = components.back() would trigger the copy instead of move operator
 			components[cID] = std::move(components.back());
 			entities[cID] = entities.back(); // the entity is only a single index, copy it.
-			map_entity_componentID[entities.back()] = cID;
+			versions[cID] = versions.back();
+			slot(entities.back().index()) = cID;
 
 			// Erase the old component and free its memory
-			map_entity_componentID.erase(e);
+			slot(e.index()) = INVALID_INDEX;
 			components.pop_back();
 			entities.pop_back();
-			// Note, one could mark the id for re-use
+			versions.pop_back();
+			mark(e, false);
 		}
 	};
 
 	// Remove all components of type 'Component'
 	void clear()
 	{
-		map_entity_componentID.clear();
+		for (size_t i = 0; i < entities.size(); i++)
+			this->notify_remove(entities[i], components[i]);
+		// only the slots of stored entities are set, so reset those instead of freeing the pages
+		for (Entity e : entities)
+			slot(e.index()) = INVALID_INDEX;
+		std::vector<Entity> removed;
+		removed.swap(entities);
 		components.clear();
-		entities.clear();
+		versions.clear();
+		for (Entity e : removed)
+			mark(e, false);
+		// hand the storage back so refilling after a restart does not reallocate
+		removed.clear();
+		if (entities.empty())
+			entities.swap(removed);
 	}
 
 	// Report the number of components of type 'Component'
-	size_t size()
+	size_t size() const
 	{
 		return components.size();
 	}
 
+	ContainerMemory memory() const
+	{
+		ContainerMemory memory;
+		memory.count = components.size();
+		memory.capacity = components.capacity();
+		memory.component_bytes = components.capacity() * sizeof(Component) + entities.capacity() * sizeof(Entity) + versions.capacity() * sizeof(uint32_t);
+		memory.index_bytes = sparse_pages.capacity() * sizeof(sparse_pages[0]);
+		for (auto& page : sparse_pages)
+			if (page)
+				memory.index_bytes += PAGE_SIZE * sizeof(unsigned int);
+		for (const Component& component : components)
+			memory.heap_bytes += ComponentHeapBytes<Component>::of(component);
+		return memory;
+	}
+
 	// Sort the components and associated entity assignment structures by the comparisonFunction, see std::sort
+	// The entries stay in place while the comparison runs, so it may look components up with get()
 	template <class Compare>
 	void sort(Compare comparisonFunction)
 	{
-		// First sort the entity list as desired
-		std::sort(entities.begin(), entities.end(), comparisonFunction);
-		// Now re-arrange the components (Note, creates a new vector, which may be slow! Not sure if in-place could be faster: https://stackoverflow.com/questions/63703637/how-to-efficiently-permute-an-array-in-place-using-stdswap)
-		std::vector<Component> components_new; components_new.reserve(components.size());
-		std::transform(entities.begin(), entities.end(), std::back_inserter(components_new), [&](Entity e) { return std::move(get(e)); }); // note, the get still uses the old hash map (on purpose!)
-		components = std::move(components_new); // note, we use move operations to not create unneccesary copies of objects, but memory is still allocated for the new vector
-		// Fill the new hashmap
+		// First sort the positions, sort_order[i] is the entry that belongs at position i
+		sort_order.resize(entities.size());
+		for (unsigned int i = 0; i < sort_order.size(); i++)
+			sort_order[i] = i;
+		std::sort(sort_order.begin(), sort_order.end(), [&](unsigned int a, unsigned int b) { return comparisonFunction(entities[a], entities[b]); });
+		// Then walk each cycle of the permutation once, moving components, entities and versions in lockstep
+		for (unsigned int start = 0; start < sort_order.size(); start++) {
+			if (sort_order[start] == start)
+				continue;
+			Component component = std::move(components[start]);
+			Entity entity = entities[start];
+			uint32_t version = versions[start];
+			unsigned int i = start;
+			while (sort_order[i] != start) {
+				unsigned int next = sort_order[i];
+				components[i] = std::move(components[next]);
+				entities[i] = entities[next];
+				versions[i] = versions[next];
+				sort_order[i] = i;
+				i = next;
+			}
+			components[i] = std::move(component);
+			entities[i] = entity;
+			versions[i] = version;
+			sort_order[i] = i;
+		}
+		// Fill the new sparse index
 		for (unsigned int i = 0; i < entities.size(); i++)
-			map_entity_componentID[entities[i]] = i;
+			slot(entities[i].index()) = i;
+	}
+
+	// Ordered mode: the container is sorted by 'ordering' now and kept that way, inserts go to their place and
+	// removes shift instead of swapping. When the keys change, repair_order() restores the order.
+	template <class Compare>
+	void keep_sorted(Compare ordering)
+	{
+		this->ordering = ordering;
+		sort(ordering);
+	}
+
+	// Insertion sort, close to linear when only a few entries moved since the last repair
+	void repair_order()
+	{
+		assert(ordering && "repair_order() needs keep_sorted()");
+		for (unsigned int i = 1; i < entities.size(); i++)
+			sift_down(i);
+	}
+
+	// Become a copy of the components, entities, versions and index of 'other', reusing the memory held from the last
+	// copy. Observers, ordering and signatures are left alone, meant for containers outside a registry (RegistrySnapshot).
+	// 'other' may hold another component type, each of its components is then converted with Component(const Source&).
+	template <typename Source>
+	void copy_from(const ComponentContainer<Source>& other)
+	{
+		copy_components(other.components);
+		entities = other.entities;
+		versions = other.versions;
+		if (sparse_pages.size() < other.sparse_pages.size())
+			sparse_pages.resize(other.sparse_pages.size());
+		for (size_t page = 0; page < sparse_pages.size(); page++) {
+			if (page < other.sparse_pages.size() && other.sparse_pages[page]) {
+				if (!sparse_pages[page])
+					sparse_pages[page].reset(new unsigned int[PAGE_SIZE]);
+				std::copy(other.sparse_pages[page].get(), other.sparse_pages[page].get() + PAGE_SIZE, sparse_pages[page].get());
+			}
+			else if (sparse_pages[page]) {
+				// a page the source does not have may still point past the new end of the dense arrays
+				std::fill(sparse_pages[page].get(), sparse_pages[page].get() + PAGE_SIZE, (unsigned int)INVALID_INDEX);
+			}
+		}
+	}
+
+private:
+	template <typename, bool> friend class ComponentContainer;
+
+	void copy_components(const std::vector<Component>& source) {
+		components = source;
+	}
+	template <typename Source>
+	void copy_components(const std::vector<Source>& source) {
+		components.clear();
+		for (const Source& component : source)
+			components.emplace_back(component);
+	}
+};
+
+// Container for empty components (tags such as MapTile or Obstacle): membership is one bit per entity index,
+// so has() is a single bit test. The entities are still listed densely for iteration, with the position of every
+// entity in that list kept by index so remove() does not search it. There is no per-entity component storage.
+template <typename Component>
+class ComponentContainer<Component, true> final : public ContainerInterface, public ComponentObservers<Component>
+{
+private:
+	std::vector<uint64_t> bits;
+	std::vector<unsigned int> positions; // by entity index, where it sits in 'entities'. Only valid while its bit is set.
+	static Component instance; // every entity shares the same (empty) component
+
+	bool test(unsigned int index) const {
+		return (index >> 6) < bits.size() && (bits[index >> 6] >> (index & 63)) & 1;
+	}
+
+	// Set by keep_sorted(), the order of the entity list. Empty for unordered containers.
+	std::function<bool(Entity, Entity)> ordering;
+
+	void place(size_t i) {
+		positions[entities[i].index()] = (unsigned int)i;
+	}
+
+	void sift_down(size_t i) {
+		for (; i > 0 && ordering(entities[i], entities[i - 1]); i--) {
+			std::swap(entities[i - 1], entities[i]);
+			place(i - 1);
+			place(i);
+		}
+	}
+
+	void set_bit(unsigned int index, bool value) {
+		if ((index >> 6) >= bits.size()) {
+			bits.resize((index >> 6) + 1, 0);
+			positions.resize(bits.size() * 64);
+		}
+		if (value)
+			bits[index >> 6] |= uint64_t(1) << (index & 63);
+		else
+			bits[index >> 6] &= ~(uint64_t(1) << (index & 63));
+	}
+
+public:
+	// Stands in for the components vector of other containers, yields the shared instance once per entity
+	struct TagComponents
+	{
+		const std::vector<Entity>* entities;
+		struct iterator {
+			size_t i;
+			const Component& operator*() const { return instance; }
+			iterator& operator++() { i++; return *this; }
+			bool operator!=(const iterator& other) const { return i != other.i; }
+		};
+		size_t size() const { return entities->size(); }
+		iterator begin() const { return { 0 }; }
+		iterator end() const { return { entities->size() }; }
+		Component& operator[](size_t) const { return instance; }
+	};
+
+	std::vector<Entity> entities;
+	TagComponents components = { &entities };
+
+	ComponentContainer() {}
+	ComponentContainer(const ComponentContainer& other) : ContainerInterface(other), bits(other.bits), positions(other.positions), entities(other.entities) {}
+	ComponentContainer& operator=(const ComponentContainer& other) {
+		bits = other.bits;
+		positions = other.positions;
+		entities = other.entities;
+		return *this;
+	}
+
+	inline Component& insert(Entity e, Component, bool check_for_duplicates = true)
+	{
+		assert(!(check_for_duplicates && has(e)) && "Entity already contained in ECS registry");
+		assert(Entity::isAlive(e) && "Entity was already destroyed");
+		if (!test(e.index())) {
+			set_bit(e.index(), true);
+			entities.push_back(e);
+			place(entities.size() - 1);
+			if (ordering)
+				sift_down(entities.size() - 1);
+		}
+		mark(e, true);
+		this->notify_add(e, instance);
+		return instance;
+	};
+
+	template<typename... Args>
+	Component& emplace(Entity e, Args &&... args) {
+		return insert(e, Component(std::forward<Args>(args)...));
+	};
+	template<typename... Args>
+	Component& emplace_with_duplicates(Entity e, Args &&... args) {
+		return insert(e, Component(std::forward<Args>(args)...), false);
+	};
+
+	Component& get(Entity e) {
+		assert(has(e) && "Entity not contained in ECS registry");
+		return instance;
+	}
+
+	// The bit only says the index is tagged, the stored handle tells apart stale ones and other registries' entities
+	bool has(Entity entity) const {
+		return test(entity.index()) && entities[positions[entity.index()]].getId() == entity.getId();
 	}
+
+	void remove(Entity e)
+	{
+		if (!has(e))
+			return;
+		this->notify_remove(e, instance);
+		set_bit(e.index(), false);
+		size_t i = positions[e.index()];
+		assert(entities[i].getId() == e.getId() && "Tag position out of sync");
+		// ordered lists close the gap instead, so the order survives
+		if (ordering) {
+			for (; i + 1 < entities.size(); i++) {
+				entities[i] = entities[i + 1];
+				place(i);
+			}
+		}
+		else {
+			entities[i] = entities.back();
+			place(i);
+		}
+		entities.pop_back();
+		mark(e, false);
+	}
+
+	void clear()
+	{
+		std::vector<Entity> removed;
+		removed.swap(entities);
+		for (Entity e : removed) {
+			this->notify_remove(e, instance);
+			set_bit(e.index(), false);
+			mark(e, false);
+		}
+		removed.clear();
+		if (entities.empty())
+			entities.swap(removed);
+	}
+
+	size_t size() const
+	{
+		return entities.size();
+	}
+
+	ContainerMemory memory() const
+	{
+		ContainerMemory memory;
+		memory.count = entities.size();
+		memory.capacity = entities.capacity();
+		memory.component_bytes = entities.capacity() * sizeof(Entity);
+		memory.index_bytes = bits.capacity() * sizeof(uint64_t) + positions.capacity() * sizeof(unsigned int);
+		return memory;
+	}
+
+	template <class Compare>
+	void sort(Compare comparisonFunction)
+	{
+		std::sort(entities.begin(), entities.end(), comparisonFunction);
+		for (size_t i = 0; i < entities.size(); i++)
+			place(i);
+	}
+
+	// Ordered mode, see ComponentContainer::keep_sorted
+	template <class Compare>
+	void keep_sorted(Compare ordering)
+	{
+		this->ordering = ordering;
+		sort(ordering);
+	}
+
+	void repair_order()
+	{
+		assert(ordering && "repair_order() needs keep_sorted()");
+		for (size_t i = 1; i < entities.size(); i++)
+			sift_down(i);
+	}
+};
+
+template <typename Component>
+Component ComponentContainer<Component, true>::instance;
+
+// Opt-in chunked storage for entities that all have exactly the components 'Components...' (an archetype).
+// Entities are packed into fixed-size chunks and every chunk keeps one contiguous column per component type, so a
+// system can stream e.g. all positions of a chunk without pulling the other fields through the cache.
+// Removing swaps the very last entity into the hole, so every chunk but the last one is always full.
+template <typename... Components>
+class Archetype final : public ContainerInterface
+{
+public:
+	enum : unsigned int {
+		CHUNK_CAPACITY = 128,
+		INVALID_LOCATION = 0xFFFFFFFFu
+	};
+
+	struct Chunk
+	{
+		std::vector<Entity> entities;
+		std::tuple<std::vector<Components>...> columns;
+
+		Chunk() {
+			entities.reserve(CHUNK_CAPACITY);
+			using expand = int[];
+			(void)expand{ 0, (std::get<std::vector<Components>>(columns).reserve(CHUNK_CAPACITY), 0)... };
+		}
+	};
+
+private:
+	std::vector<std::unique_ptr<Chunk>> chunks;
+	// Emptied chunks, reused before new ones are allocated so particle churn and restarts keep their memory
+	std::vector<std::unique_ptr<Chunk>> spare_chunks;
+	// Entity index -> chunk * CHUNK_CAPACITY + slot
+	std::vector<unsigned int> locations;
+	size_t count = 0;
+
+	unsigned int location_of(Entity e) const {
+		if (e.index() >= locations.size() || locations[e.index()] == INVALID_LOCATION)
+			return INVALID_LOCATION;
+		unsigned int location = locations[e.index()];
+		if (chunks[location / CHUNK_CAPACITY]->entities[location % CHUNK_CAPACITY].getId() != e.getId())
+			return INVALID_LOCATION;
+		return location;
+	}
+
+	void retire_last_chunk() {
+		Chunk& chunk = *chunks.back();
+		chunk.entities.clear();
+		using expand = int[];
+		(void)expand{ 0, (std::get<std::vector<Components>>(chunk.columns).clear(), 0)... };
+		spare_chunks.push_back(std::move(chunks.back()));
+		chunks.pop_back();
+	}
+
+	// Move the last component of chunk 'from' into slot 'to_slot' of chunk 'to'
+	template <typename Component>
+	static int move_back_into(Chunk& to, unsigned int to_slot, Chunk& from) {
+		std::vector<Component>& destination = std::get<std::vector<Component>>(to.columns);
+		std::vector<Component>& source = std::get<std::vector<Component>>(from.columns);
+		if (&to != &from || to_slot + 1 != source.size())
+			destination[to_slot] = std::move(source.back());
+		source.pop_back();
+		return 0;
+	}
+
+public:
+	// Insert entity e with all of its components
+	void insert(Entity e, Components... components) {
+		assert(!has(e) && "Entity already contained in archetype");
+		assert(Entity::isAlive(e) && "Entity was already destroyed");
+		if (chunks.empty() || chunks.back()->entities.size() == CHUNK_CAPACITY) {
+			if (spare_chunks.empty()) {
+				chunks.emplace_back(new Chunk());
+			}
+			else {
+				chunks.push_back(std::move(spare_chunks.back()));
+				spare_chunks.pop_back();
+			}
+		}
+		Chunk& chunk = *chunks.back();
+
+		if (e.index() >= locations.size())
+			locations.resize(e.index() + 1, INVALID_LOCATION);
+		locations[e.index()] = (unsigned int)((chunks.size() - 1) * CHUNK_CAPACITY + chunk.entities.size());
+		chunk.entities.push_back(e);
+		using expand = int[];
+		(void)expand{ 0, (std::get<std::vector<Components>>(chunk.columns).push_back(std::move(components)), 0)... };
+		count++;
+		mark(e, true);
+	}
+
+	template <typename Component>
+	Component& get(Entity e) {
+		assert(has(e) && "Entity not contained in archetype");
+		unsigned int location = location_of(e);
+		return std::get<std::vector<Component>>(chunks[location / CHUNK_CAPACITY]->columns)[location % CHUNK_CAPACITY];
+	}
+
+	bool has(Entity e) const {
+		return location_of(e) != INVALID_LOCATION;
+	}
+
+	void remove(Entity e) {
+		unsigned int location = location_of(e);
+		if (location == INVALID_LOCATION)
+			return;
+
+		Chunk& chunk = *chunks[location / CHUNK_CAPACITY];
+		unsigned int slot = location % CHUNK_CAPACITY;
+		Chunk& last = *chunks.back();
+
+		// fill the hole with the last entity of the last chunk
+		Entity moved = last.entities.back();
+		chunk.entities[slot] = moved;
+		last.entities.pop_back();
+		using expand = int[];
+		(void)expand{ 0, move_back_into<Components>(chunk, slot, last)... };
+		locations[moved.index()] = location;
+
+		locations[e.index()] = INVALID_LOCATION;
+		count--;
+		if (last.entities.empty())
+			retire_last_chunk();
+		mark(e, false);
+	}
+
+	void clear() {
+		count = 0;
+		for (auto& chunk : chunks)
+			for (Entity e : chunk->entities)
+				locations[e.index()] = INVALID_LOCATION;
+		for (auto& chunk : chunks)
+			for (Entity e : chunk->entities)
+				mark(e, false);
+		while (!chunks.empty())
+			retire_last_chunk();
+	}
+
+	size_t size() const {
+		return count;
+	}
+
+	// Chunks are reserved up front, so every chunk, spare ones included, counts as full. Archetype components are plain data without heap.
+	ContainerMemory memory() const {
+		size_t row_bytes = sizeof(Entity);
+		using expand = size_t[];
+		for (size_t bytes : expand{ sizeof(Components)... })
+			row_bytes += bytes;
+		ContainerMemory memory;
+		memory.count = count;
+		size_t reserved = chunks.size() + spare_chunks.size();
+		memory.capacity = reserved * CHUNK_CAPACITY;
+		memory.component_bytes = reserved * (sizeof(Chunk) + CHUNK_CAPACITY * row_bytes);
+		memory.index_bytes = locations.capacity() * sizeof(unsigned int) + (chunks.capacity() + spare_chunks.capacity()) * sizeof(chunks[0]);
+		return memory;
+	}
+
+	// Calls f(size_t count, Entity* entities, Components*... columns) once per chunk with the chunk's contiguous arrays
+	template <class Function>
+	void each_chunk(Function f) {
+		for (auto& chunk : chunks)
+			f(chunk->entities.size(), chunk->entities.data(), std::get<std::vector<Components>>(chunk->columns).data()...);
+	}
+};
+
+// A persistent query over a registry: the entities whose signature has every 'include' bit and no 'exclude' bit.
+// The containers involved re-check an entity whenever they gain or lose it, so systems read a ready-made dense list
+// instead of filtering every frame. Like a container, the list is swap-removed, so defer changes while iterating it.
+class Query
+{
+private:
+	enum : unsigned int { INVALID_POSITION = 0xFFFFFFFFu };
+
+	const std::vector<uint64_t>* signatures = nullptr;
+	uint64_t include = 0;
+	uint64_t exclude = 0;
+	// Entity index -> position in entities
+	std::vector<unsigned int> positions;
+
+	unsigned int position_of(Entity e) const {
+		if (e.index() >= positions.size() || positions[e.index()] == INVALID_POSITION)
+			return INVALID_POSITION;
+		unsigned int position = positions[e.index()];
+		return entities[position].getId() == e.getId() ? position : INVALID_POSITION;
+	}
+
+public:
+	std::vector<Entity> entities;
+
+	// Watch the given containers, they all have to belong to the registry that owns 'signatures'
+	void define(const std::vector<uint64_t>* signatures, const std::vector<ContainerInterface*>& included, const std::vector<ContainerInterface*>& excluded) {
+		this->signatures = signatures;
+		for (ContainerInterface* container : included) {
+			include |= container->signature_bit;
+			container->queries.push_back(this);
+		}
+		for (ContainerInterface* container : excluded) {
+			exclude |= container->signature_bit;
+			container->queries.push_back(this);
+		}
+	}
+
+	bool contains(Entity e) const {
+		return position_of(e) != INVALID_POSITION;
+	}
+
+	size_t size() const {
+		return entities.size();
+	}
+
+	// Re-evaluate e against the signature, adding or dropping it from the list
+	void refresh(Entity e) {
+		uint64_t signature = e.index() < signatures->size() ? (*signatures)[e.index()] : 0;
+		bool matches = Entity::isAlive(e) && (signature & include) == include && (signature & exclude) == 0;
+		unsigned int position = position_of(e);
+		if (matches && position == INVALID_POSITION) {
+			if (e.index() >= positions.size())
+				positions.resize(e.index() + 1, INVALID_POSITION);
+			positions[e.index()] = (unsigned int)entities.size();
+			entities.push_back(e);
+		}
+		else if (!matches && position != INVALID_POSITION) {
+			Entity moved = entities.back();
+			entities[position] = moved;
+			positions[moved.index()] = position;
+			entities.pop_back();
+			positions[e.index()] = INVALID_POSITION;
+		}
+	}
+
+	void clear() {
+		for (Entity e : entities)
+			positions[e.index()] = INVALID_POSITION;
+		entities.clear();
+	}
+};
+
+inline void ContainerInterface::mark(Entity e, bool present)
+{
+	if (!signatures)
+		return;
+	if (e.index() >= signatures->size())
+		signatures->resize(e.index() + 1, 0);
+	if (present)
+		(*signatures)[e.index()] |= signature_bit;
+	else
+		(*signatures)[e.index()] &= ~signature_bit;
+	for (Query* query : queries)
+		query->refresh(e);
+}
+
+// Marks component types a view must not have, e.g. registry.view<Motion>(Exclude<Bird, MapTile>())
+template <typename... Components>
+struct Exclude {};
+
+template <typename ExcludeList, typename... Components>
+class View;
+
+// Joins several containers: visits every entity that has all of 'Components' and none of 'Excluded'.
+// Iteration is driven by the smallest of the included containers, the others are probed with has(). Containers
+// filled together (Motion, Shape and Presentation through emplace_motion) keep their entities in the same order,
+// so each() first tries the slot the driver is at and only falls back to the sparse lookup when it doesn't match.
+// The excluded containers are template arguments too, so a view does not allocate and calls has() directly.
+// Like looping over a container directly, removing from the driving container while iterating skips entities.
+template <typename... Excluded, typename... Components>
+class View<Exclude<Excluded...>, Components...>
+{
+private:
+	std::tuple<ComponentContainer<Components>*...> containers;
+	std::tuple<ComponentContainer<Excluded>*...> excluded;
+	std::vector<Entity>* driver = nullptr;
+
+	template <size_t... I>
+	bool has_all(Entity e, std::index_sequence<I...>) {
+		bool result = true;
+		using expand = int[];
+		(void)expand{ 0, (result = result && std::get<I>(containers)->has(e), 0)... };
+		return result;
+	}
+
+	template <size_t... I>
+	bool has_any_excluded(Entity e, std::index_sequence<I...>) {
+		bool result = false;
+		using expand = int[];
+		(void)expand{ 0, (result = result || std::get<I>(excluded)->has(e), 0)... };
+		return result;
+	}
+
+	template <typename Component>
+	static bool at_slot(ComponentContainer<Component>* container, Entity e, size_t i) {
+		return ECS_LIKELY(i < container->entities.size() && container->entities[i].getId() == e.getId());
+	}
+
+	template <size_t... I>
+	bool has_all_at(Entity e, size_t i, std::index_sequence<I...>) {
+		bool result = true;
+		using expand = int[];
+		(void)expand{ 0, (result = result && (at_slot(std::get<I>(containers), e, i) || std::get<I>(containers)->has(e)), 0)... };
+		return result;
+	}
+
+	template <typename Component>
+	static Component& get_at(ComponentContainer<Component>* container, Entity e, size_t i) {
+		return at_slot(container, e, i) ? container->components[i] : container->get(e);
+	}
+
+	template <class Function, size_t... I>
+	void invoke(Function& f, Entity e, size_t i, std::index_sequence<I...>) {
+		f(e, get_at(std::get<I>(containers), e, i)...);
+	}
+
+public:
+	class iterator
+	{
+		View* view;
+		size_t i;
+		void skip() {
+			while (i < view->driver->size() && !view->contains((*view->driver)[i]))
+				i++;
+		}
+	public:
+		iterator(View* view, size_t i) : view(view), i(i) { skip(); }
+		Entity operator*() const { return (*view->driver)[i]; }
+		iterator& operator++() { i++; skip(); return *this; }
+		bool operator!=(const iterator& other) const { return i != other.i; }
+	};
+
+	View(std::tuple<ComponentContainer<Excluded>*...> excluded, ComponentContainer<Components>&... included)
+		: containers(&included...), excluded(excluded)
+	{
+		static_assert(sizeof...(Components) > 0, "A view needs at least one component type");
+		std::vector<Entity>* candidates[] = { &included.entities... };
+		driver = candidates[0];
+		for (std::vector<Entity>* candidate : candidates)
+			if (candidate->size() < driver->size())
+				driver = candidate;
+	}
+
+	// Check if entity e would be visited by this view
+	bool contains(Entity e) {
+		return has_all(e, std::index_sequence_for<Components...>()) && !has_any_excluded(e, std::index_sequence_for<Excluded...>());
+	}
+
+	template <typename Component>
+	Component& get(Entity e) {
+		return std::get<ComponentContainer<Component>*>(containers)->get(e);
+	}
+
+	// Calls f(Entity, Components&...) for every entity in the view
+	template <class Function>
+	void each(Function f) {
+		for (size_t i = 0; i < driver->size(); i++) {
+			Entity e = (*driver)[i];
+			if (has_all_at(e, i, std::index_sequence_for<Components...>()) && !has_any_excluded(e, std::index_sequence_for<Excluded...>()))
+				invoke(f, e, i, std::index_sequence_for<Components...>());
+		}
+	}
+
+	iterator begin() { return iterator(this, 0); }
+	iterator end() { return iterator(this, driver->size()); }
 };
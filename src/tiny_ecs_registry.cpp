@@ -4,4 +4,103 @@
 
 #include "tiny_ecs_registry.hpp"
 
-ECSRegistry registry;
\ No newline at end of file
+ECSRegistry registry;
+
+void ECSRegistry::flush_deferred()
+{
+	// Group removes per container so each container is touched in one go
+	std::stable_sort(deferred_removes.begin(), deferred_removes.end(),
+		[](const std::pair<ContainerInterface*, Entity>& a, const std::pair<ContainerInterface*, Entity>& b) { return a.first < b.first; });
+	for (auto& remove : deferred_removes)
+		remove.first->remove(remove.second);
+	deferred_removes.clear();
+
+	// Swap the pending lists out first, anything recorded during the flush waits for the next one
+	std::vector<std::function<void(ECSRegistry&)>> adds;
+	adds.swap(deferred_adds);
+	for (auto& add : adds)
+		add(*this);
+
+	// The same entity is often destroyed from several places in one frame, destroy_batch ignores repeats
+	std::vector<Entity> destroys;
+	destroys.swap(deferred_destroys);
+	destroy_batch(destroys);
+}
+
+void ECSRegistry::merge(CommandBuffer& commands)
+{
+	deferred_adds.insert(deferred_adds.end(), std::make_move_iterator(commands.adds.begin()), std::make_move_iterator(commands.adds.end()));
+	commands.adds.clear();
+}
+
+void ECSRegistry::link_child(Entity child, Entity parent)
+{
+	unsigned int size = std::max(child.index(), parent.index()) + 1;
+	if (first_child.size() < size) {
+		first_child.resize(size, NO_CHILD);
+		next_sibling.resize(size, NO_CHILD);
+	}
+	next_sibling[child.index()] = first_child[parent.index()];
+	first_child[parent.index()] = child.index();
+}
+
+void ECSRegistry::unlink_child(Entity child, Entity parent)
+{
+	// an entity only has a handful of children, so finding the link is a short walk
+	unsigned int* link = &first_child[parent.index()];
+	while (*link != child.index()) {
+		assert(*link != NO_CHILD && "Child missing from its parent's list");
+		link = &next_sibling[*link];
+	}
+	*link = next_sibling[child.index()];
+	next_sibling[child.index()] = NO_CHILD;
+}
+
+void ECSRegistry::sort_hierarchy()
+{
+	if (hierarchy_sorted)
+		return;
+	// Depth of every attached entity by id, worked out once instead of walking the chain in every comparison
+	std::unordered_map<unsigned int, unsigned int> depths;
+	for (size_t i = 0; i < relationships.size(); i++) {
+		unsigned int depth = 0;
+		for (Entity parent = relationships.components[i].parent; relationships.has(parent); parent = relationships.get(parent).parent) {
+			depth++;
+			assert(depth <= relationships.size() && "Cycle in the entity hierarchy");
+		}
+		depths[relationships.entities[i].getId()] = depth;
+	}
+	relationships.sort([&depths](Entity a, Entity b) { return depths[a.getId()] < depths[b.getId()]; });
+	hierarchy_sorted = true;
+}
+
+void ECSRegistry::update_hierarchy()
+{
+	sort_hierarchy();
+	for (size_t i = 0; i < relationships.size(); i++) {
+		Relationship& relationship = relationships.components[i];
+		Entity child = relationships.entities[i];
+		if (motions.has(relationship.parent) && motions.has(child))
+			motions.get(child).position = motions.get(relationship.parent).position + relationship.offset;
+	}
+}
+
+void ECSRegistry::destroy_batch(std::vector<Entity>& batch)
+{
+	// Children are appended behind their parent, so grandchildren are reached in the same pass.
+	// Entities listed twice are already dead the second time and skipped.
+	for (size_t i = 0; i < batch.size(); i++) {
+		Entity e = batch[i];
+		if (!Entity::isAlive(e))
+			continue;
+		if (e.index() < first_child.size()) {
+			for (unsigned int c = first_child[e.index()]; c != NO_CHILD; c = next_sibling[c]) {
+				Entity child = Entity::at_index(c);
+				// the list is keyed by index, the parent handle tells a reused index apart
+				if (relationships.has(child) && relationships.get(child).parent.getId() == e.getId())
+					batch.push_back(child);
+			}
+		}
+		destroy_entity(e);
+	}
+}
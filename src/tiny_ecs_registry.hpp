@@ -8,78 +8,138 @@
 #include "animation_system.hpp"
 #include "game_state_controller.hpp"
 
+// Every container of the registry, declared once. The members, the container<Component>() lookup and the bulk
+// operations (clear, remove, count, save) are all generated from this list, so a container added here can't be missed
+// by any of them. The member name doubles as the container's key in save files.
+#define ECS_CONTAINERS(X) \
+	X(ComponentContainer<Player>, players) \
+	X(ComponentContainer<Dash>, dashers) \
+	X(ComponentContainer<Enemy>, enemies) \
+	X(ComponentContainer<Motion>, motions) \
+	X(ComponentContainer<Shape>, shapes) \
+	X(ComponentContainer<Presentation>, presentations) \
+	X(ComponentContainer<Collision>, collisions) \
+	X(ComponentContainer<Cooldown>, cooldowns) \
+	X(ComponentContainer<Collectible>, collectibles) \
+	X(ComponentContainer<Trap>, traps) \
+	X(ComponentContainer<PhantomTrap>, phantomTraps) \
+	X(ComponentContainer<Damaged>, damageds) \
+	X(ComponentContainer<Damaging>, damagings) \
+	X(ComponentContainer<DeathTimer>, deathTimers) \
+	X(ComponentContainer<Invulnerable>, invulnerables) \
+	X(ComponentContainer<Knockable>, knockables) \
+	X(ComponentContainer<Knocker>, knockers) \
+	X(ComponentContainer<Trappable>, trappables) \
+	X(ComponentContainer<HealthBar>, healthBars) \
+	X(ComponentContainer<AnimationController>, animationControllers) \
+	X(ComponentContainer<StaminaBar>, staminaBars) \
+	X(ComponentContainer<Stamina>, staminas) \
+	X(ComponentContainer<Text>, texts) \
+	X(ComponentContainer<Jumper>, jumpers) \
+	X(ComponentContainer<MapTile>, mapTiles) \
+	X(ComponentContainer<Obstacle>, obstacles) \
+	X(ComponentContainer<StaticBody>, staticBodies) \
+	X(ComponentContainer<Projectile>, projectiles) \
+	X(ComponentContainer<Mesh*>, meshPtrs) \
+	X(ComponentContainer<TargetArea>, targetAreas) \
+	X(ComponentContainer<Collected>, collected) \
+	X(ComponentContainer<SlideUp>, slideUps) \
+	X(ComponentContainer<HomingProjectile>, homingProjectiles) \
+	X(ComponentContainer<Bounceable>, bounceables) \
+	X(ComponentContainer<Explosion>, explosions) \
+	X(ComponentContainer<Relationship>, relationships) \
+	X(ParticleArchetype, particles) \
+	/* menus and tutorials */ \
+	X(ComponentContainer<PauseMenuComponent>, pauseMenuComponents) \
+	X(ComponentContainer<HelpMenuComponent>, helpMenuComponents) \
+	X(ComponentContainer<TutorialComponent>, tutorialComponents) \
+	X(ComponentContainer<EnemyTutorialComponents>, enemyTutorialComponents) \
+	X(ComponentContainer<CollectibleTutorialComponents>, collectibleTutorialComponents) \
+	/* render */ \
+	X(ComponentContainer<RenderRequest>, renderRequests) \
+	X(ComponentContainer<Background>, backgrounds) \
+	X(ComponentContainer<Midground>, midgrounds) \
+	X(ComponentContainer<Foreground>, foregrounds) \
+	X(ComponentContainer<vec4>, colours) \
+	X(ComponentContainer<PointLight>, pointLights) \
+	/* spawnable types */ \
+	X(ComponentContainer<Boar>, boars) \
+	X(ComponentContainer<Barbarian>, barbarians) \
+	X(ComponentContainer<Archer>, archers) \
+	X(ComponentContainer<Bird>, birds) \
+	X(ComponentContainer<Wizard>, wizards) \
+	X(ComponentContainer<Troll>, trolls) \
+	X(ComponentContainer<Bomber>, bombers) \
+	X(ComponentContainer<Heart>, hearts) \
+	X(ComponentContainer<Bow>, bows) \
+	X(ComponentContainer<CollectibleTrap>, collectibleTraps) \
+	X(ComponentContainer<CollectibleBomb>, collectibleBombs)
+
+// Particles are stored together in chunks, see Archetype
+using ParticleArchetype = Archetype<ParticleMotion, Particle>;
+
+class CommandBuffer;
+
+// Entity ids come from one process-wide allocator (see Entity), a registry only stores components for them.
+// Several registries can live side by side (the game's, the benchmarks'), but every entity belongs to the one
+// registry it has components in: destroying it there releases its id for everyone, so giving it components in a
+// second registry leaves that one holding a stale handle.
 class ECSRegistry
 {
-	// Callbacks to remove a particular or all entities in the system
-	std::vector<ContainerInterface*> registry_list;
+	// Small-object memory of the components (hash nodes, buckets), declared first so it outlives the containers
+	PoolResource pool;
 
-public:
-	// constructor that adds all containers for looping over them
-	// IMPORTANT: Don't forget to add any newly added containers!
-	ComponentContainer<Player> players;
-	ComponentContainer<Dash> dashers;
-	ComponentContainer<Enemy> enemies;
-	ComponentContainer<Motion> motions;
-	ComponentContainer<Collision> collisions;
-	ComponentContainer<Cooldown> cooldowns;
-	ComponentContainer<Collectible> collectibles;
-	ComponentContainer<Trap> traps;
-	ComponentContainer<PhantomTrap> phantomTraps;
-	ComponentContainer<Damaged> damageds;
-	ComponentContainer<Damaging> damagings;
-	ComponentContainer<DeathTimer> deathTimers;
-	ComponentContainer<Invulnerable> invulnerables;
-	ComponentContainer<Knockable> knockables;
-	ComponentContainer<Knocker> knockers;
-	ComponentContainer<Trappable> trappables;
-	ComponentContainer<HealthBar> healthBars;
-	ComponentContainer<AnimationController> animationControllers;
-	ComponentContainer<StaminaBar> staminaBars;
-	ComponentContainer<Stamina> staminas;
-	ComponentContainer<Text> texts;
-	ComponentContainer<Jumper> jumpers;
-	ComponentContainer<MapTile> mapTiles;
-	ComponentContainer<Obstacle> obstacles;
-	ComponentContainer<Projectile> projectiles;
-	ComponentContainer<Mesh*> meshPtrs;
-	ComponentContainer<TargetArea> targetAreas;
-	ComponentContainer<Collected> collected;
-	ComponentContainer<SlideUp> slideUps;
-	ComponentContainer<HomingProjectile> homingProjectiles;
-	ComponentContainer<Bounceable> bounceables;
-	ComponentContainer<Explosion> explosions;
-	ComponentContainer<Particle> particles;
-	
-	ComponentContainer<PauseMenuComponent> pauseMenuComponents;
-	ComponentContainer<HelpMenuComponent> helpMenuComponents;
-	ComponentContainer<TutorialComponent> tutorialComponents;
-	ComponentContainer<EnemyTutorialComponents> enemyTutorialComponents;
-	ComponentContainer<CollectibleTutorialComponents> collectibleTutorialComponents;
+	// Component membership of every entity indexed by Entity::index(), one bit per container
+	std::vector<uint64_t> signatures;
+#define ECS_COUNT_CONTAINER(type, name) + 1
+	enum : size_t { CONTAINER_COUNT = 0 ECS_CONTAINERS(ECS_COUNT_CONTAINER) };
+#undef ECS_COUNT_CONTAINER
+	static_assert(CONTAINER_COUNT <= 64, "Component signatures only hold 64 containers");
 
-	std::map<char, TextChar> textChars; //for initializing text glyphs from freetypes
+	// The container behind every signature bit, so destroying an entity only visits the containers it is in
+	ContainerInterface* containers_by_bit[CONTAINER_COUNT] = {};
 
-	// Render component containers
-	ComponentContainer<RenderRequest> renderRequests;
-	ComponentContainer<Background> backgrounds;
-	ComponentContainer<Midground> midgrounds;
-	ComponentContainer<Foreground> foregrounds;
-	ComponentContainer<vec4> colours;
-	ComponentContainer<PointLight> pointLights;
+	// Advanced once per game frame, components remember the frame they last changed in
+	uint32_t frame = 1;
 
+	// Whether relationships is still ordered parents before children, see sort_hierarchy
+	bool hierarchy_sorted = true;
+
+	// Children of every entity as a singly linked list through entity indices: first_child by parent index,
+	// next_sibling by child index. Kept by the relationships observers so destroying walks only the subtree.
+	enum : unsigned int { NO_CHILD = 0xFFFFFFFFu };
+	std::vector<unsigned int> first_child;
+	std::vector<unsigned int> next_sibling;
+	void link_child(Entity child, Entity parent);
+	void unlink_child(Entity child, Entity parent);
+
+	// Collects every container member as it is constructed, must be declared before the containers
+	struct DeclaredContainers {
+		std::vector<ContainerInterface*> list;
+		DeclaredContainers() { ContainerInterface::declared_containers = &list; }
+	} declared;
+
+	// One overload per container so container<Component>() resolves at compile time
+	template <typename Container>
+	struct ContainerTag {};
+#define ECS_CONTAINER_OF(type, name) type& container_of(ContainerTag<type>) { return name; }
+	ECS_CONTAINERS(ECS_CONTAINER_OF)
+#undef ECS_CONTAINER_OF
+
+public:
+#define ECS_DECLARE_CONTAINER(type, name) type name;
+	ECS_CONTAINERS(ECS_DECLARE_CONTAINER)
+#undef ECS_DECLARE_CONTAINER
+
+	std::map<char, TextChar> textChars; //for initializing text glyphs from freetypes
 
 	// Spawnable types
-	std::unordered_map<std::string, ContainerInterface*> spawnable_lists;
-	ComponentContainer<Boar> boars;
-	ComponentContainer<Barbarian> barbarians;
-	ComponentContainer<Archer> archers;
-	ComponentContainer<Bird> birds;
-	ComponentContainer<Wizard> wizards;
-	ComponentContainer<Troll> trolls;
-	ComponentContainer<Bomber> bombers;
-	ComponentContainer<Heart> hearts;
-	ComponentContainer<Bow> bows;
-	ComponentContainer<CollectibleTrap> collectibleTraps;
-	ComponentContainer<CollectibleBomb> collectibleBombs;
+	std::unordered_map<SPAWN_TYPE, ContainerInterface*> spawnable_lists;
+
+	// Persistent queries, kept up to date as components come and go
+	Query flock;                   // Bird + Motion
+	Query livingEnemies;           // Enemy + Motion, not dying
+	Query boundsCheckedDamagings;  // Damaging + Motion that are neither bouncing nor exploding
 
 	GameTimer gameTimer;
 	GameScore gameScore;
@@ -88,104 +148,280 @@ public:
 
 	//debugging
 	FPSTracker fpsTracker;
+	MemoryTracker memoryTracker;
+
+	// Typed lookup of the container that stores 'Component', used by view()
+	template <typename Component>
+	ComponentContainer<Component>& container() {
+		return container_of(ContainerTag<ComponentContainer<Component>>());
+	}
+
+	// Every entity with a Motion also has a Shape and a Presentation, this adds all three
+	Motion& emplace_motion(Entity e) {
+		shapes.emplace(e);
+		presentations.emplace(e);
+		return motions.emplace(e);
+	}
+
+	// Animation controllers keep their animations in this registry's pool
+	AnimationController& emplace_animation_controller(Entity e) {
+		return animationControllers.emplace(e, &pool);
+	}
+
+	// Attach a query to the containers of 'Components' (and the excluded ones), only valid before entities exist
+	template <typename... Components, typename... Excluded>
+	void define_query(Query& query, Exclude<Excluded...> = Exclude<Excluded...>()) {
+		query.define(&signatures, { &container<Components>()... }, { &container<Excluded>()... });
+	}
+
+	// Iterate all entities with every one of 'Components', e.g.
+	//   registry.view<Enemy, HealthBar>().each([](Entity e, Enemy& enemy, HealthBar& hpbar) { ... });
+	//   for (Entity e : registry.view<Motion>(Exclude<Bird, MapTile>())) { ... }
+	template <typename... Components, typename... Excluded>
+	View<Exclude<Excluded...>, Components...> view(Exclude<Excluded...> = Exclude<Excluded...>()) {
+		return View<Exclude<Excluded...>, Components...>(std::make_tuple(&container<Excluded>()...), container<Components>()...);
+	}
+
+	// Containers and queries keep pointers into their registry, so a registry stays where it was constructed
+	ECSRegistry(const ECSRegistry&) = delete;
+	ECSRegistry& operator=(const ECSRegistry&) = delete;
 
 	ECSRegistry()
 	{
-		registry_list.push_back(&players);
-		registry_list.push_back(&dashers);
-		registry_list.push_back(&enemies);
-		registry_list.push_back(&motions);
-		registry_list.push_back(&collisions);
-		registry_list.push_back(&cooldowns);
-		registry_list.push_back(&collectibles);
-		registry_list.push_back(&traps);
-		registry_list.push_back(&phantomTraps);
-		registry_list.push_back(&damageds);
-		registry_list.push_back(&damagings);
-		registry_list.push_back(&deathTimers);
-		registry_list.push_back(&invulnerables);
-		registry_list.push_back(&knockables);
-		registry_list.push_back(&knockers);
-		registry_list.push_back(&trappables);
-		registry_list.push_back(&staminas);
-		registry_list.push_back(&mapTiles);
-		registry_list.push_back(&obstacles);
-		registry_list.push_back(&meshPtrs);
-		registry_list.push_back(&collected);
-		registry_list.push_back(&slideUps);
-		registry_list.push_back(&homingProjectiles);
-		registry_list.push_back(&bows);
-		registry_list.push_back(&bounceables);
-		registry_list.push_back(&explosions);
-		registry_list.push_back(&particles);
-		registry_list.push_back(&collectibleBombs);
-		
-		registry_list.push_back(&healthBars);
-		registry_list.push_back(&staminaBars);
-		registry_list.push_back(&texts);
-		registry_list.push_back(&jumpers);
-		registry_list.push_back(&projectiles);
-		registry_list.push_back(&targetAreas);
-
-		registry_list.push_back(&renderRequests);
-		registry_list.push_back(&backgrounds);
-		registry_list.push_back(&midgrounds);
-		registry_list.push_back(&foregrounds);
-		registry_list.push_back(&colours);
-		registry_list.push_back(&pointLights);
-
-		registry_list.push_back(&boars);
-		registry_list.push_back(&barbarians);
-		registry_list.push_back(&archers);
-		registry_list.push_back(&birds);
-		registry_list.push_back(&wizards);
-		registry_list.push_back(&trolls);
-		registry_list.push_back(&bombers);
-		registry_list.push_back(&hearts);
-		registry_list.push_back(&collectibleTraps);
-
-		registry_list.push_back(&animationControllers);
-
-		registry_list.push_back(&pauseMenuComponents);
-		registry_list.push_back(&helpMenuComponents);
-		registry_list.push_back(&tutorialComponents);
-		registry_list.push_back(&enemyTutorialComponents);
-		registry_list.push_back(&collectibleTutorialComponents);
-
-		spawnable_lists["boar"] = &boars;
-		spawnable_lists["barbarian"] = &barbarians;
-		spawnable_lists["archer"] = &archers;
-		spawnable_lists["bird"] = &birds;
-		spawnable_lists["wizard"] = &wizards;
-		spawnable_lists["troll"] = &trolls;
-		spawnable_lists["bomber"] = &bombers;
-		spawnable_lists["heart"] = &hearts;
-		spawnable_lists["collectible_trap"] = &collectibleTraps;
+		// Hand out one signature bit per container
+		size_t bit = 0;
+		for_each_container([&](const char*, ContainerInterface& container) {
+			containers_by_bit[bit] = &container;
+			container.signatures = &signatures;
+			container.signature_bit = uint64_t(1) << bit++;
+			container.frame = &frame;
+		});
+		// A container declared outside ECS_CONTAINERS would never be cleaned up by remove_all_components_of
+		ContainerInterface::declared_containers = nullptr;
+		for (ContainerInterface* container : declared.list)
+			assert(container->signatures && "Container missing from ECS_CONTAINERS");
+
+		// swap-removes and appends can put a child in front of its parent
+		relationships.on_add.push_back([this](Entity child, Relationship& relationship) {
+			hierarchy_sorted = false;
+			link_child(child, relationship.parent);
+		});
+		relationships.on_remove.push_back([this](Entity child, Relationship& relationship) {
+			hierarchy_sorted = false;
+			unlink_child(child, relationship.parent);
+		});
+
+		define_query<Bird, Motion>(flock);
+		define_query<Enemy, Motion>(livingEnemies, Exclude<DeathTimer>());
+		define_query<Damaging, Motion>(boundsCheckedDamagings, Exclude<Bounceable, Explosion>());
+
+		spawnable_lists[SPAWN_TYPE::BOAR] = &boars;
+		spawnable_lists[SPAWN_TYPE::BARBARIAN] = &barbarians;
+		spawnable_lists[SPAWN_TYPE::ARCHER] = &archers;
+		spawnable_lists[SPAWN_TYPE::BIRD] = &birds;
+		spawnable_lists[SPAWN_TYPE::WIZARD] = &wizards;
+		spawnable_lists[SPAWN_TYPE::TROLL] = &trolls;
+		spawnable_lists[SPAWN_TYPE::BOMBER] = &bombers;
+		spawnable_lists[SPAWN_TYPE::HEART] = &hearts;
+		spawnable_lists[SPAWN_TYPE::COLLECTIBLE_TRAP] = &collectibleTraps;
+	}
+
+	// Calls f(name, container) on every container, expanded in place so f sees the concrete container type
+	template <typename F>
+	void for_each_container(F&& f) {
+#define ECS_VISIT_CONTAINER(type, name) f(#name, name);
+		ECS_CONTAINERS(ECS_VISIT_CONTAINER)
+#undef ECS_VISIT_CONTAINER
 	}
 
+	// Also hands back the ids of every entity that had a component, so the next game reuses the same indices and
+	// with them the sparse pages and signatures already allocated. An index is only released if the entity using it
+	// now is the one stored here: a stale handle whose index went to another registry's entity is left alone.
 	void clear_all_components() {
-		for (ContainerInterface* reg : registry_list)
-			reg->clear();
+		std::vector<Entity> alive;
+		alive.reserve(signatures.size() - std::count(signatures.begin(), signatures.end(), 0));
+		for (unsigned int index = 0; index < signatures.size(); index++) {
+			if (!signatures[index])
+				continue;
+			Entity e = Entity::at_index(index);
+			// containers compare the whole handle, so the generation has to match as well
+			if (containers_by_bit[lowest_set_bit(signatures[index])]->has(e))
+				alive.push_back(e);
+		}
+		for_each_container([](const char*, auto& container) { container.clear(); });
+		for (Entity e : alive)
+			Entity::release(e);
+		// anything still pending refers to entities that no longer exist
+		deferred_adds.clear();
+		deferred_removes.clear();
+		deferred_destroys.clear();
+	}
+
+	// Total number of components over all containers
+	size_t component_count() {
+		size_t count = 0;
+		for_each_container([&](const char*, auto& container) { count += container.size(); });
+		return count;
+	}
+
+	// Memory of all containers together, plus the signature table
+	ContainerMemory memory_usage() {
+		ContainerMemory total;
+		for_each_container([&](const char*, auto& container) { total += container.memory(); });
+		total.index_bytes += signatures.capacity() * sizeof(uint64_t);
+		return total;
 	}
 
+	// Per-container occupancy and memory, every container that holds or has held components is listed
 	void list_all_components() {
 		printf("Debug info on all registry entries:\n");
-		for (ContainerInterface* reg : registry_list)
-			if (reg->size() > 0)
-				printf("%4d components of type %s\n", (int)reg->size(), typeid(*reg).name());
+		printf("%-32s %8s %8s %12s %12s %12s\n", "container", "count", "capacity", "components", "index", "heap");
+		for_each_container([](const char* name, auto& container) {
+			ContainerMemory memory = container.memory();
+			if (memory.capacity > 0)
+				printf("%-32s %8zu %8zu %12zu %12zu %12zu\n", name, memory.count, memory.capacity,
+					memory.component_bytes, memory.index_bytes, memory.heap_bytes);
+		});
+		printf("%-32s %8zu %8zu %12s %12zu %12s\n", "signatures", signatures.size(), signatures.capacity(), "",
+			signatures.capacity() * sizeof(uint64_t), "");
+		// the pooled part of the heap column, reserved in blocks and in use right now
+		printf("%-32s %8s %8s %12s %12s %12zu (%zu in use)\n", "pool", "", "", "", "", pool.reserved_bytes(), pool.used_bytes());
+		ContainerMemory total = memory_usage();
+		printf("%-32s %8zu %8zu %12zu %12zu %12zu\n", "total", total.count, total.capacity,
+			total.component_bytes, total.index_bytes, total.heap_bytes);
+		printf("%zu bytes in total\n", total.total());
 	}
 
 	void list_all_components_of(Entity e) {
 		printf("Debug info on components of entity %u:\n", (unsigned int)e);
-		for (ContainerInterface* reg : registry_list)
-			if (reg->has(e))
-				printf("type %s\n", typeid(*reg).name());
+		for_each_container([&](const char* name, auto& container) {
+			if (container.has(e))
+				printf("%s\n", name);
+		});
 	}
 
+	// Destroys the entity and everything attached to it: removes every component and hands the ids back for reuse
 	void remove_all_components_of(Entity e) {
-		for (ContainerInterface* reg : registry_list)
-			reg->remove(e);
+		// most entities have no children and need no batch
+		if (e.index() >= first_child.size() || first_child[e.index()] == NO_CHILD) {
+			destroy_entity(e);
+			return;
+		}
+		std::vector<Entity> batch(1, e);
+		destroy_batch(batch);
 	}
+
+	// Debug check that the signature of e agrees with what the containers actually store
+	bool signature_matches(Entity e) {
+		uint64_t signature = e.index() < signatures.size() ? signatures[e.index()] : 0;
+		bool matches = true;
+		for_each_container([&](const char*, auto& container) {
+			if (container.has(e) != ((signature & container.signature_bit) != 0))
+				matches = false;
+		});
+		return matches;
+	}
+
+	bool isAlive(Entity e) {
+		return Entity::isAlive(e);
+	}
+
+	// Entity hierarchy: attaches child to parent, update_hierarchy() then places the child at parent position + offset
+	// and destroying the parent destroys the child in the same batch
+	void attach(Entity child, Entity parent, vec3 offset = { 0, 0, 0 }) {
+		assert(child.getId() != parent.getId() && "An entity can't be its own parent");
+		relationships.insert(child, { parent, offset });
+	}
+
+	// Derives the position of every attached entity from its parent's in one pass, parents are placed before their
+	// children so nested attachments settle in the same pass
+	void update_hierarchy();
+
+	// Change tracking: containers stamp components with the current frame on insert and patch(), consumers of derived
+	// data remember current_frame() after catching up and later ask container.changed_since(that frame)
+	uint32_t current_frame() const {
+		return frame;
+	}
+
+	void advance_frame() {
+		frame++;
+	}
+
+	// Deferred structural changes: systems record them while iterating a container and they are applied together at
+	// the next flush_deferred() sync point, so the swap-remove never shuffles the container under the loop.
+	// Creating a handle with Entity::create() is always safe, only its components need to be deferred with defer_add.
+	template <typename Component>
+	void defer_add(Entity e, Component c) {
+		deferred_adds.push_back([e, c](ECSRegistry& registry) mutable {
+			// the entity may have been destroyed directly since the add was recorded
+			if (Entity::isAlive(e))
+				registry.container<Component>().insert(e, std::move(c));
+		});
+	}
+
+	// Takes over the adds a worker thread recorded in 'commands', they run at the next flush_deferred().
+	// Call on the thread that owns the registry once the worker is done with the buffer.
+	void merge(CommandBuffer& commands);
+
+	template <typename Component>
+	void defer_remove(Entity e) {
+		deferred_removes.push_back(std::make_pair((ContainerInterface*)&container<Component>(), e));
+	}
+
+	void defer_destroy(Entity e) {
+		deferred_destroys.push_back(e);
+	}
+
+	// Applies removes, then adds, then destroys, see tiny_ecs_registry.cpp
+	void flush_deferred();
+
+private:
+	// Orders relationships by depth (parents first) if anything was attached or detached since the last call
+	void sort_hierarchy();
+
+	// Destroys every entity of the batch plus their descendants, appended to the batch
+	void destroy_batch(std::vector<Entity>& batch);
+
+	// Only the containers in the entity's signature are visited
+	void destroy_entity(Entity e) {
+		if (!Entity::isAlive(e))
+			return;
+		uint64_t signature = e.index() < signatures.size() ? signatures[e.index()] : 0;
+		while (signature) {
+			containers_by_bit[lowest_set_bit(signature)]->remove(e);
+			signature &= signature - 1;
+		}
+		assert((e.index() >= signatures.size() || signatures[e.index()] == 0) && "Component signature out of sync with the containers");
+		Entity::release(e);
+	}
+
+	std::vector<std::function<void(ECSRegistry&)>> deferred_adds;
+	std::vector<std::pair<ContainerInterface*, Entity>> deferred_removes;
+	std::vector<Entity> deferred_destroys;
+};
+
+// Components of entities created away from the registry's thread. A worker creates handles with Entity::create(),
+// records their components here without touching the registry and hands the buffer to ECSRegistry::merge().
+class CommandBuffer
+{
+public:
+	template <typename Component>
+	void add(Entity e, Component c) {
+		adds.push_back([e, c](ECSRegistry& registry) mutable {
+			if (Entity::isAlive(e))
+				registry.container<Component>().insert(e, std::move(c));
+		});
+	}
+
+	size_t size() const {
+		return adds.size();
+	}
+
+private:
+	friend class ECSRegistry;
+	std::vector<std::function<void(ECSRegistry&)>> adds;
 };
 
+// The game's registry, systems are handed the registry they work on when constructed so headless
+// simulations or save snapshots can run on registries of their own
 extern ECSRegistry registry;
\ No newline at end of file
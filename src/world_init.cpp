@@ -7,24 +7,27 @@
 #include <sstream>
 
 // Boar creation
-Entity createBoar(vec2 pos)
+Entity createBoar(vec2 pos, ECSRegistry& registry)
 {
-	auto entity = Entity();
+	auto entity = Entity::create();
 
 	// Setting intial	 motion values
-	Motion& motion = registry.motions.emplace(entity);
+	Motion& motion = registry.emplace_motion(entity);
+	Shape& shape = registry.shapes.get(entity);
+	shape.layer = COLLISION_LAYER::ENEMY;
+	Presentation& presentation = registry.presentations.get(entity);
 	motion.position = vec3(pos, getElevation(pos) + BOAR_BB_HEIGHT / 2);
-	motion.angle = 0.f;
-	motion.scale = { BOAR_BB_WIDTH, BOAR_BB_HEIGHT };
-	motion.hitbox = { BOAR_BB_WIDTH, BOAR_BB_HEIGHT, BOAR_BB_HEIGHT / zConversionFactor };
-	motion.solid = true;
+	presentation.angle = 0.f;
+	presentation.scale = { BOAR_BB_WIDTH, BOAR_BB_HEIGHT };
+	shape.hitbox = { BOAR_BB_WIDTH, BOAR_BB_HEIGHT, BOAR_BB_HEIGHT / zConversionFactor };
+	shape.solid = true;
 
 	Enemy& enemy = registry.enemies.emplace(entity);
 	enemy.damage = BOAR_DAMAGE;
 	enemy.points = 2;
 	enemy.maxHealth = BOAR_HEALTH;
 	enemy.health = enemy.maxHealth;
-	enemy.type = "BOAR";
+	enemy.type = ENEMY_TYPE::BOAR;
 	motion.speed = BOAR_SPEED;
 
 	registry.boars.emplace(entity);
@@ -36,10 +39,10 @@ Entity createBoar(vec2 pos)
 	dasher.dashTimer = 0.0f;
 	dasher.dashDuration = 0.2f;
 
-	initBoarAnimationController(entity);
+	initBoarAnimationController(entity, registry);
 	registry.midgrounds.emplace(entity);
 
-	createHealthBar(entity);
+	createHealthBar(entity, registry);
 
 	registry.knockables.emplace(entity);
 	registry.knockers.emplace(entity);
@@ -50,32 +53,35 @@ Entity createBoar(vec2 pos)
 };
 
 // Barbarian creation
-Entity createBarbarian(vec2 pos)
+Entity createBarbarian(vec2 pos, ECSRegistry& registry)
 {
-	auto entity = Entity();
+	auto entity = Entity::create();
 
 	// Setting intial motion values
-	Motion& motion = registry.motions.emplace(entity);
+	Motion& motion = registry.emplace_motion(entity);
+	Shape& shape = registry.shapes.get(entity);
+	shape.layer = COLLISION_LAYER::ENEMY;
+	Presentation& presentation = registry.presentations.get(entity);
 	motion.position = vec3(pos, getElevation(pos) + BARBARIAN_BB_HEIGHT / 2);
-	motion.angle = 0.f;
-	motion.scale = { 32. * SPRITE_SCALE, 36. * SPRITE_SCALE};
-	motion.hitbox = { BARBARIAN_BB_WIDTH, BARBARIAN_BB_WIDTH, BARBARIAN_BB_HEIGHT / zConversionFactor };
-	motion.solid = true;
+	presentation.angle = 0.f;
+	presentation.scale = { 32. * SPRITE_SCALE, 36. * SPRITE_SCALE};
+	shape.hitbox = { BARBARIAN_BB_WIDTH, BARBARIAN_BB_WIDTH, BARBARIAN_BB_HEIGHT / zConversionFactor };
+	shape.solid = true;
 	
 	Enemy& enemy = registry.enemies.emplace(entity);
 	enemy.damage = BARBARIAN_DAMAGE;
 	enemy.cooldown = 1000;
 	enemy.maxHealth = BARBARIAN_HEALTH;
 	enemy.health = enemy.maxHealth;
-	enemy.type = "BARBARIAN";
+	enemy.type = ENEMY_TYPE::BARBARIAN;
 	motion.speed = BARBARIAN_SPEED;
 
 	registry.barbarians.emplace(entity);
 
-	initBarbarianAnimationController(entity);
+	initBarbarianAnimationController(entity, registry);
 	registry.midgrounds.emplace(entity);
 
-	createHealthBar(entity);
+	createHealthBar(entity, registry);
 
 	registry.knockables.emplace(entity);
 	registry.knockers.emplace(entity);
@@ -86,32 +92,35 @@ Entity createBarbarian(vec2 pos)
 };
 
 // Archer creation
-Entity createArcher(vec2 pos)
+Entity createArcher(vec2 pos, ECSRegistry& registry)
 {
-	auto entity = Entity();
+	auto entity = Entity::create();
 
 	// Setting intial motion values
-	Motion& motion = registry.motions.emplace(entity);
+	Motion& motion = registry.emplace_motion(entity);
+	Shape& shape = registry.shapes.get(entity);
+	shape.layer = COLLISION_LAYER::ENEMY;
+	Presentation& presentation = registry.presentations.get(entity);
 	motion.position = vec3(pos, getElevation(pos) + ARCHER_BB_HEIGHT / 2);
-	motion.angle = 0.f;
-	motion.scale = { ARCHER_BB_WIDTH, ARCHER_BB_HEIGHT };
-	motion.hitbox = { ARCHER_BB_WIDTH, ARCHER_BB_WIDTH, ARCHER_BB_HEIGHT / zConversionFactor };
-	motion.solid = true;
+	presentation.angle = 0.f;
+	presentation.scale = { ARCHER_BB_WIDTH, ARCHER_BB_HEIGHT };
+	shape.hitbox = { ARCHER_BB_WIDTH, ARCHER_BB_WIDTH, ARCHER_BB_HEIGHT / zConversionFactor };
+	shape.solid = true;
 
 	Enemy& enemy = registry.enemies.emplace(entity);
 	enemy.damage = ARCHER_DAMAGE;
 	enemy.maxHealth = ARCHER_HEALTH;
 	enemy.health = enemy.maxHealth;
 	enemy.points = 3;
-	enemy.type = "ARCHER";
+	enemy.type = ENEMY_TYPE::ARCHER;
 	motion.speed = ARCHER_SPEED;
 
 	registry.archers.emplace(entity);
 
-	initArcherAnimationController(entity);
+	initArcherAnimationController(entity, registry);
 	registry.midgrounds.emplace(entity);
 
-	createHealthBar(entity);
+	createHealthBar(entity, registry);
 
 	registry.knockables.emplace(entity);
 	auto& trappable = registry.trappables.emplace(entity);
@@ -121,7 +130,7 @@ Entity createArcher(vec2 pos)
 };
 
 // Bird creation (Flock of 5 birds)
-Entity createBirdFlock(vec2 pos)
+Entity createBirdFlock(vec2 pos, ECSRegistry& registry)
 {
     const int flockSize = 5;
     const float spacing = 20.f; 
@@ -131,7 +140,7 @@ Entity createBirdFlock(vec2 pos)
     {
 		// Spawn birds with spacing
 		vec2 birdPosition = pos + vec2(i % 2, (i % 2 + 1)) * spacing;
-		Entity bird = createBird(birdPosition);
+		Entity bird = createBird(birdPosition, registry);
 		if (i == 0) {
 			repBird = bird;
 		}
@@ -139,30 +148,33 @@ Entity createBirdFlock(vec2 pos)
     return repBird;
 }
 
-Entity createBird(vec2 birdPosition) {
-	auto entity = Entity();
+Entity createBird(vec2 birdPosition, ECSRegistry& registry) {
+	auto entity = Entity::create();
 
-	Motion& motion = registry.motions.emplace(entity);
+	Motion& motion = registry.emplace_motion(entity);
+	Shape& shape = registry.shapes.get(entity);
+	shape.layer = COLLISION_LAYER::ENEMY;
+	Presentation& presentation = registry.presentations.get(entity);
 	motion.position = vec3(birdPosition, TREE_BB_HEIGHT - BIRD_BB_WIDTH);
-	motion.angle = 0.f;
-	motion.scale = { 16 * SPRITE_SCALE, 16 * SPRITE_SCALE };
-	motion.hitbox = { BIRD_BB_WIDTH, BIRD_BB_HEIGHT, BIRD_BB_HEIGHT / zConversionFactor };
-	motion.solid = true;
+	presentation.angle = 0.f;
+	presentation.scale = { 16 * SPRITE_SCALE, 16 * SPRITE_SCALE };
+	shape.hitbox = { BIRD_BB_WIDTH, BIRD_BB_HEIGHT, BIRD_BB_HEIGHT / zConversionFactor };
+	shape.solid = true;
 
 	Enemy& enemy = registry.enemies.emplace(entity);
 	enemy.damage = BIRD_DAMAGE;
 	enemy.cooldown = 2000.f;
 	enemy.maxHealth = BIRD_HEALTH;
 	enemy.health = enemy.maxHealth;
-	enemy.type = "BIRD";
+	enemy.type = ENEMY_TYPE::BIRD;
 	motion.speed = BIRD_SPEED;
 
 	registry.birds.emplace(entity);
 
-	initBirdAnimationController(entity);
+	initBirdAnimationController(entity, registry);
 	registry.midgrounds.emplace(entity);
 
-	createHealthBar(entity);
+	createHealthBar(entity, registry);
 	registry.knockables.emplace(entity);
 	auto& trappable = registry.trappables.emplace(entity);
 	trappable.originalSpeed = BIRD_SPEED;
@@ -170,20 +182,23 @@ Entity createBird(vec2 birdPosition) {
 	return entity;
 }
 // Wizard creation
-Entity createWizard(vec2 pos) {
-	auto entity = Entity();
+Entity createWizard(vec2 pos, ECSRegistry& registry) {
+	auto entity = Entity::create();
 
 	// Setting intial motion values
-	Motion& motion = registry.motions.emplace(entity);
+	Motion& motion = registry.emplace_motion(entity);
+	Shape& shape = registry.shapes.get(entity);
+	shape.layer = COLLISION_LAYER::ENEMY;
+	Presentation& presentation = registry.presentations.get(entity);
 	motion.position = vec3(pos, getElevation(pos) + WIZARD_BB_HEIGHT / 2);
-	motion.angle = 0.f;
-	motion.scale = { 96 * SPRITE_SCALE,  35 * SPRITE_SCALE };
-	motion.hitbox = { WIZARD_BB_WIDTH, WIZARD_BB_WIDTH, WIZARD_BB_HEIGHT / zConversionFactor };
-	motion.solid = true;
+	presentation.angle = 0.f;
+	presentation.scale = { 96 * SPRITE_SCALE,  35 * SPRITE_SCALE };
+	shape.hitbox = { WIZARD_BB_WIDTH, WIZARD_BB_WIDTH, WIZARD_BB_HEIGHT / zConversionFactor };
+	shape.solid = true;
 
 	Enemy& enemy = registry.enemies.emplace(entity);
 	enemy.damage = WIZARD_DAMAGE;
-	enemy.type = "WIZARD";
+	enemy.type = ENEMY_TYPE::WIZARD;
 	enemy.cooldown = 8000.f; // 8s
 	enemy.maxHealth = WIZARD_HEALTH;
 	enemy.health = enemy.maxHealth;
@@ -192,10 +207,10 @@ Entity createWizard(vec2 pos) {
 
 	registry.wizards.emplace(entity);
 
-	initWizardAnimationController(entity);
+	initWizardAnimationController(entity, registry);
 	registry.midgrounds.emplace(entity);
 
-	createHealthBar(entity);
+	createHealthBar(entity, registry);
 
 	registry.knockables.emplace(entity);
 	auto& trappable = registry.trappables.emplace(entity);
@@ -204,26 +219,29 @@ Entity createWizard(vec2 pos) {
 	return entity;
 }
 
-Entity createTroll(vec2 pos)
+Entity createTroll(vec2 pos, ECSRegistry& registry)
 {
-	auto entity = Entity();
+	auto entity = Entity::create();
 
 	// Setting intial motion values
-	Motion& motion = registry.motions.emplace(entity);
+	Motion& motion = registry.emplace_motion(entity);
+	Shape& shape = registry.shapes.get(entity);
+	shape.layer = COLLISION_LAYER::ENEMY;
+	Presentation& presentation = registry.presentations.get(entity);
 	motion.position = vec3(pos, getElevation(pos) + TROLL_BB_HEIGHT / 2);
-	motion.angle = 0.f;
-	motion.scale = { TROLL_BB_WIDTH, TROLL_BB_HEIGHT };
-	motion.hitbox = { TROLL_BB_WIDTH * 0.9, TROLL_BB_WIDTH * 0.9, TROLL_BB_HEIGHT * 0.9 / zConversionFactor };
-	motion.solid = true;
+	presentation.angle = 0.f;
+	presentation.scale = { TROLL_BB_WIDTH, TROLL_BB_HEIGHT };
+	shape.hitbox = { TROLL_BB_WIDTH * 0.9, TROLL_BB_WIDTH * 0.9, TROLL_BB_HEIGHT * 0.9 / zConversionFactor };
+	shape.solid = true;
 	if (registry.players.entities.size() > 0) {
 		vec2 playerPosition = vec2(registry.motions.get(registry.players.entities.at(0)).position);
-		motion.facing = normalize(playerPosition - pos);
+		presentation.facing = normalize(playerPosition - pos);
 	}
 
 	Enemy& enemy = registry.enemies.emplace(entity);
 	enemy.damage = TROLL_DAMAGE;
 	enemy.points = 10;
-	enemy.type = "TROLL";
+	enemy.type = ENEMY_TYPE::TROLL;
 	enemy.cooldown = 0;
 	motion.speed = TROLL_SPEED;
 	enemy.maxHealth = TROLL_HEALTH;
@@ -233,44 +251,47 @@ Entity createTroll(vec2 pos)
 
 	registry.midgrounds.emplace(entity);
 
-	createHealthBar(entity);
+	createHealthBar(entity, registry);
 
 	auto& trappable = registry.trappables.emplace(entity);
 	trappable.originalSpeed = TROLL_SPEED;
 	Knocker& knocker = registry.knockers.emplace(entity);
 	knocker.strength = 1.5f;
 
-	initTrollAnimationController(entity);
+	initTrollAnimationController(entity, registry);
 
 	return entity;
 };
 
 // Bomber creation
-Entity createBomber(vec2 pos)
+Entity createBomber(vec2 pos, ECSRegistry& registry)
 {
-	auto entity = Entity();
+	auto entity = Entity::create();
 
 	// Setting intial motion values
-	Motion& motion = registry.motions.emplace(entity);
+	Motion& motion = registry.emplace_motion(entity);
+	Shape& shape = registry.shapes.get(entity);
+	shape.layer = COLLISION_LAYER::ENEMY;
+	Presentation& presentation = registry.presentations.get(entity);
 	motion.position = vec3(pos, getElevation(pos) + BOMBER_BB_HEIGHT / 2);
-	motion.angle = 0.f;
-	motion.scale = { BOMBER_BB_WIDTH, BOMBER_BB_HEIGHT };
-	motion.hitbox = { BOMBER_BB_WIDTH, BOMBER_BB_WIDTH, BOMBER_BB_HEIGHT / zConversionFactor };
-	motion.solid = true;
+	presentation.angle = 0.f;
+	presentation.scale = { BOMBER_BB_WIDTH, BOMBER_BB_HEIGHT };
+	shape.hitbox = { BOMBER_BB_WIDTH, BOMBER_BB_WIDTH, BOMBER_BB_HEIGHT / zConversionFactor };
+	shape.solid = true;
 
 	Enemy& enemy = registry.enemies.emplace(entity);
 	enemy.damage = BOMBER_DAMAGE;
-	enemy.type = "BOMBER";
+	enemy.type = ENEMY_TYPE::BOMBER;
 	enemy.maxHealth = BOMBER_HEALTH;
 	enemy.health = enemy.maxHealth;
 	motion.speed = BOMBER_SPEED;
 
 	registry.bombers.emplace(entity);
 
-	initBomberAnimationController(entity);
+	initBomberAnimationController(entity, registry);
 	registry.midgrounds.emplace(entity);
 
-	createHealthBar(entity);
+	createHealthBar(entity, registry);
 
 	registry.knockables.emplace(entity);
 	auto& trappable = registry.trappables.emplace(entity);
@@ -280,33 +301,36 @@ Entity createBomber(vec2 pos)
 };
 
 // Collectible trap creation
-Entity createCollectibleTrap(vec2 pos)
+Entity createCollectibleTrap(vec2 pos, ECSRegistry& registry)
 {
-	auto entity = Entity();
+	auto entity = Entity::create();
 	CollectibleTrap& collectibleTrap = registry.collectibleTraps.emplace(entity);
 	int random = rand() % 2;
-	Motion& motion = registry.motions.emplace(entity);
+	Motion& motion = registry.emplace_motion(entity);
+	Shape& shape = registry.shapes.get(entity);
+	shape.layer = COLLISION_LAYER::COLLECTIBLE;
+	Presentation& presentation = registry.presentations.get(entity);
 
 	if (random >= 0.8) {
-		collectibleTrap.type = "phantom_trap";
-		initPhantomTrapAnimationController(entity);
+		collectibleTrap.type = TRAP_TYPE::PHANTOM;
+		initPhantomTrapAnimationController(entity, registry);
 		Collectible& collectible = registry.collectibles.emplace(entity);
-		collectible.type = "PHANTOM_TRAP";
+		collectible.type = COLLECTIBLE_TYPE::PHANTOM_TRAP;
 		
 		motion.position = vec3(pos, getElevation(pos) + PHANTOM_TRAP_COLLECTABLE_BB_HEIGHT / 2);
-		motion.angle = 0.f;
-		motion.scale = { PHANTOM_TRAP_COLLECTABLE_BB_WIDTH, PHANTOM_TRAP_COLLECTABLE_BB_HEIGHT };
-		motion.hitbox = { PHANTOM_TRAP_COLLECTABLE_BB_WIDTH, PHANTOM_TRAP_COLLECTABLE_BB_WIDTH, PHANTOM_TRAP_COLLECTABLE_BB_HEIGHT / zConversionFactor };
+		presentation.angle = 0.f;
+		presentation.scale = { PHANTOM_TRAP_COLLECTABLE_BB_WIDTH, PHANTOM_TRAP_COLLECTABLE_BB_HEIGHT };
+		shape.hitbox = { PHANTOM_TRAP_COLLECTABLE_BB_WIDTH, PHANTOM_TRAP_COLLECTABLE_BB_WIDTH, PHANTOM_TRAP_COLLECTABLE_BB_HEIGHT / zConversionFactor };
 	}
 	else {
-		initTrapBottleAnimationController(entity);
+		initTrapBottleAnimationController(entity, registry);
 		Collectible& collectible = registry.collectibles.emplace(entity);
-		collectible.type = "TRAP";
+		collectible.type = COLLECTIBLE_TYPE::TRAP;
 
 		motion.position = vec3(pos, getElevation(pos) + TRAP_COLLECTABLE_BB_HEIGHT / 2);
-		motion.angle = 0.f;
-		motion.scale = { TRAP_COLLECTABLE_BB_WIDTH, TRAP_COLLECTABLE_BB_HEIGHT };
-		motion.hitbox = { TRAP_COLLECTABLE_BB_WIDTH, TRAP_COLLECTABLE_BB_WIDTH, TRAP_COLLECTABLE_BB_HEIGHT / zConversionFactor };
+		presentation.angle = 0.f;
+		presentation.scale = { TRAP_COLLECTABLE_BB_WIDTH, TRAP_COLLECTABLE_BB_HEIGHT };
+		shape.hitbox = { TRAP_COLLECTABLE_BB_WIDTH, TRAP_COLLECTABLE_BB_WIDTH, TRAP_COLLECTABLE_BB_HEIGHT / zConversionFactor };
 	}
 
 	registry.midgrounds.emplace(entity);
@@ -314,44 +338,47 @@ Entity createCollectibleTrap(vec2 pos)
 	return entity;
 };
 
-Entity createCollectible(vec2 pos, TEXTURE_ASSET_ID assetID)
+Entity createCollectible(vec2 pos, TEXTURE_ASSET_ID assetID, ECSRegistry& registry)
 {
-	auto entity = Entity();
+	auto entity = Entity::create();
 
-	Motion& motion = registry.motions.emplace(entity);
-	motion.angle = 0.f;
+	Motion& motion = registry.emplace_motion(entity);
+	Shape& shape = registry.shapes.get(entity);
+	shape.layer = COLLISION_LAYER::COLLECTIBLE;
+	Presentation& presentation = registry.presentations.get(entity);
+	presentation.angle = 0.f;
 
 	Collectible& collectible = registry.collectibles.emplace(entity);
 
 	switch(assetID) {
 		case TEXTURE_ASSET_ID::HEART:
-			motion.scale = { HEART_BB_WIDTH, HEART_BB_WIDTH };
-			initHeartAnimationController(entity);
+			presentation.scale = { HEART_BB_WIDTH, HEART_BB_WIDTH };
+			initHeartAnimationController(entity, registry);
 			break;
 		case TEXTURE_ASSET_ID::TRAP:
-			motion.scale = { TRAP_COLLECTABLE_BB_WIDTH, TRAP_COLLECTABLE_BB_HEIGHT };
-			initTrapBottleAnimationController(entity);
+			presentation.scale = { TRAP_COLLECTABLE_BB_WIDTH, TRAP_COLLECTABLE_BB_HEIGHT };
+			initTrapBottleAnimationController(entity, registry);
 			break;
 		case TEXTURE_ASSET_ID::BOW:
-			motion.scale = { BOW_BB_WIDTH, BOW_BB_HEIGHT };
+			presentation.scale = { BOW_BB_WIDTH, BOW_BB_HEIGHT };
 			registry.bows.emplace(entity);
 			collectible.duration = 10000;
-			collectible.type = "BOW";
-			initBowAnimationController(entity);
+			collectible.type = COLLECTIBLE_TYPE::BOW;
+			initBowAnimationController(entity, registry);
 			break;
 		case TEXTURE_ASSET_ID::BOMB:
-			motion.scale = { BOMB_BB_WIDTH, BOMB_BB_HEIGHT };
+			presentation.scale = { BOMB_BB_WIDTH, BOMB_BB_HEIGHT };
 			registry.collectibleBombs.emplace(entity);
 			collectible.duration = 10000;
-			collectible.type = "BOMB";
-			initBombAnimationController(entity);
+			collectible.type = COLLECTIBLE_TYPE::BOMB;
+			initBombAnimationController(entity, registry);
 			break;
 		default:
 			break;
 	}
 
-	motion.position = vec3(pos, getElevation(pos) + motion.scale.y / 2);
-	motion.hitbox = { motion.scale.x, motion.scale.x, motion.scale.y / zConversionFactor };
+	motion.position = vec3(pos, getElevation(pos) + presentation.scale.y / 2);
+	shape.hitbox = { presentation.scale.x, presentation.scale.x, presentation.scale.y / zConversionFactor };
 
 	registry.midgrounds.emplace(entity);
 
@@ -359,34 +386,38 @@ Entity createCollectible(vec2 pos, TEXTURE_ASSET_ID assetID)
 };
 
 // Heart creation
-Entity createHeart(vec2 pos)
+Entity createHeart(vec2 pos, ECSRegistry& registry)
 {
-	auto entity = Entity();
+	auto entity = Entity::create();
 	registry.hearts.emplace(entity);
 
 	// Setting intial motion values
-	Motion& fixed = registry.motions.emplace(entity);
+	Motion& fixed = registry.emplace_motion(entity);
+	Shape& fixedShape = registry.shapes.get(entity);
+	fixedShape.layer = COLLISION_LAYER::COLLECTIBLE;
+	Presentation& fixedPresentation = registry.presentations.get(entity);
 	fixed.position = vec3(pos, getElevation(pos) + HEART_BB_WIDTH / 2);
-	fixed.angle = 0.f;
-	fixed.scale = { HEART_BB_WIDTH, HEART_BB_WIDTH };
-	fixed.hitbox = { HEART_BB_WIDTH, HEART_BB_WIDTH, HEART_BB_HEIGHT / zConversionFactor };
+	fixedPresentation.angle = 0.f;
+	fixedPresentation.scale = { HEART_BB_WIDTH, HEART_BB_WIDTH };
+	fixedShape.hitbox = { HEART_BB_WIDTH, HEART_BB_WIDTH, HEART_BB_HEIGHT / zConversionFactor };
 
 	Collectible& collectible = registry.collectibles.emplace(entity);
-	collectible.type = "HEART";
+	collectible.type = COLLECTIBLE_TYPE::HEART;
 
-	initHeartAnimationController(entity);
+	initHeartAnimationController(entity, registry);
 
 	registry.midgrounds.emplace(entity);
 
 	return entity;
 };
 
-Entity createCollected(TEXTURE_ASSET_ID assetID)
+Entity createCollected(TEXTURE_ASSET_ID assetID, ECSRegistry& registry)
 {
-	auto entity = Entity();
+	auto entity = Entity::create();
 	vec2 scale;
 
-	Motion& motion = registry.motions.emplace(entity);
+	registry.emplace_motion(entity);
+	Presentation& presentation = registry.presentations.get(entity);
 	switch(assetID) {
 		case TEXTURE_ASSET_ID::HEART:
 			scale = { HEART_BB_WIDTH * 0.5, HEART_BB_WIDTH * 0.5 };
@@ -404,7 +435,14 @@ Entity createCollected(TEXTURE_ASSET_ID assetID)
 			scale = { BOMB_BB_WIDTH * 0.5, BOMB_BB_HEIGHT * 0.5 };
 			break;
 	}
-	motion.scale = scale;
+	presentation.scale = scale;
+
+	// place above character, next to its health bar
+	Entity playerE = registry.players.entities[0];
+	Presentation& playerPresentation = registry.presentations.get(playerE);
+	HealthBar& hpBar = registry.healthBars.get(playerE);
+	float topOffset = 30;
+	registry.attach(entity, playerE, { hpBar.width / 2 + 15, 0, visualToWorldY(playerPresentation.scale.y) / 2 + topOffset });
 
 	registry.collected.emplace(entity);
 	registry.midgrounds.emplace(entity);
@@ -421,16 +459,19 @@ Entity createCollected(TEXTURE_ASSET_ID assetID)
 };
 
 // Damage trap creation
-Entity createDamageTrap(vec2 pos)
+Entity createDamageTrap(vec2 pos, ECSRegistry& registry)
 {
-	auto entity = Entity();
+	auto entity = Entity::create();
 
 	// Setting intial motion values
-	Motion& motion = registry.motions.emplace(entity);
+	Motion& motion = registry.emplace_motion(entity);
+	Shape& shape = registry.shapes.get(entity);
+	shape.layer = COLLISION_LAYER::TRAP;
+	Presentation& presentation = registry.presentations.get(entity);
 	motion.position = vec3(pos, getElevation(pos) + TRAP_BB_HEIGHT / 2);
-	motion.angle = 0.f;
-	motion.scale = { TRAP_BB_WIDTH, TRAP_BB_HEIGHT };
-	motion.hitbox = { TRAP_BB_WIDTH, TRAP_BB_WIDTH, TRAP_BB_HEIGHT / zConversionFactor };
+	presentation.angle = 0.f;
+	presentation.scale = { TRAP_BB_WIDTH, TRAP_BB_HEIGHT };
+	shape.hitbox = { TRAP_BB_WIDTH, TRAP_BB_WIDTH, TRAP_BB_HEIGHT / zConversionFactor };
 
 	// Setting initial trap values
 	registry.traps.emplace(entity);
@@ -448,16 +489,19 @@ Entity createDamageTrap(vec2 pos)
 	return entity;
 };
 
-Entity createPhantomTrap(vec2 pos) {
-	auto entity = Entity();
+Entity createPhantomTrap(vec2 pos, ECSRegistry& registry) {
+	auto entity = Entity::create();
 
 	// Setting intial motion values
-	Motion& motion = registry.motions.emplace(entity);
+	Motion& motion = registry.emplace_motion(entity);
+	Shape& shape = registry.shapes.get(entity);
+	shape.layer = COLLISION_LAYER::NONE;
+	Presentation& presentation = registry.presentations.get(entity);
 	motion.position = vec3(pos, getElevation(pos) + PHANTOM_TRAP_BB_HEIGHT / 2);
-	motion.angle = 0.f;
-	motion.scale = { PHANTOM_TRAP_BB_WIDTH, PHANTOM_TRAP_BB_HEIGHT };
-	motion.hitbox = { PHANTOM_TRAP_BB_WIDTH, PHANTOM_TRAP_BB_WIDTH, PHANTOM_TRAP_BB_HEIGHT / zConversionFactor };
-	motion.solid = false;
+	presentation.angle = 0.f;
+	presentation.scale = { PHANTOM_TRAP_BB_WIDTH, PHANTOM_TRAP_BB_HEIGHT };
+	shape.hitbox = { PHANTOM_TRAP_BB_WIDTH, PHANTOM_TRAP_BB_WIDTH, PHANTOM_TRAP_BB_HEIGHT / zConversionFactor };
+	shape.solid = false;
 
 	// Setting initial trap values
 	PhantomTrap& phantomTrap = registry.phantomTraps.emplace(entity);
@@ -478,15 +522,18 @@ Entity createPhantomTrap(vec2 pos) {
 
 
 // Create Player Jeff
-Entity createJeff(vec2 position)
+Entity createJeff(vec2 position, ECSRegistry& registry)
 {
-	auto entity = Entity();
+	auto entity = Entity::create();
 
 	// Initialize the motion
-	auto& motion = registry.motions.emplace(entity);
-	motion.angle = 0.f;
+	auto& motion = registry.emplace_motion(entity);
+	Shape& shape = registry.shapes.get(entity);
+	shape.layer = COLLISION_LAYER::PLAYER;
+	Presentation& presentation = registry.presentations.get(entity);
+	presentation.angle = 0.f;
 	motion.position = vec3(position, getElevation(position) + JEFF_BB_HEIGHT / 2);
-	motion.facing = { 1, 0 };
+	presentation.facing = { 1, 0 };
 
 	//Initialize stamina
 	auto& stamina = registry.staminas.emplace(entity);
@@ -504,16 +551,16 @@ Entity createJeff(vec2 position)
 	dasher.dashDuration = 0.2f;
 
 	// Setting initial values, scale is negative to make it face the opposite way
-	motion.scale = vec2({ 32. * SPRITE_SCALE, 32. * SPRITE_SCALE});
-	motion.hitbox = { JEFF_BB_WIDTH, JEFF_BB_WIDTH, JEFF_BB_HEIGHT / zConversionFactor };
-	motion.solid = true;
+	presentation.scale = vec2({ 32. * SPRITE_SCALE, 32. * SPRITE_SCALE});
+	shape.hitbox = { JEFF_BB_WIDTH, JEFF_BB_WIDTH, JEFF_BB_HEIGHT / zConversionFactor };
+	shape.solid = true;
 	motion.speed = PLAYER_SPEED;
 
 	auto& jumper = registry.jumpers.emplace(entity);
 	jumper.speed = 2;
 
 	// Animation
-	initJeffAnimationController(entity);
+	initJeffAnimationController(entity, registry);
 	registry.midgrounds.emplace(entity);
 
 	registry.knockables.emplace(entity);
@@ -530,27 +577,30 @@ Entity createJeff(vec2 position)
 	pointLight.linear = .005;
 	pointLight.quadratic = 0.f;
 
-	createHealthBar(entity);
-	createStaminaBar(entity);
+	createHealthBar(entity, registry);
+	createStaminaBar(entity, registry);
 	
 	return entity;
 }
 
-Entity createTree(RenderSystem* renderer, vec2 pos)
+Entity createTree(RenderSystem* renderer, vec2 pos, ECSRegistry& registry)
 {
-	auto entity = Entity();
+	auto entity = Entity::create();
 
 	// Store a reference to the potentially re-used mesh object
 	Mesh& mesh = renderer->getMesh(GEOMETRY_BUFFER_ID::TREE);
 	registry.meshPtrs.emplace(entity, &mesh);
 
 	// Setting initial motion values
-	Motion& motion = registry.motions.emplace(entity);
+	Motion& motion = registry.emplace_motion(entity);
+	Shape& shape = registry.shapes.get(entity);
+	shape.layer = COLLISION_LAYER::OBSTACLE;
+	Presentation& presentation = registry.presentations.get(entity);
 	motion.position = vec3(pos, 0);
-	motion.angle = 0.f;
-	motion.scale = { TREE_BB_WIDTH, TREE_BB_HEIGHT };
-	motion.hitbox = { TREE_BB_WIDTH, TREE_BB_WIDTH, TREE_BB_HEIGHT / zConversionFactor };
-	motion.solid = true;
+	presentation.angle = 0.f;
+	presentation.scale = { TREE_BB_WIDTH, TREE_BB_HEIGHT };
+	shape.hitbox = { TREE_BB_WIDTH, TREE_BB_WIDTH, TREE_BB_HEIGHT / zConversionFactor };
+	shape.solid = true;
 
 	registry.renderRequests.insert(
 		entity, {
@@ -574,20 +624,24 @@ Entity createTree(RenderSystem* renderer, vec2 pos)
 	}*/
 
 	registry.obstacles.emplace(entity);
+	registry.staticBodies.emplace(entity);
 	registry.midgrounds.emplace(entity);
 
 	return entity;
 }
 
-Entity createArrow(vec3 pos, vec3 velocity, int damage)
+Entity createArrow(vec3 pos, vec3 velocity, int damage, ECSRegistry& registry)
 {
-	auto entity = Entity();
+	auto entity = Entity::create();
 
-	Motion& motion = registry.motions.emplace(entity);
+	Motion& motion = registry.emplace_motion(entity);
+	Shape& shape = registry.shapes.get(entity);
+	shape.layer = COLLISION_LAYER::PROJECTILE;
+	Presentation& presentation = registry.presentations.get(entity);
 	motion.position = pos;
 	motion.velocity = velocity;
-	motion.scale = { ARROW_BB_WIDTH, ARROW_BB_HEIGHT };
-	motion.hitbox = { ARROW_BB_WIDTH, ARROW_BB_HEIGHT, ARROW_BB_HEIGHT / zConversionFactor };
+	presentation.scale = { ARROW_BB_WIDTH, ARROW_BB_HEIGHT };
+	shape.hitbox = { ARROW_BB_WIDTH, ARROW_BB_HEIGHT, ARROW_BB_HEIGHT / zConversionFactor };
 	
 	registry.projectiles.emplace(entity);
 	Damaging& damaging = registry.damagings.emplace(entity);
@@ -605,18 +659,21 @@ Entity createArrow(vec3 pos, vec3 velocity, int damage)
 	return entity;
 }
 
-Entity createFireball(vec3 pos, vec2 direction) {
-	auto entity = Entity();
+Entity createFireball(vec3 pos, vec2 direction, ECSRegistry& registry) {
+	auto entity = Entity::create();
 
-	Motion& motion = registry.motions.emplace(entity);
+	Motion& motion = registry.emplace_motion(entity);
+	Shape& shape = registry.shapes.get(entity);
+	shape.layer = COLLISION_LAYER::DAMAGING;
+	Presentation& presentation = registry.presentations.get(entity);
 	motion.position = pos;
 	motion.velocity = vec3(0);
-	motion.angle = atan2(direction.y, direction.x);
-	motion.scale = { FIREBALL_BB_WIDTH, FIREBALL_BB_HEIGHT };
-	motion.hitbox = { FIREBALL_HITBOX_WIDTH, FIREBALL_HITBOX_WIDTH, FIREBALL_HITBOX_WIDTH };
+	presentation.angle = atan2(direction.y, direction.x);
+	presentation.scale = { FIREBALL_BB_WIDTH, FIREBALL_BB_HEIGHT };
+	shape.hitbox = { FIREBALL_HITBOX_WIDTH, FIREBALL_HITBOX_WIDTH, FIREBALL_HITBOX_WIDTH };
 
 	Damaging& damaging = registry.damagings.emplace(entity);
-	damaging.type = "fireball";
+	damaging.type = DAMAGING_TYPE::FIREBALL;
 	damaging.damage = 30;
 	registry.midgrounds.emplace(entity);
 
@@ -629,13 +686,13 @@ Entity createFireball(vec3 pos, vec2 direction) {
 	pointLight.linear = 0.017;
 	pointLight.quadratic = 0.00f;
 
-	initFireballAnimationController(entity);
+	initFireballAnimationController(entity, registry);
 	return entity;
 }
 
 
-Entity createEquipped(TEXTURE_ASSET_ID assetId) {
-	auto entity = Entity();
+Entity createEquipped(TEXTURE_ASSET_ID assetId, ECSRegistry& registry) {
+	auto entity = Entity::create();
 	vec2 scale;
 
 	switch (assetId) {
@@ -647,8 +704,8 @@ Entity createEquipped(TEXTURE_ASSET_ID assetId) {
 		break;
 		case TEXTURE_ASSET_ID::BOW: {
 			scale = { BOW_BB_WIDTH * 1.25, BOW_BB_HEIGHT * 1.25};
-			AnimationController& ac = initBowAnimationController(entity);
-			ac.changeState(entity, AnimationState::Default);	
+			AnimationController& ac = initBowAnimationController(entity, registry);
+			ac.changeState(entity, AnimationState::Default, registry);	
 		}
 		break;
 		case TEXTURE_ASSET_ID::BOMB:
@@ -666,26 +723,33 @@ Entity createEquipped(TEXTURE_ASSET_ID assetId) {
 			});
 	}
 
-	Motion& motion = registry.motions.emplace(entity);
-	motion.scale = scale;
+	registry.emplace_motion(entity);
+	Presentation& presentation = registry.presentations.get(entity);
+	presentation.scale = scale;
+
+	// held by the player, the offset towards the mouse is set every frame by WorldSystem::updateEquippedPosition
+	registry.attach(entity, registry.players.entities[0]);
 
 	registry.midgrounds.emplace(entity);
 
 	return entity;
 }
 
-Entity createLightning(vec2 pos) {
-	auto entity = Entity();
+Entity createLightning(vec2 pos, ECSRegistry& registry) {
+	auto entity = Entity::create();
 
-	Motion& motion = registry.motions.emplace(entity);
+	Motion& motion = registry.emplace_motion(entity);
+	Shape& shape = registry.shapes.get(entity);
+	shape.layer = COLLISION_LAYER::DAMAGING;
+	Presentation& presentation = registry.presentations.get(entity);
 	
 	// add half the hitbox size to the vec2 pos
-	motion.scale = { LIGHTNING_BB_WIDTH, LIGHTNING_BB_HEIGHT };
-	motion.hitbox = { LIGHTNING_BB_WIDTH, LIGHTNING_BB_WIDTH, LIGHTNING_BB_HEIGHT / zConversionFactor };
-	motion.position = vec3(pos, motion.hitbox.z / 2);
+	presentation.scale = { LIGHTNING_BB_WIDTH, LIGHTNING_BB_HEIGHT };
+	shape.hitbox = { LIGHTNING_BB_WIDTH, LIGHTNING_BB_WIDTH, LIGHTNING_BB_HEIGHT / zConversionFactor };
+	motion.position = vec3(pos, shape.hitbox.z / 2);
 
 	Damaging& damaging = registry.damagings.emplace(entity);
-	damaging.type = "lightning";
+	damaging.type = DAMAGING_TYPE::LIGHTNING;
 	damaging.damage = 20;
 	registry.midgrounds.emplace(entity);
 
@@ -701,22 +765,27 @@ Entity createLightning(vec2 pos) {
 	pointLight.linear = .005;
 	pointLight.quadratic = 0.f;
 
-	initLightningAnimationController(entity);
+	initLightningAnimationController(entity, registry);
 	return entity;
 }
 
-void createStaminaBar(Entity characterEntity) {
-	auto meshE = Entity();
+void createStaminaBar(Entity characterEntity, ECSRegistry& registry) {
+	auto meshE = Entity::create();
 
 	const float width = 60.0f;
 	const float height = 10.0f;
 
-	Motion& characterMotion = registry.motions.get(characterEntity);
+	Presentation& characterPresentation = registry.presentations.get(characterEntity);
 
-	Motion& motion = registry.motions.emplace(meshE);
+	Motion& motion = registry.emplace_motion(meshE);
+	Presentation& presentation = registry.presentations.get(meshE);
 	// position does not need to be initialized as it will always be set to match the associated entity
-	motion.angle = 0.f;
-	motion.scale = { width, height };
+	presentation.angle = 0.f;
+	presentation.scale = { width, height };
+	// place above character
+	float topOffset = 25;
+	vec3 offset = { -width / 2, 0, visualToWorldY(characterPresentation.scale.y) / 2 + topOffset };
+	registry.attach(meshE, characterEntity, offset);
 
 	vec4 blue = vec4(0.0f, 0.0f, 1.0f, 1.0f);
 	registry.colours.insert(meshE, blue);
@@ -731,10 +800,11 @@ void createStaminaBar(Entity characterEntity) {
 	registry.midgrounds.emplace(meshE);
 
 	// HP bar frame
-	auto frameE = Entity();
-	Motion& frameM = registry.motions.emplace(frameE);
+	auto frameE = Entity::create();
+	Motion& frameM = registry.emplace_motion(frameE);
+	Presentation& framePresentation = registry.presentations.get(frameE);
 	frameM.position = motion.position;
-	frameM.scale = { width, height };
+	framePresentation.scale = { width, height };
 	registry.colours.insert(frameE, blue);
 	registry.renderRequests.insert(
 		frameE,
@@ -745,14 +815,15 @@ void createStaminaBar(Entity characterEntity) {
 			PRIMITIVE_TYPE::LINES,
 		});
 	registry.midgrounds.emplace(frameE);
+	registry.attach(frameE, characterEntity, offset);
 
 	StaminaBar& staminabar = registry.staminaBars.emplace(characterEntity, meshE, frameE);
 	staminabar.width = width;
 	staminabar.height = height;
 }
 
-void createPlayerUIStaminaBar(vec2 windowSize) {
-	auto meshE = Entity();
+void createPlayerUIStaminaBar(vec2 windowSize, ECSRegistry& registry) {
+	auto meshE = Entity::create();
 	const float width = 150.0f;
 	const float height = 20.0f;
 
@@ -774,7 +845,7 @@ void createPlayerUIStaminaBar(vec2 windowSize) {
 		});
 
 	// Bar frame
-	auto frameE = Entity();
+	auto frameE = Entity::create();
 	Foreground& frameFg = registry.foregrounds.emplace(frameE);
 	frameFg.position = position;
 	frameFg.scale = { width, height };
@@ -788,7 +859,7 @@ void createPlayerUIStaminaBar(vec2 windowSize) {
 			PRIMITIVE_TYPE::LINES,
 		});
 
-	auto textE = Entity();
+	auto textE = Entity::create();
 	registry.texts.emplace(textE);
 	Foreground& textFg = registry.foregrounds.emplace(textE);
 	textFg.scale = {0.8f, 0.8f};
@@ -806,8 +877,8 @@ void createPlayerUIStaminaBar(vec2 windowSize) {
 	registry.playerResourceUI.staminaTextEntity = textE;
 }
 
-void createPlayerUIHealthBar(vec2 windowSize) {
-	auto meshE = Entity();
+void createPlayerUIHealthBar(vec2 windowSize, ECSRegistry& registry) {
+	auto meshE = Entity::create();
 	vec2 maxSize = registry.playerResourceUI.hpMaxSize;
 
 	vec2 position = {210.0f, windowSize.y - 50.0f};
@@ -829,7 +900,7 @@ void createPlayerUIHealthBar(vec2 windowSize) {
 		});
 
 	// Bar frame
-	auto frameE = Entity();
+	auto frameE = Entity::create();
 	Foreground& frameFg = registry.foregrounds.emplace(frameE);
 	frameFg.position = position;
 	frameFg.scale = maxSize;
@@ -843,7 +914,7 @@ void createPlayerUIHealthBar(vec2 windowSize) {
 			PRIMITIVE_TYPE::LINES,
 		});
 
-	auto textE = Entity();
+	auto textE = Entity::create();
 	registry.texts.emplace(textE);
 	Foreground& textFg = registry.foregrounds.emplace(textE);
 	textFg.scale = {0.8f, 0.8f};
@@ -860,18 +931,26 @@ void createPlayerUIHealthBar(vec2 windowSize) {
 	registry.playerResourceUI.hpTextEntity = textE;
 }
 
-void createHealthBar(Entity characterEntity) {
-	auto meshEntity = Entity();
+void createHealthBar(Entity characterEntity, ECSRegistry& registry) {
+	auto meshEntity = Entity::create();
 
 	const float width = 60.0f;
 	const float height = 10.0f;
 
-	Motion& characterMotion = registry.motions.get(characterEntity);
+	Presentation& characterPresentation = registry.presentations.get(characterEntity);
 
-	Motion& motion = registry.motions.emplace(meshEntity);
+	Motion& motion = registry.emplace_motion(meshEntity);
+	Presentation& presentation = registry.presentations.get(meshEntity);
 	// position does not need to be initialized as it will always be set to match the associated entity
-	motion.angle = 0.f;
-	motion.scale = { width, height };
+	presentation.angle = 0.f;
+	presentation.scale = { width, height };
+	// place above character, the player's sits above its stamina bar
+	float topOffset = 25;
+	if (registry.players.has(characterEntity)) {
+		topOffset += height + 5;
+	}
+	vec3 offset = { -width / 2, 0, visualToWorldY(characterPresentation.scale.y) / 2 + topOffset };
+	registry.attach(meshEntity, characterEntity, offset);
 
 	vec4 color = vec4(1, 0, 0, 0.4);
 	registry.colours.insert(meshEntity, color);
@@ -886,10 +965,11 @@ void createHealthBar(Entity characterEntity) {
 	registry.midgrounds.emplace(meshEntity);
 
 	// HP bar frame
-	auto frameEntity = Entity();
-	Motion& frameM = registry.motions.emplace(frameEntity);
+	auto frameEntity = Entity::create();
+	Motion& frameM = registry.emplace_motion(frameEntity);
+	Presentation& framePresentation = registry.presentations.get(frameEntity);
 	frameM.position = motion.position;
-	frameM.scale = { width, height };
+	framePresentation.scale = { width, height };
 	registry.colours.insert(frameEntity, color);
 	registry.renderRequests.insert(
 		frameEntity,
@@ -900,23 +980,25 @@ void createHealthBar(Entity characterEntity) {
 			PRIMITIVE_TYPE::LINES,
 		});
 	registry.midgrounds.emplace(frameEntity);
+	registry.attach(frameEntity, characterEntity, offset);
 
 	HealthBar& hpbar = registry.healthBars.emplace(characterEntity, meshEntity, frameEntity);
 	hpbar.width = width;
 	hpbar.height = height;
 }
 
-Entity createTargetArea(vec3 position) {
-	auto entity = Entity();
+Entity createTargetArea(vec3 position, ECSRegistry& registry) {
+	auto entity = Entity::create();
 
 	float radius = 200.f;
-	Motion& motion = registry.motions.emplace(entity);
+	Motion& motion = registry.emplace_motion(entity);
+	Presentation& presentation = registry.presentations.get(entity);
 	motion.position = position;
 	motion.position.z = 0.f;
 
 	float ogRadius = 170.f;
 	float scaledFactor = radius / ogRadius;
-	motion.scale = { 2 * ogRadius * scaledFactor, 2 * ogRadius * scaledFactor * zConversionFactor };
+	presentation.scale = { 2 * ogRadius * scaledFactor, 2 * ogRadius * scaledFactor * zConversionFactor };
 
 	registry.renderRequests.insert(
 		entity,
@@ -934,16 +1016,17 @@ Entity createTargetArea(vec3 position) {
 	return entity;
 }
 
-Entity createTutorialTarget(vec3 position) {
-	auto entity = Entity();
+Entity createTutorialTarget(vec3 position, ECSRegistry& registry) {
+	auto entity = Entity::create();
 
-	Motion& motion = registry.motions.emplace(entity);
+	Motion& motion = registry.emplace_motion(entity);
+	Presentation& presentation = registry.presentations.get(entity);
 	motion.position = position;
 	motion.position.z = 0.f;
 
 	float ogRadius = 170.f;
 	float scaledFactor = 150.0f / ogRadius;
-	motion.scale = { 2 * ogRadius * scaledFactor, 2 * ogRadius * scaledFactor * zConversionFactor };
+	presentation.scale = { 2 * ogRadius * scaledFactor, 2 * ogRadius * scaledFactor * zConversionFactor };
 
 	registry.renderRequests.insert(
 		entity,
@@ -960,8 +1043,8 @@ Entity createTutorialTarget(vec3 position) {
 	return entity;
 }
 
-Entity createPauseHelpText(vec2 windowSize) {
-	auto entity = Entity();
+Entity createPauseHelpText(vec2 windowSize, ECSRegistry& registry) {
+	auto entity = Entity::create();
 
 	Text& text = registry.texts.emplace(entity);
 	text.value = "PAUSE/PLAY(P)    HELP (H)";
@@ -980,8 +1063,8 @@ Entity createPauseHelpText(vec2 windowSize) {
 	return entity;
 }
 
-Entity createFPSText(vec2 windowSize) {
-	auto entity = Entity();
+Entity createFPSText(vec2 windowSize, ECSRegistry& registry) {
+	auto entity = Entity::create();
 
 	Text& text = registry.texts.emplace(entity);
 	text.value = "00 fps";
@@ -1001,8 +1084,29 @@ Entity createFPSText(vec2 windowSize) {
 	return entity;
 }
 
-Entity createTitleScreenBackground(vec2 windowSize) {
-	auto entity = Entity();
+Entity createMemoryText(vec2 windowSize, ECSRegistry& registry) {
+	auto entity = Entity::create();
+
+	Text& text = registry.texts.emplace(entity);
+	text.value = "ecs 0 KB";
+	// right of the fps counter
+	Foreground& fg = registry.foregrounds.emplace(entity);
+	fg.position = {170.0f, windowSize.y - 40.0f};
+	fg.scale = {0.8f, 0.8f};
+
+	registry.renderRequests.insert(
+			entity, 
+		{
+			TEXTURE_ASSET_ID::NONE,
+			EFFECT_ASSET_ID::FONT,
+			GEOMETRY_BUFFER_ID::TEXT
+		});
+
+	return entity;
+}
+
+Entity createTitleScreenBackground(vec2 windowSize, ECSRegistry& registry) {
+	auto entity = Entity::create();
 
 	registry.renderRequests.insert(
 		entity,
@@ -1019,8 +1123,8 @@ Entity createTitleScreenBackground(vec2 windowSize) {
 	return entity;
 }
 
-Entity createTitleScreenTitle(vec2 windowSize) {
-	auto entity = Entity();
+Entity createTitleScreenTitle(vec2 windowSize, ECSRegistry& registry) {
+	auto entity = Entity::create();
 
 	registry.renderRequests.insert(
 		entity,
@@ -1038,8 +1142,8 @@ Entity createTitleScreenTitle(vec2 windowSize) {
 }
 
 
-Entity createTitleScreenText(vec2 windowSize, std::string value, float fontSize, vec2 position) {
-	auto entity = Entity();
+Entity createTitleScreenText(vec2 windowSize, std::string value, float fontSize, vec2 position, ECSRegistry& registry) {
+	auto entity = Entity::create();
 
 	Text& text = registry.texts.emplace(entity);
 	text.value = value;
@@ -1058,8 +1162,8 @@ Entity createTitleScreenText(vec2 windowSize, std::string value, float fontSize,
 	return entity;
 }
 
-Entity createGameTimerText(vec2 windowSize) {
-	auto entity = Entity();
+Entity createGameTimerText(vec2 windowSize, ECSRegistry& registry) {
+	auto entity = Entity::create();
 
 	Text& text = registry.texts.emplace(entity);
 	text.value = "00:00:00";
@@ -1078,10 +1182,10 @@ Entity createGameTimerText(vec2 windowSize) {
 	return entity;
 }
 
-Entity createItemCountText(vec2 windowSize, TEXTURE_ASSET_ID assetID) {
-	auto textKeybindE = Entity();
-	auto textCountE = Entity();
-	auto iconE = Entity();
+Entity createItemCountText(vec2 windowSize, TEXTURE_ASSET_ID assetID, ECSRegistry& registry) {
+	auto textKeybindE = Entity::create();
+	auto textCountE = Entity::create();
+	auto iconE = Entity::create();
 	vec2 startPos = {420.0f, windowSize.y - 30.0f};
 	vec2 iconScale;
 	vec2 position;
@@ -1160,12 +1264,15 @@ Entity createItemCountText(vec2 windowSize, TEXTURE_ASSET_ID assetID) {
 	return textCountE;
 }
 
-Entity createMapTile(vec2 position, vec2 size, float height) {
-    auto entity = Entity();
+Entity createMapTile(vec2 position, vec2 size, float height, ECSRegistry& registry) {
+    auto entity = Entity::create();
 	registry.mapTiles.emplace(entity);
-	Motion& motion = registry.motions.emplace(entity);
+	registry.staticBodies.emplace(entity);
+	Motion& motion = registry.emplace_motion(entity);
+	Presentation& presentation = registry.presentations.get(entity);
+	registry.shapes.get(entity).layer = COLLISION_LAYER::MAP_TILE;
 	motion.position = vec3(position, height);
-	motion.scale = vec2(size.x, size.y * yConversionFactor);
+	presentation.scale = vec2(size.x, size.y * yConversionFactor);
 	
     registry.renderRequests.insert(
         entity, 
@@ -1179,7 +1286,7 @@ Entity createMapTile(vec2 position, vec2 size, float height) {
     return entity;
 }
 
-void createObstacles() {
+void createObstacles(ECSRegistry& registry) {
 	std::default_random_engine rng;
     std::uniform_real_distribution<float> uniform_dist;
     rng = std::default_random_engine(std::random_device()());
@@ -1188,28 +1295,32 @@ void createObstacles() {
 	while(numShrubs != 0) {
 		float posX = uniform_dist(rng) * (rightBound - leftBound) + leftBound;
 		float posY = uniform_dist(rng) * (bottomBound - topBound) + topBound;
-		createNormalObstacle({posX, posY}, {SHRUB_BB_WIDTH, SHRUB_BB_HEIGHT}, TEXTURE_ASSET_ID::SHRUB);
+		createNormalObstacle({posX, posY}, {SHRUB_BB_WIDTH, SHRUB_BB_HEIGHT}, TEXTURE_ASSET_ID::SHRUB, registry);
 		numShrubs--;
     }
 	int numRocks = 15;
 	while(numRocks != 0) {
 		float posX = uniform_dist(rng) * (rightBound - leftBound) + leftBound;
 		float posY = uniform_dist(rng) * (bottomBound - topBound) + topBound;
-		createNormalObstacle({posX, posY}, {ROCK_BB_WIDTH, ROCK_BB_HEIGHT}, TEXTURE_ASSET_ID::ROCK);
+		createNormalObstacle({posX, posY}, {ROCK_BB_WIDTH, ROCK_BB_HEIGHT}, TEXTURE_ASSET_ID::ROCK, registry);
 		numRocks--;
     }
 }
 
-Entity createObstacle(vec2 position, vec2 size, TEXTURE_ASSET_ID assetId) {
-    auto entity = Entity();
+Entity createObstacle(vec2 position, vec2 size, TEXTURE_ASSET_ID assetId, ECSRegistry& registry) {
+    auto entity = Entity::create();
     registry.obstacles.emplace(entity);
+    registry.staticBodies.emplace(entity);
 
-    Motion& motion = registry.motions.emplace(entity);
-    motion.scale = size;
+    Motion& motion = registry.emplace_motion(entity);
+    Shape& shape = registry.shapes.get(entity);
+    shape.layer = COLLISION_LAYER::OBSTACLE;
+    Presentation& presentation = registry.presentations.get(entity);
+    presentation.scale = size;
 
     motion.position = vec3(position.x, position.y, getElevation(position) + size.y / 2);
-	motion.hitbox = { size.x, size.x, size.y / zConversionFactor };
-	motion.solid = true;
+	shape.hitbox = { size.x, size.x, size.y / zConversionFactor };
+	shape.solid = true;
 
     registry.renderRequests.insert(
         entity, 
@@ -1223,16 +1334,20 @@ Entity createObstacle(vec2 position, vec2 size, TEXTURE_ASSET_ID assetId) {
     return entity;
 }
 
-Entity createNormalObstacle(vec2 position, vec2 size, TEXTURE_ASSET_ID assetId) {
-    auto entity = Entity();
+Entity createNormalObstacle(vec2 position, vec2 size, TEXTURE_ASSET_ID assetId, ECSRegistry& registry) {
+    auto entity = Entity::create();
     registry.obstacles.emplace(entity);
+    registry.staticBodies.emplace(entity);
 
-    Motion& motion = registry.motions.emplace(entity);
-    motion.scale = size;
+    Motion& motion = registry.emplace_motion(entity);
+    Shape& shape = registry.shapes.get(entity);
+    shape.layer = COLLISION_LAYER::OBSTACLE;
+    Presentation& presentation = registry.presentations.get(entity);
+    presentation.scale = size;
 
     motion.position = vec3(position.x, position.y, getElevation(position) + size.y / 2);
-	motion.hitbox = { size.x, size.x, size.y / zConversionFactor };
-	motion.solid = true;
+	shape.hitbox = { size.x, size.x, size.y / zConversionFactor };
+	shape.solid = true;
 
     registry.renderRequests.insert(
         entity, 
@@ -1249,15 +1364,19 @@ Entity createNormalObstacle(vec2 position, vec2 size, TEXTURE_ASSET_ID assetId)
 
 
 
-Entity createBottomCliff(vec2 position, vec2 size) {
-    auto entity = Entity();
-	Motion& motion = registry.motions.emplace(entity);
+Entity createBottomCliff(vec2 position, vec2 size, ECSRegistry& registry) {
+    auto entity = Entity::create();
+	Motion& motion = registry.emplace_motion(entity);
+	Shape& shape = registry.shapes.get(entity);
+	shape.layer = COLLISION_LAYER::OBSTACLE;
+	Presentation& presentation = registry.presentations.get(entity);
 	motion.position = vec3(position, size.y / 2);
-	motion.scale = vec2(size.x, size.y * yConversionFactor);
-	motion.hitbox = { size.x, 1.9 * size.y, size.y };
-	motion.solid = true;
+	presentation.scale = vec2(size.x, size.y * yConversionFactor);
+	shape.hitbox = { size.x, 1.9 * size.y, size.y };
+	shape.solid = true;
 
 	registry.obstacles.emplace(entity);
+	registry.staticBodies.emplace(entity);
 
     registry.renderRequests.insert(
         entity, 
@@ -1270,16 +1389,20 @@ Entity createBottomCliff(vec2 position, vec2 size) {
     return entity;
 }
 
-Entity createSideCliff(vec2 position, vec2 size) {
-    auto entity = Entity();
+Entity createSideCliff(vec2 position, vec2 size, ECSRegistry& registry) {
+    auto entity = Entity::create();
 	registry.mapTiles.emplace(entity);
-	Motion& motion = registry.motions.emplace(entity);
+	Motion& motion = registry.emplace_motion(entity);
+	Shape& shape = registry.shapes.get(entity);
+	shape.layer = COLLISION_LAYER::OBSTACLE;
+	Presentation& presentation = registry.presentations.get(entity);
 	motion.position = vec3(position, size.y / 2);
-	motion.scale = vec2(size.x, size.y * yConversionFactor);
-	motion.hitbox = { abs(size.x) * 0.95, size.y, size.y };
-	motion.solid = true;
+	presentation.scale = vec2(size.x, size.y * yConversionFactor);
+	shape.hitbox = { abs(size.x) * 0.95, size.y, size.y };
+	shape.solid = true;
 
 	registry.obstacles.emplace(entity);
+	registry.staticBodies.emplace(entity);
 
     registry.renderRequests.insert(
         entity, 
@@ -1291,15 +1414,19 @@ Entity createSideCliff(vec2 position, vec2 size) {
     registry.midgrounds.emplace(entity); 
     return entity;
 }
-Entity createTopCliff(vec2 position, vec2 size) {
-    auto entity = Entity();
-	Motion& motion = registry.motions.emplace(entity);
+Entity createTopCliff(vec2 position, vec2 size, ECSRegistry& registry) {
+    auto entity = Entity::create();
+	Motion& motion = registry.emplace_motion(entity);
+	Shape& shape = registry.shapes.get(entity);
+	shape.layer = COLLISION_LAYER::OBSTACLE;
+	Presentation& presentation = registry.presentations.get(entity);
 	motion.position = vec3(position, size.y / 2);
-	motion.scale = vec2(size.x, size.y * yConversionFactor);
-	motion.hitbox = { size.x, size.y / 16, size.y };
-	motion.solid = true;
+	presentation.scale = vec2(size.x, size.y * yConversionFactor);
+	shape.hitbox = { size.x, size.y / 16, size.y };
+	shape.solid = true;
 
 	registry.obstacles.emplace(entity);
+	registry.staticBodies.emplace(entity);
 
     registry.renderRequests.insert(
         entity, 
@@ -1312,43 +1439,43 @@ Entity createTopCliff(vec2 position, vec2 size) {
     return entity;
 }
 
-void createCliffs(GLFWwindow* window) {
+void createCliffs(GLFWwindow* window, ECSRegistry& registry) {
 	float widthFactor = 0.5;
 	for (int col = 1 / widthFactor; col < x_tiles / widthFactor; col++) {
 		vec2 position = { (col - 0.5) * tile_x * widthFactor, tile_y };
 		vec2 size = { tile_x * widthFactor, tile_y };
-		createTopCliff(position, size);
+		createTopCliff(position, size, registry);
 	}
 	for (int row = 0; row < y_tiles; row++) {
 		vec2 position = { 0.3 * tile_x, (row + 1) * tile_y };
 		vec2 size = { tile_x, tile_y };
-		createSideCliff(position, size);
+		createSideCliff(position, size, registry);
 	}
 	for (int row = 0; row < y_tiles; row++) {
 		vec2 position = { (x_tiles - 0.3) * tile_x, (row + 1) * tile_y };
 		vec2 size = { -tile_x, tile_y };
-		createSideCliff(position, size);
+		createSideCliff(position, size, registry);
 	}
 	for (int col = 1 / widthFactor; col < x_tiles / widthFactor; col++) {
 		vec2 position = { (col - 0.5) * tile_x * widthFactor, y_tiles * tile_y };
 		vec2 size = { tile_x * widthFactor, tile_y };
-		createBottomCliff(position, size);
+		createBottomCliff(position, size, registry);
 	}
 }
 
-void createMapTiles() {
+void createMapTiles(ECSRegistry& registry) {
     for (int row = 0; row < y_tiles; row++) { 
         for (int col = 0; col < x_tiles; col++) { 
             vec2 position = {(col + 0.5) * tile_x, (row + 0.5) * tile_y};
             vec2 size = {tile_x, tile_y};
 			float height = 0;
-            createMapTile(position, size, height);
+            createMapTile(position, size, height, registry);
         }
     }
 }
 
-void createGameOverText(vec2 windowSize) {
-	auto backdrop = Entity();
+void createGameOverText(vec2 windowSize, ECSRegistry& registry) {
+	auto backdrop = Entity::create();
 	Foreground& backdropFg = registry.foregrounds.emplace(backdrop);
 	backdropFg.position = {0.0f, 0.0f};
 	backdropFg.scale = {windowSize.x, windowSize.y};
@@ -1366,7 +1493,7 @@ void createGameOverText(vec2 windowSize) {
 	GameTimer& gameTimer = registry.gameTimer;
 	GameScore& gameScore = registry.gameScore;
 
-	auto entity1 = Entity();
+	auto entity1 = Entity::create();
 	Text& text1 = registry.texts.emplace(entity1);
 	Foreground& text1Fg = registry.foregrounds.emplace(entity1);
 	text1.value = "GAME OVER";
@@ -1374,7 +1501,7 @@ void createGameOverText(vec2 windowSize) {
 	text1Fg.scale = {4.0f, 4.0f};
 	registry.colours.insert(entity1, {0.85f, 0.0f, 0.0f, 1.0f});
 
-	auto entity2 = Entity();
+	auto entity2 = Entity::create();
 	Text& text2 = registry.texts.emplace(entity2);
 	text2.lineSpacing = 1.5f;
 	text2.alignment = TEXT_ALIGNMENT::CENTER;
@@ -1404,7 +1531,7 @@ void createGameOverText(vec2 windowSize) {
 	oss << gameScore.highScoreSeconds << "s";
 	text2.value += oss.str();
 
-	auto entity3 = Entity();
+	auto entity3 = Entity::create();
 	Text& text3 = registry.texts.emplace(entity3);
 	text3.value = "Press ENTER to play again";
 	Foreground& text3Fg = registry.foregrounds.emplace(entity3);
@@ -1426,16 +1553,19 @@ void createGameOverText(vec2 windowSize) {
 
 }
 
-Entity createProjectile(vec3 pos, vec3 velocity, PROJECTILE_TYPE type)
+Entity createProjectile(vec3 pos, vec3 velocity, PROJECTILE_TYPE type, ECSRegistry& registry)
 {
-	auto entity = Entity();
+	auto entity = Entity::create();
 
-	Motion& motion = registry.motions.emplace(entity);
+	Motion& motion = registry.emplace_motion(entity);
+	Shape& shape = registry.shapes.get(entity);
+	shape.layer = COLLISION_LAYER::PROJECTILE;
+	Presentation& presentation = registry.presentations.get(entity);
 	motion.position = pos;
 	motion.velocity = velocity;
-	motion.scale = getProjectileInfo(type).size;
-	motion.hitbox = { motion.scale.x, motion.scale.x, motion.scale.y / zConversionFactor };
-	motion.solid = true;
+	presentation.scale = getProjectileInfo(type).size;
+	shape.hitbox = { presentation.scale.x, presentation.scale.x, presentation.scale.y / zConversionFactor };
+	shape.solid = true;
 	
 	Projectile& projectile = registry.projectiles.emplace(entity);
 	projectile.type = type;
@@ -1443,8 +1573,8 @@ Entity createProjectile(vec3 pos, vec3 velocity, PROJECTILE_TYPE type)
 
 	if(type == PROJECTILE_TYPE::BOMB_FUSED) {
 		registry.bounceables.emplace(entity);
-		AnimationController& ac = initBombAnimationController(entity);
-		ac.changeState(entity, AnimationState::Attack);
+		AnimationController& ac = initBombAnimationController(entity, registry);
+		ac.changeState(entity, AnimationState::Attack, registry);
 	} else {
 		registry.renderRequests.insert(
 			entity,
@@ -1458,8 +1588,8 @@ Entity createProjectile(vec3 pos, vec3 velocity, PROJECTILE_TYPE type)
 	return entity;
 }
 
-Entity createMousePointer(vec2 mousePos) {
-	auto entity = Entity();
+Entity createMousePointer(vec2 mousePos, ECSRegistry& registry) {
+	auto entity = Entity::create();
 
 	Foreground& fg = registry.foregrounds.emplace(entity);
 	fg.scale = { 40.0f, 40.0f};
@@ -1476,8 +1606,8 @@ Entity createMousePointer(vec2 mousePos) {
 	return entity;
 }
 
-void createGameSaveText(vec2 windowSize) {
-	auto entity = Entity();
+void createGameSaveText(vec2 windowSize, ECSRegistry& registry) {
+	auto entity = Entity::create();
 
 	Text& text = registry.texts.emplace(entity);
 	text.value = "Game Saved!";
@@ -1499,7 +1629,7 @@ void createGameSaveText(vec2 windowSize) {
 		});
 }
 
-void createTrees(RenderSystem* renderer) {
+void createTrees(RenderSystem* renderer, ECSRegistry& registry) {
 	int numTrees = 4;
 	std::default_random_engine rng;
 	std::uniform_real_distribution<float> uniform_dist;
@@ -1508,18 +1638,18 @@ void createTrees(RenderSystem* renderer) {
 	while (numTrees != 0) {
 		float posX = uniform_dist(rng) * (rightBound - leftBound) + leftBound;
 		float posY = uniform_dist(rng) * (bottomBound - topBound) + topBound;
-		createTree(renderer, { posX, posY });
+		createTree(renderer, { posX, posY }, registry);
 		numTrees--;
 	}
 }
 
-Entity createPointsEarnedText(std::string textValue, Entity anchoredWorldEntity, vec4 color) {
-	auto entity = Entity();
-	Motion& anchoredMotion = registry.motions.get(anchoredWorldEntity);
+Entity createPointsEarnedText(std::string textValue, Entity anchoredWorldEntity, vec4 color, ECSRegistry& registry) {
+	auto entity = Entity::create();
+	Presentation& anchoredPresentation = registry.presentations.get(anchoredWorldEntity);
 	Text& text = registry.texts.emplace(entity);
 	text.value = textValue;
 	text.anchoredWorldEntity = anchoredWorldEntity;
-	text.anchoredWorldOffset = {0.0f, -anchoredMotion.scale.y / 2 - 20.0f};
+	text.anchoredWorldOffset = {0.0f, -anchoredPresentation.scale.y / 2 - 20.0f};
 	text.alignment = TEXT_ALIGNMENT::CENTER;
 
 	if(registry.players.has(anchoredWorldEntity)) {
@@ -1545,8 +1675,8 @@ Entity createPointsEarnedText(std::string textValue, Entity anchoredWorldEntity,
 	return entity;
 }
 
-Entity createComboText(int comboValue, vec2 windowSize) {
-	auto entity = Entity();
+Entity createComboText(int comboValue, vec2 windowSize, ECSRegistry& registry) {
+	auto entity = Entity::create();
 	Text& text = registry.texts.emplace(entity);
 	text.value = "COMBO *" + std::to_string(comboValue);
 	text.alignment = TEXT_ALIGNMENT::CENTER;
@@ -1575,8 +1705,8 @@ Entity createComboText(int comboValue, vec2 windowSize) {
 	return entity;
 }
 
-Entity createScoreText(vec2 windowSize) {
-	auto entity = Entity();
+Entity createScoreText(vec2 windowSize, ECSRegistry& registry) {
+	auto entity = Entity::create();
 
 	registry.texts.emplace(entity);
 	Foreground& fg = registry.foregrounds.emplace(entity);
@@ -1594,19 +1724,22 @@ Entity createScoreText(vec2 windowSize) {
 	return entity;
 }
 
-void createExplosion(vec3 pos)
+void createExplosion(vec3 pos, ECSRegistry& registry)
 {
-	auto entity = Entity();
+	auto entity = Entity::create();
 
 	registry.explosions.emplace(entity);
 	Damaging& dmg = registry.damagings.emplace(entity);
 	dmg.damage = 30;
 
 	// Setting intial motion values
-	Motion& motion = registry.motions.emplace(entity);
+	Motion& motion = registry.emplace_motion(entity);
+	Shape& shape = registry.shapes.get(entity);
+	shape.layer = COLLISION_LAYER::DAMAGING;
+	Presentation& presentation = registry.presentations.get(entity);
 	motion.position = pos;
-	motion.scale = { EXPLOSION_BB_WIDTH + 30.0f, EXPLOSION_BB_HEIGHT + 30.0f };
-	motion.hitbox = { EXPLOSION_BB_WIDTH, EXPLOSION_BB_WIDTH, EXPLOSION_BB_HEIGHT / zConversionFactor };
+	presentation.scale = { EXPLOSION_BB_WIDTH + 30.0f, EXPLOSION_BB_HEIGHT + 30.0f };
+	shape.hitbox = { EXPLOSION_BB_WIDTH, EXPLOSION_BB_WIDTH, EXPLOSION_BB_HEIGHT / zConversionFactor };
 
 	Knocker& knocker = registry.knockers.emplace(entity);
 	knocker.strength = 1.5f;
@@ -1620,7 +1753,7 @@ void createExplosion(vec3 pos)
 	pointLight.linear = .005;
 	pointLight.quadratic = 0.f;
 	
-	initExplosionAnimationController(entity);
+	initExplosionAnimationController(entity, registry);
 	registry.midgrounds.emplace(entity);
 };
 
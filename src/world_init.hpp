@@ -98,104 +98,105 @@ const int BOMBER_DAMAGE = 0;
 const int PLAYER_ARROW_DAMAGE = 30;
 
 // Jeff the Player
-Entity createJeff(vec2 position);
+Entity createJeff(vec2 position, ECSRegistry& registry);
 
-Entity createTree(RenderSystem* renderer, vec2 position);
+Entity createTree(RenderSystem* renderer, vec2 position, ECSRegistry& registry);
 
 // The boar
-Entity createBoar(vec2 pos);
+Entity createBoar(vec2 pos, ECSRegistry& registry);
 
 // The barbarian
-Entity createBarbarian(vec2 pos);
+Entity createBarbarian(vec2 pos, ECSRegistry& registry);
 
 // The archer
-Entity createArcher(vec2 pos);
+Entity createArcher(vec2 pos, ECSRegistry& registry);
 
 // The birds
-Entity createBirdFlock(vec2 pos);
-Entity createBird(vec2 pos);
+Entity createBirdFlock(vec2 pos, ECSRegistry& registry);
+Entity createBird(vec2 pos, ECSRegistry& registry);
 
 // The wizard
-Entity createWizard(vec2 pos);
+Entity createWizard(vec2 pos, ECSRegistry& registry);
 
-Entity createTroll(vec2 pos);
+Entity createTroll(vec2 pos, ECSRegistry& registry);
 
-Entity createCollectible(vec2 pos, TEXTURE_ASSET_ID assetID);
-Entity createBomber(vec2 pos);
+Entity createCollectible(vec2 pos, TEXTURE_ASSET_ID assetID, ECSRegistry& registry);
+Entity createBomber(vec2 pos, ECSRegistry& registry);
 
 // The collectible trap
-Entity createCollectibleTrap(vec2 pos);
+Entity createCollectibleTrap(vec2 pos, ECSRegistry& registry);
 
 // The collectible heart
-Entity createHeart(vec2 pos);
+Entity createHeart(vec2 pos, ECSRegistry& registry);
 
 // indicator showing the collected item
-Entity createCollected(TEXTURE_ASSET_ID assetID);
+Entity createCollected(TEXTURE_ASSET_ID assetID, ECSRegistry& registry);
 
-Entity createEquipped(TEXTURE_ASSET_ID assetId);
+Entity createEquipped(TEXTURE_ASSET_ID assetId, ECSRegistry& registry);
 
 // The damage trap
-Entity createDamageTrap(vec2 pos);
+Entity createDamageTrap(vec2 pos, ECSRegistry& registry);
 
-Entity createPhantomTrap(vec2 pos);
+Entity createPhantomTrap(vec2 pos, ECSRegistry& registry);
 
 // Arrows fired by the archer/player
-Entity createArrow(vec3 pos, vec3 velocity, int damage);
+Entity createArrow(vec3 pos, vec3 velocity, int damage, ECSRegistry& registry);
 
-void createExplosion(vec3 position);
+void createExplosion(vec3 position, ECSRegistry& registry);
 
 // Fireballs fired by the wizard
-Entity createFireball(vec3 pos, vec2 direction);
+Entity createFireball(vec3 pos, vec2 direction, ECSRegistry& registry);
 
 // Lightning bolt from the sky
-Entity createLightning(vec2 pos);
+Entity createLightning(vec2 pos, ECSRegistry& registry);
 
 // TitleScreen UI
-Entity createTitleScreenBackground(vec2 windowSize);
-Entity createTitleScreenTitle(vec2 windowSize);
-Entity createTitleScreenText(vec2 windowSize, std::string value, float fontSize, vec2 position);
+Entity createTitleScreenBackground(vec2 windowSize, ECSRegistry& registry);
+Entity createTitleScreenTitle(vec2 windowSize, ECSRegistry& registry);
+Entity createTitleScreenText(vec2 windowSize, std::string value, float fontSize, vec2 position, ECSRegistry& registry);
 
 // Playing UI
-Entity createPauseHelpText(vec2 windowSize);
-Entity createFPSText(vec2 windowSize);
-Entity createGameTimerText(vec2 windowSize);
-Entity createPointsEarnedText(std::string text, Entity anchoredWorldEntity, vec4 color);
-Entity createComboText(int comboValue, vec2 windowSize);
-Entity createScoreText(vec2 windowSize);
-Entity createItemCountText(vec2 windowSize, TEXTURE_ASSET_ID assetID);
-
-Entity createMousePointer(vec2 mousePos);
-Entity createProjectile(vec3 pos, vec3 velocity, PROJECTILE_TYPE type);
+Entity createPauseHelpText(vec2 windowSize, ECSRegistry& registry);
+Entity createFPSText(vec2 windowSize, ECSRegistry& registry);
+Entity createMemoryText(vec2 windowSize, ECSRegistry& registry);
+Entity createGameTimerText(vec2 windowSize, ECSRegistry& registry);
+Entity createPointsEarnedText(std::string text, Entity anchoredWorldEntity, vec4 color, ECSRegistry& registry);
+Entity createComboText(int comboValue, vec2 windowSize, ECSRegistry& registry);
+Entity createScoreText(vec2 windowSize, ECSRegistry& registry);
+Entity createItemCountText(vec2 windowSize, TEXTURE_ASSET_ID assetID, ECSRegistry& registry);
+
+Entity createMousePointer(vec2 mousePos, ECSRegistry& registry);
+Entity createProjectile(vec3 pos, vec3 velocity, PROJECTILE_TYPE type, ECSRegistry& registry);
 
 // Game over UI
-void createGameOverText(vec2 windowSize);
+void createGameOverText(vec2 windowSize, ECSRegistry& registry);
 
 // Game save text
-void createGameSaveText(vec2 windowSize);
+void createGameSaveText(vec2 windowSize, ECSRegistry& registry);
 
 // Display bars
-void createStaminaBar(Entity characterEntity);
-void createHealthBar(Entity characterEntity);
-void createPlayerUIHealthBar(vec2 windowSize);
-void createPlayerUIStaminaBar(vec2 windowSize);
+void createStaminaBar(Entity characterEntity, ECSRegistry& registry);
+void createHealthBar(Entity characterEntity, ECSRegistry& registry);
+void createPlayerUIHealthBar(vec2 windowSize, ECSRegistry& registry);
+void createPlayerUIStaminaBar(vec2 windowSize, ECSRegistry& registry);
 
 // Map objects
-void createMapTiles();
-Entity createMapTile(vec2 position, vec2 scale, float height);
-Entity createObstacle(vec2 position, vec2 scale, TEXTURE_ASSET_ID assetID);
-Entity createNormalObstacle(vec2 position, vec2 size, TEXTURE_ASSET_ID assetId);
-void createObstacles();
-Entity createTargetArea(vec3 position);
+void createMapTiles(ECSRegistry& registry);
+Entity createMapTile(vec2 position, vec2 scale, float height, ECSRegistry& registry);
+Entity createObstacle(vec2 position, vec2 scale, TEXTURE_ASSET_ID assetID, ECSRegistry& registry);
+Entity createNormalObstacle(vec2 position, vec2 size, TEXTURE_ASSET_ID assetId, ECSRegistry& registry);
+void createObstacles(ECSRegistry& registry);
+Entity createTargetArea(vec3 position, ECSRegistry& registry);
 
 // Cliffs
-void createCliffs(GLFWwindow* window);
-Entity createBottomCliff(vec2 position, vec2 scale);
-Entity createSideCliff(vec2 position, vec2 scale);
-Entity createTopCliff(vec2 position, vec2 scale);
-void createTrees(RenderSystem* renderer);
+void createCliffs(GLFWwindow* window, ECSRegistry& registry);
+Entity createBottomCliff(vec2 position, vec2 scale, ECSRegistry& registry);
+Entity createSideCliff(vec2 position, vec2 scale, ECSRegistry& registry);
+Entity createTopCliff(vec2 position, vec2 scale, ECSRegistry& registry);
+void createTrees(RenderSystem* renderer, ECSRegistry& registry);
 
 //Tutorial
-Entity createTutorialTarget(vec3 position);
+Entity createTutorialTarget(vec3 position, ECSRegistry& registry);
 struct ProjectileInfo {
     vec2 size;
     TEXTURE_ASSET_ID assetId;
@@ -12,7 +12,7 @@
 #include <sstream>
 #include <fstream> 
 
-WorldSystem::WorldSystem(std::default_random_engine& rng)
+WorldSystem::WorldSystem(ECSRegistry& registry, std::default_random_engine& rng) : registry(registry)
 {
     this->gameStateController = GameStateController();
     this->gameStateController.init(GAME_STATE::PLAYING, this);
@@ -65,15 +65,15 @@ void WorldSystem::restart_game()
 {
     registry.clear_all_components();
 
-    createMapTiles();
-    createCliffs(window);
-    createTrees(renderer);
-    createObstacles();
+    createMapTiles(registry);
+    createCliffs(window, registry);
+    createTrees(renderer, registry);
+    createObstacles(registry);
     
     // Create player entity
-    playerEntity = createJeff(vec2(world_size_x / 2.f, world_size_y / 2.f));
-    createPlayerUIHealthBar(camera->getSize());
-    createPlayerUIStaminaBar(camera->getSize());
+    playerEntity = createJeff(vec2(world_size_x / 2.f, world_size_y / 2.f), registry);
+    createPlayerUIHealthBar(camera->getSize(), registry);
+    createPlayerUIStaminaBar(camera->getSize(), registry);
 
     gameStateController.restart();
     registry.gameScore.score = 0;
@@ -126,33 +126,35 @@ void WorldSystem::handleSurvivalBonusPoints(float elapsed_ms) {
     if (gameStateController.survivalBonusTimer >= SURVIVAL_BONUS_INTERVAL) {
         int points = 35;
         registry.gameScore.score += points;
-        createPointsEarnedText("SURVIVAL BONUS +" + std::to_string(points), playerEntity, {0.8f, 0.8f, 0.0f, 1.0f});
+        createPointsEarnedText("SURVIVAL BONUS +" + std::to_string(points), playerEntity, {0.8f, 0.8f, 0.0f, 1.0f}, registry);
         gameStateController.survivalBonusTimer = 0;
     }
 }
 
 void WorldSystem::initText() {
-    createPauseHelpText(camera->getSize());
-    registry.fpsTracker.textEntity = createFPSText(camera->getSize());
+    createPauseHelpText(camera->getSize(), registry);
+    registry.fpsTracker.textEntity = createFPSText(camera->getSize(), registry);
+    registry.memoryTracker.textEntity = createMemoryText(camera->getSize(), registry);
     registry.gameTimer.reset();
-    registry.gameTimer.textEntity = createGameTimerText(camera->getSize());
-    registry.gameScore.textEntity = createScoreText(camera->getSize());
+    registry.gameTimer.textEntity = createGameTimerText(camera->getSize(), registry);
+    registry.gameScore.textEntity = createScoreText(camera->getSize(), registry);
 
     registry.inventory.reset();
     std::unordered_map<INVENTORY_ITEM, Entity>& itemCountTextEntities = registry.inventory.itemCountTextEntities;
-    itemCountTextEntities[INVENTORY_ITEM::BOW] = createItemCountText(camera->getSize(), TEXTURE_ASSET_ID::BOW);
-    itemCountTextEntities[INVENTORY_ITEM::BOMB] = createItemCountText(camera->getSize(), TEXTURE_ASSET_ID::BOMB);
+    itemCountTextEntities[INVENTORY_ITEM::BOW] = createItemCountText(camera->getSize(), TEXTURE_ASSET_ID::BOW, registry);
+    itemCountTextEntities[INVENTORY_ITEM::BOMB] = createItemCountText(camera->getSize(), TEXTURE_ASSET_ID::BOMB, registry);
     trapsCounter.reset();
 
     // init trapsCounter with text
-	trapsCounter.trapsMap[DAMAGE_TRAP] = { 0, createItemCountText(camera->getSize(), TEXTURE_ASSET_ID::TRAPCOLLECTABLE) };
-	trapsCounter.trapsMap[PHANTOM_TRAP] = { 0, createItemCountText(camera->getSize(), TEXTURE_ASSET_ID::PHANTOM_TRAP_BOTTLE_ONE) };
+	trapsCounter.trapsMap[TRAP_TYPE::DAMAGE] = { 0, createItemCountText(camera->getSize(), TEXTURE_ASSET_ID::TRAPCOLLECTABLE, registry) };
+	trapsCounter.trapsMap[TRAP_TYPE::PHANTOM] = { 0, createItemCountText(camera->getSize(), TEXTURE_ASSET_ID::PHANTOM_TRAP_BOTTLE_ONE, registry) };
 }
 
 void WorldSystem::reloadText() {
-    createPauseHelpText(camera->getSize());
-    registry.fpsTracker.textEntity = createFPSText(camera->getSize());
-    registry.gameTimer.textEntity = createGameTimerText(camera->getSize());
+    createPauseHelpText(camera->getSize(), registry);
+    registry.fpsTracker.textEntity = createFPSText(camera->getSize(), registry);
+    registry.memoryTracker.textEntity = createMemoryText(camera->getSize(), registry);
+    registry.gameTimer.textEntity = createGameTimerText(camera->getSize(), registry);
 }
 
 void WorldSystem::trackFPS(float elapsed_ms) {
@@ -162,9 +164,30 @@ void WorldSystem::trackFPS(float elapsed_ms) {
     if(fpsTracker.elapsedTime == 0) {
         Text& text = registry.texts.get(fpsTracker.textEntity);
         text.value = std::to_string(fpsTracker.fps) + " fps";
+        trackMemory();
     }
 }
 
+// Refreshed with the fps counter, walking every container is only worth it while the overlay is shown
+void WorldSystem::trackMemory() {
+    if (!registry.memoryTracker.toggled || !registry.texts.has(registry.memoryTracker.textEntity)) {
+        return;
+    }
+    const char* largestName = "";
+    size_t largestBytes = 0;
+    registry.for_each_container([&](const char* name, const auto& container) {
+        size_t bytes = container.memory().total();
+        if (bytes > largestBytes) {
+            largestName = name;
+            largestBytes = bytes;
+        }
+    });
+    ContainerMemory total = registry.memory_usage();
+    std::stringstream ss;
+    ss << "ecs " << total.total() / 1024 << " KB, " << total.count << " components, most in " << largestName << " " << largestBytes / 1024 << " KB";
+    registry.texts.get(registry.memoryTracker.textEntity).value = ss.str();
+}
+
 void WorldSystem::updateInventoryItemText() {
     Inventory& inventory = registry.inventory;
     for (auto& item : inventory.itemCountTextEntities) {
@@ -184,10 +207,10 @@ void WorldSystem::updateInventoryItemText() {
 }
 
 void WorldSystem::updateTrapsCounterText() {
-    int damageTrapCount = trapsCounter.trapsMap["trap"].first;
-    Entity& damageTrapTextEntity = trapsCounter.trapsMap["trap"].second;
-    int phantomTrapCount = trapsCounter.trapsMap["phantom_trap"].first;
-    Entity& phantomTrapTextEntity = trapsCounter.trapsMap["phantom_trap"].second;
+    int damageTrapCount = trapsCounter.trapsMap[TRAP_TYPE::DAMAGE].first;
+    Entity& damageTrapTextEntity = trapsCounter.trapsMap[TRAP_TYPE::DAMAGE].second;
+    int phantomTrapCount = trapsCounter.trapsMap[TRAP_TYPE::PHANTOM].first;
+    Entity& phantomTrapTextEntity = trapsCounter.trapsMap[TRAP_TYPE::PHANTOM].second;
 
     Text& damageTrapText = registry.texts.get(damageTrapTextEntity);
     std::stringstream ss;
@@ -245,28 +268,28 @@ void WorldSystem::updateEnemyTutorial() {
         float distance = glm::distance(playerPosition, enemyPosition);
 
          if (distance <= 600.0f) {
-            std::string enemyType = registry.enemies.get(enemy).type; 
+            ENEMY_TYPE enemyType = registry.enemies.get(enemy).type; 
             if (encounteredEnemies.find(enemyType) == encounteredEnemies.end()) {
-                createTutorialTarget(motion.position);
-                if (enemyType == "BOAR") {
+                createTutorialTarget(motion.position, registry);
+                if (enemyType == ENEMY_TYPE::BOAR) {
                     gameStateController.setGameState(GAME_STATE::BOAR_TUTORIAL);
                 }
-                if (enemyType == "BIRD") {
+                if (enemyType == ENEMY_TYPE::BIRD) {
                     gameStateController.setGameState(GAME_STATE::BIRD_TUTORIAL);
                 }
-                if (enemyType == "TROLL") {
+                if (enemyType == ENEMY_TYPE::TROLL) {
                     gameStateController.setGameState(GAME_STATE::TROLL_TUTORIAL);
                 }
-                if (enemyType == "WIZARD") {
+                if (enemyType == ENEMY_TYPE::WIZARD) {
                     gameStateController.setGameState(GAME_STATE::WIZARD_TUTORIAL);
                 }
-                if (enemyType == "ARCHER") {
+                if (enemyType == ENEMY_TYPE::ARCHER) {
                     gameStateController.setGameState(GAME_STATE::ARCHER_TUTORIAL);
                 }
-                if (enemyType == "BARBARIAN") {
+                if (enemyType == ENEMY_TYPE::BARBARIAN) {
                     gameStateController.setGameState(GAME_STATE::BARBARIAN_TUTORIAL);
                 }
-                if (enemyType == "BOMBER") {
+                if (enemyType == ENEMY_TYPE::BOMBER) {
                     gameStateController.setGameState(GAME_STATE::BOMBER_TUTORIAL);
                 }
                 
@@ -286,22 +309,22 @@ void WorldSystem::updateCollectibleTutorial() {
         vec2 collectiblePosition = { motion.position.x, motion.position.y };
         float distance = glm::distance(playerPosition, collectiblePosition);
         if (distance <= 200.0f) {
-            std::string collectibleType = registry.collectibles.get(collectible).type; 
+            COLLECTIBLE_TYPE collectibleType = registry.collectibles.get(collectible).type; 
             if (encounteredCollectibles.find(collectibleType) == encounteredCollectibles.end()) {
-                createTutorialTarget(motion.position);
-                if (collectibleType == "HEART") {
+                createTutorialTarget(motion.position, registry);
+                if (collectibleType == COLLECTIBLE_TYPE::HEART) {
                     gameStateController.setGameState(GAME_STATE::HEART_TUTORIAL);
                 }
-                if (collectibleType == "TRAP") {
+                if (collectibleType == COLLECTIBLE_TYPE::TRAP) {
                     gameStateController.setGameState(GAME_STATE::TRAP_TUTORIAL);
                 }
-                if (collectibleType == "PHANTOM_TRAP") {
+                if (collectibleType == COLLECTIBLE_TYPE::PHANTOM_TRAP) {
                     gameStateController.setGameState(GAME_STATE::PHANTOM_TRAP_TUTORIAL);
                 }
-                if (collectibleType == "BOW") {
+                if (collectibleType == COLLECTIBLE_TYPE::BOW) {
                     gameStateController.setGameState(GAME_STATE::BOW_TUTORIAL);
                 }
-                if (collectibleType == "BOMB") {
+                if (collectibleType == COLLECTIBLE_TYPE::BOMB) {
                     gameStateController.setGameState(GAME_STATE::BOMB_TUTORIAL);
                 }
                 encounteredCollectibles.insert(collectibleType);
@@ -313,25 +336,26 @@ void WorldSystem::updateCollectibleTutorial() {
 void WorldSystem::updateEquippedPosition() {
 	Entity& playerE = registry.players.entities[0];
 	Motion& playerM = registry.motions.get(playerE);
+	Presentation& playerPresentation = registry.presentations.get(playerE);
 
-    if(registry.motions.has(registry.inventory.equippedEntity)) {
-        Motion& equippedM = registry.motions.get(registry.inventory.equippedEntity);
-        equippedM.position = playerM.position;
+    if(registry.relationships.has(registry.inventory.equippedEntity)) {
+        Presentation& equippedPresentation = registry.presentations.get(registry.inventory.equippedEntity);
+        Relationship& held = registry.relationships.get(registry.inventory.equippedEntity);
 
         double mousePosX, mousePosY;
         glfwGetCursorPos(window, &mousePosX, &mousePosY);
         vec3 mouseWorldPos = renderer->mouseToWorld({mousePosX, mousePosY});
 
-        const float fixedDistance = abs(playerM.scale.x) / 2;
+        const float fixedDistance = abs(playerPresentation.scale.x) / 2;
 
         vec3 direction = mouseWorldPos - playerM.position;
         vec3 normalizedDirection = normalize(direction);
 
-        equippedM.position = playerM.position + normalizedDirection * fixedDistance;
+        held.offset = normalizedDirection * fixedDistance;
 
         if(registry.inventory.equipped == INVENTORY_ITEM::BOW) {
             float angle = atan2(direction.y, direction.x);
-            equippedM.angle = angle;
+            equippedPresentation.angle = angle;
         }
     }
 }
@@ -385,7 +409,7 @@ void WorldSystem::handleEnemiesKilledInSpan(float elapsed_ms) {
                                !registry.texts.has(enemiesKilled.comboTextEntity);
 
     if(shouldShowComboText) {
-        enemiesKilled.comboTextEntity = createComboText(enemiesKilled.killSpanCount, camera->getSize());
+        enemiesKilled.comboTextEntity = createComboText(enemiesKilled.killSpanCount, camera->getSize(), registry);
     }
 
     if(enemiesKilled.spanCountdown <= 0) {
@@ -397,7 +421,7 @@ void WorldSystem::handleEnemiesKilledInSpan(float elapsed_ms) {
                 points = enemiesKilled.killSpanCount * 5;
             }
             registry.gameScore.score += points;
-            createPointsEarnedText("BONUS +" + std::to_string(points), playerEntity, {0.8f, 0.8f, 0.0f, 1.0f});
+            createPointsEarnedText("BONUS +" + std::to_string(points), playerEntity, {0.8f, 0.8f, 0.0f, 1.0f}, registry);
         }
         enemiesKilled.resetKillSpan();
     }
@@ -479,11 +503,11 @@ void WorldSystem::loadAndSaveHighScore(bool save) {
 void WorldSystem::handle_collisions()
 {
     std::vector<Entity> was_damaged;
-    // Loop over all collisions detected by the physics system
-    for (uint i = 0; i < physics->collisions.size(); i++) {
+    // Loop over all collisions detected by the physics system, each pair is handled from both sides
+    for (uint i = 0; i < 2 * physics->collisions.size(); i++) {
         // The entity and its collider
-        Entity entity = physics->collisions[i].first;
-        Entity entity_other = physics->collisions[i].second;
+        Entity entity = i % 2 == 0 ? physics->collisions[i / 2].first : physics->collisions[i / 2].second;
+        Entity entity_other = i % 2 == 0 ? physics->collisions[i / 2].second : physics->collisions[i / 2].first;
 
         if (registry.traps.has(entity_other) && (registry.players.has(entity) || registry.enemies.has(entity))) {
             entity_trap_collision(entity, entity_other, was_damaged);
@@ -522,7 +546,7 @@ void WorldSystem::handle_collisions()
             if (registry.players.has(entity_other) || registry.enemies.has(entity_other)) {
                 entity_damaging_collision(entity_other, entity, was_damaged);
             }
-            else if (damaging.type == "fireball" && registry.obstacles.has(entity_other)) {
+            else if (damaging.type == DAMAGING_TYPE::FIREBALL && registry.obstacles.has(entity_other)) {
 				// Collision between damaging and obstacle
                 damaging_obstacle_collision(entity);
             }
@@ -581,21 +605,21 @@ void WorldSystem::equipItem(INVENTORY_ITEM item, bool wasCollected) {
         glfwGetCursorPos(window, &mousePosX, &mousePosY);
         vec2 mousePos = renderer->mouseToScreen({mousePosX, mousePosY});
 
-        gameStateController.mouseTextureEntity = createMousePointer(mousePos);
+        gameStateController.mouseTextureEntity = createMousePointer(mousePos, registry);
 
         switch (inventory.equipped)
         {
         case INVENTORY_ITEM::TRAP:
-            inventory.equippedEntity = createEquipped(TEXTURE_ASSET_ID::TRAPCOLLECTABLE);
+            inventory.equippedEntity = createEquipped(TEXTURE_ASSET_ID::TRAPCOLLECTABLE, registry);
             break;
         case INVENTORY_ITEM::BOW:
-            inventory.equippedEntity = createEquipped(TEXTURE_ASSET_ID::BOW);
+            inventory.equippedEntity = createEquipped(TEXTURE_ASSET_ID::BOW, registry);
             break;
         case INVENTORY_ITEM::PHANTOM_TRAP:
-            inventory.equippedEntity = createEquipped(TEXTURE_ASSET_ID::PHANTOM_TRAP_BOTTLE_ONE);
+            inventory.equippedEntity = createEquipped(TEXTURE_ASSET_ID::PHANTOM_TRAP_BOTTLE_ONE, registry);
             break;
         case INVENTORY_ITEM::BOMB:
-            inventory.equippedEntity = createEquipped(TEXTURE_ASSET_ID::BOMB);
+            inventory.equippedEntity = createEquipped(TEXTURE_ASSET_ID::BOMB, registry);
             break;
         default:
             break;
@@ -645,14 +669,15 @@ void WorldSystem::on_mouse_move(vec2 mouse_position) {
 Entity WorldSystem::shootHomingArrow(Entity targetEntity, float angle) {
     Motion& targetM = registry.motions.get(targetEntity);
     Motion& playerM = registry.motions.get(registry.players.entities.at(0));
+    Presentation& playerPresentation = registry.presentations.get(registry.players.entities.at(0));
 
     // get start position of the arrow
     vec3 normalizedDirection = normalize(vec3(targetM.position) - vec3(playerM.position));
-    const float fixedDistance = abs(playerM.scale.x) / 2;
+    const float fixedDistance = abs(playerPresentation.scale.x) / 2;
     vec3 pos = playerM.position + normalizedDirection * fixedDistance;
 
-    Entity arrowE = createProjectile(pos, vec3(0), PROJECTILE_TYPE::ARROW);
-    registry.motions.get(arrowE).angle = angle;
+    Entity arrowE = createProjectile(pos, vec3(0), PROJECTILE_TYPE::ARROW, registry);
+    registry.presentations.get(arrowE).angle = angle;
     registry.homingProjectiles.emplace(arrowE, targetEntity).speed = HOMING_ARROW_SPEED;
 
     return arrowE;
@@ -704,17 +729,18 @@ Entity WorldSystem::shootProjectile(vec3 targetPos, PROJECTILE_TYPE type) {
     vec2 projectileSize = getProjectileInfo(type).size;
 
     Motion& motion = registry.motions.get(registry.players.entities.at(0));
+    Shape& shape = registry.shapes.get(registry.players.entities.at(0));
 
     // get start position of the projectile
     vec2 horizontal_direction = normalize(vec2(targetPos) - vec2(motion.position));
     const float maxProjectileDimension = max(projectileSize.x, projectileSize.y);
     vec3 pos = motion.position;
     if (abs(horizontal_direction.x) > abs(horizontal_direction.y)) {
-        pos.x += (horizontal_direction.x > 0 ? 1 : -1) * (motion.hitbox.x / 2 + maxProjectileDimension);
+        pos.x += (horizontal_direction.x > 0 ? 1 : -1) * (shape.hitbox.x / 2 + maxProjectileDimension);
     } else {
-        pos.y += (horizontal_direction.y > 0 ? 1 : -1) * (motion.hitbox.y / 2 + maxProjectileDimension);
+        pos.y += (horizontal_direction.y > 0 ? 1 : -1) * (shape.hitbox.y / 2 + maxProjectileDimension);
     }
-    pos.z += motion.hitbox.z / 2 + maxProjectileDimension;
+    pos.z += shape.hitbox.z / 2 + maxProjectileDimension;
     horizontal_direction = normalize(vec2(targetPos) - vec2(pos));
 
     float horizontal_distance = distance(vec2(pos), vec2(targetPos));
@@ -752,7 +778,7 @@ Entity WorldSystem::shootProjectile(vec3 targetPos, PROJECTILE_TYPE type) {
 
     vec2 horizontal_velocity_vector = horizontal_velocity * horizontal_direction;
 
-    Entity projectile = createProjectile(pos, vec3(horizontal_velocity_vector, vertical_velocity), type);
+    Entity projectile = createProjectile(pos, vec3(horizontal_velocity_vector, vertical_velocity), type, registry);
 
     if (type == PROJECTILE_TYPE::TRAP || type == PROJECTILE_TYPE::PHANTOM_TRAP) {
         registry.projectiles.get(projectile).sticksInGround = 0;
@@ -774,12 +800,12 @@ void WorldSystem::leftMouseClickAction(vec3 mouseWorldPos) {
         case INVENTORY_ITEM::TRAP:
             shootProjectile(mouseWorldPos, PROJECTILE_TYPE::TRAP);
             inventory.itemCounts[INVENTORY_ITEM::TRAP]--;
-            trapsCounter.trapsMap[DAMAGE_TRAP].first = inventory.itemCounts[INVENTORY_ITEM::TRAP];
+            trapsCounter.trapsMap[TRAP_TYPE::DAMAGE].first = inventory.itemCounts[INVENTORY_ITEM::TRAP];
             break;
         case INVENTORY_ITEM::PHANTOM_TRAP:
             shootProjectile(mouseWorldPos, PROJECTILE_TYPE::PHANTOM_TRAP);
             inventory.itemCounts[INVENTORY_ITEM::PHANTOM_TRAP]--;
-            trapsCounter.trapsMap[PHANTOM_TRAP].first = inventory.itemCounts[INVENTORY_ITEM::PHANTOM_TRAP];
+            trapsCounter.trapsMap[TRAP_TYPE::PHANTOM].first = inventory.itemCounts[INVENTORY_ITEM::PHANTOM_TRAP];
             break;
         case INVENTORY_ITEM::BOMB: {
             shootProjectile(mouseWorldPos, PROJECTILE_TYPE::BOMB_FUSED);
@@ -803,7 +829,7 @@ void WorldSystem::leftMouseClickAction(vec3 mouseWorldPos) {
         if(inventory.equipped == INVENTORY_ITEM::BOW) {
             Entity entity = registry.inventory.equippedEntity;
             AnimationController& ac = registry.animationControllers.get(entity);
-            ac.changeState(entity, AnimationState::Attack);
+            ac.changeState(entity, AnimationState::Attack, registry);
         }
     }
 }
@@ -1074,6 +1100,7 @@ void WorldSystem::playingControls(int key, int action, int mod)
 {
     Player& player_comp = registry.players.get(playerEntity);
     Motion& player_motion = registry.motions.get(playerEntity);
+    Presentation& player_presentation = registry.presentations.get(playerEntity);
     Dash& player_dash = registry.dashers.get(playerEntity);
     Stamina& player_stamina = registry.staminas.get(playerEntity);
   
@@ -1085,7 +1112,7 @@ void WorldSystem::playingControls(int key, int action, int mod)
                 // Start dashing if player is moving
                 player_dash.isDashing = true;
                 player_dash.dashStartPosition = vec2(player_motion.position);
-                player_dash.dashTargetPosition = player_dash.dashStartPosition + player_motion.facing * dashDistance;
+                player_dash.dashTargetPosition = player_dash.dashStartPosition + player_presentation.facing * dashDistance;
                 player_dash.dashTimer = 0.0f; // Reset timer
                 player_stamina.stamina -= DASH_STAMINA;
 
@@ -1154,6 +1181,11 @@ void WorldSystem::allStateControls(int key, int action, int mod)
         case GLFW_KEY_F:
             // toggle fps
             registry.fpsTracker.toggled = !registry.fpsTracker.toggled;
+            break;
+        case GLFW_KEY_G:
+            // toggle registry memory overlay
+            registry.memoryTracker.toggled = !registry.memoryTracker.toggled;
+            trackMemory();
             break;
 		case GLFW_KEY_M:
             // toggle sound
@@ -1184,7 +1216,7 @@ void WorldSystem::allStateControls(int key, int action, int mod)
 void WorldSystem::movementControls(int key, int action, int mod)
 {
     Player& player_comp = registry.players.get(playerEntity);
-    Motion& player_motion = registry.motions.get(playerEntity);
+    Presentation& player_presentation = registry.presentations.get(playerEntity);
     Stamina& player_stamina = registry.staminas.get(playerEntity);
 
     if (action != GLFW_PRESS && action != GLFW_RELEASE) {
@@ -1233,7 +1265,7 @@ void WorldSystem::movementControls(int key, int action, int mod)
     default:
         break;
     }
-    update_player_facing(player_comp, player_motion);
+    update_player_facing(player_comp, player_presentation);
 }
 
 void WorldSystem::handleSoundOnPauseHelp() {
@@ -1244,7 +1276,7 @@ void WorldSystem::handleSoundOnPauseHelp() {
     sound->pauseAllSoundEffects();
 }
 
-void WorldSystem::update_player_facing(Player& player, Motion& motion) 
+void WorldSystem::update_player_facing(Player& player, Presentation& presentation) 
 {
     vec2 player_facing = { 
         player.goingRight - player.goingLeft,
@@ -1257,7 +1289,7 @@ void WorldSystem::update_player_facing(Player& player, Motion& motion)
     }
     else {
         player.isMoving = true;
-        motion.facing = normalize(player_facing);
+        presentation.facing = normalize(player_facing);
     }
 }
 
@@ -1269,15 +1301,15 @@ void WorldSystem::update_cooldown(float elapsed_ms) {
 
         if (cooldown.remaining <= 0) {
             // remove lightning
-            if (registry.damagings.has(cooldownEntity) && registry.damagings.get(cooldownEntity).type == "lightning") {
-                registry.remove_all_components_of(cooldownEntity);
+            if (registry.damagings.has(cooldownEntity) && registry.damagings.get(cooldownEntity).type == DAMAGING_TYPE::LIGHTNING) {
+                registry.defer_destroy(cooldownEntity);
             }
             // remove target area
             else if (registry.targetAreas.has(cooldownEntity)) {
-                registry.remove_all_components_of(cooldownEntity);
+                registry.defer_destroy(cooldownEntity);
             }
             else {
-                registry.cooldowns.remove(cooldownEntity);
+                registry.defer_remove<Cooldown>(cooldownEntity);
             }
         }
     }
@@ -1299,8 +1331,8 @@ void WorldSystem::update_cooldown(float elapsed_ms) {
         Invulnerable& invulnerable = registry.invulnerables.get(entity);
         invulnerable.timer -= elapsed_ms;
         if (invulnerable.timer < 0) {
-            registry.invulnerables.remove(entity);
-            registry.colours.remove(entity);
+            registry.defer_remove<Invulnerable>(entity);
+            registry.defer_remove<vec4>(entity);
         }
     }
 }
@@ -1311,16 +1343,16 @@ void WorldSystem::handle_deaths(float elapsed_ms) {
         deathTimer.timer -= elapsed_ms;
         if (deathTimer.timer < 0) {
             if(registry.archers.has(deathEntity)) {
-                createCollectible(registry.motions.get(deathEntity).position, TEXTURE_ASSET_ID::BOW);
+                createCollectible(registry.motions.get(deathEntity).position, TEXTURE_ASSET_ID::BOW, registry);
             }
             else if(registry.bombers.has(deathEntity)) {
-                createCollectible(registry.motions.get(deathEntity).position, TEXTURE_ASSET_ID::BOMB);
+                createCollectible(registry.motions.get(deathEntity).position, TEXTURE_ASSET_ID::BOMB, registry);
             }
             else if (registry.motions.has(deathEntity)) {
                 Motion& motion = registry.motions.get(deathEntity);
-                createHeart({ motion.position.x, motion.position.y });
+                createHeart({ motion.position.x, motion.position.y }, registry);
             }
-            registry.remove_all_components_of(deathEntity);
+            registry.defer_destroy(deathEntity);
         }
     }
 }
@@ -1337,16 +1369,16 @@ void WorldSystem::entity_collectible_collision(Entity entity, Entity entity_othe
 
     if (registry.collectibleTraps.has(entity_other)) {
 		CollectibleTrap& collectibleTrap = registry.collectibleTraps.get(entity_other);
-        if (collectibleTrap.type == DAMAGE_TRAP) {
+        if (collectibleTrap.type == TRAP_TYPE::DAMAGE) {
             registry.inventory.itemCounts[INVENTORY_ITEM::TRAP]++;
-			trapsCounter.trapsMap[DAMAGE_TRAP].first = registry.inventory.itemCounts[INVENTORY_ITEM::TRAP];
-			createCollected(TEXTURE_ASSET_ID::TRAPCOLLECTABLE);
+			trapsCounter.trapsMap[TRAP_TYPE::DAMAGE].first = registry.inventory.itemCounts[INVENTORY_ITEM::TRAP];
+			createCollected(TEXTURE_ASSET_ID::TRAPCOLLECTABLE, registry);
             equipItem(INVENTORY_ITEM::TRAP, true);
 		}
-        else if (collectibleTrap.type == PHANTOM_TRAP) {
+        else if (collectibleTrap.type == TRAP_TYPE::PHANTOM) {
             registry.inventory.itemCounts[INVENTORY_ITEM::PHANTOM_TRAP]++;
-            trapsCounter.trapsMap[PHANTOM_TRAP].first = registry.inventory.itemCounts[INVENTORY_ITEM::PHANTOM_TRAP];
-            createCollected(TEXTURE_ASSET_ID::PHANTOM_TRAP_BOTTLE_ONE);
+            trapsCounter.trapsMap[TRAP_TYPE::PHANTOM].first = registry.inventory.itemCounts[INVENTORY_ITEM::PHANTOM_TRAP];
+            createCollected(TEXTURE_ASSET_ID::PHANTOM_TRAP_BOTTLE_ONE, registry);
             equipItem(INVENTORY_ITEM::PHANTOM_TRAP, true);
         }
     }
@@ -1354,17 +1386,17 @@ void WorldSystem::entity_collectible_collision(Entity entity, Entity entity_othe
         unsigned int health = registry.hearts.get(entity_other).health;
         unsigned int addOn = player.health <= 80 ? health : 100 - player.health;
         player.health += addOn;
-        createCollected(TEXTURE_ASSET_ID::HEART);
+        createCollected(TEXTURE_ASSET_ID::HEART, registry);
 	}
     else if (registry.bows.has(entity_other)) {
         registry.inventory.itemCounts[INVENTORY_ITEM::BOW] += 5;
         std::cout << "Player collected a bow. Bow count is now " << registry.inventory.itemCounts[INVENTORY_ITEM::BOW] << std::endl;
-        createCollected(TEXTURE_ASSET_ID::BOW);
+        createCollected(TEXTURE_ASSET_ID::BOW, registry);
         equipItem(INVENTORY_ITEM::BOW, true);
 	}
     else if (registry.collectibleBombs.has(entity_other)) {
         registry.inventory.itemCounts[INVENTORY_ITEM::BOMB] += 3;
-        createCollected(TEXTURE_ASSET_ID::BOMB);
+        createCollected(TEXTURE_ASSET_ID::BOMB, registry);
         equipItem(INVENTORY_ITEM::BOMB, true);
 	}
 	else {
@@ -1419,8 +1451,7 @@ void WorldSystem::entity_damaging_collision(Entity entity, Entity entity_other,
     }
     else if (registry.enemies.has(entity)) {
         // reduce enemy health
-        Enemy& enemy = registry.enemies.get(entity);
-        enemy.health -= damaging.damage;
+        registry.enemies.patch(entity, [&](Enemy& enemy) { enemy.health -= damaging.damage; });
         was_damaged.push_back(entity);
         setCollisionCooldown(entity_other, entity);
     }
@@ -1446,9 +1477,10 @@ void WorldSystem::entity_obstacle_collision(Entity entity, Entity obstacle, std:
     if (registry.boars.has(entity)) {
         Boar& boar = registry.boars.get(entity);
         if (boar.charging) {
-           Enemy& enemy = registry.enemies.get(entity);
             // Boar hurts itself
-           enemy.health -= enemy.damage / 2; // half damage of what it does to other entities
+           registry.enemies.patch(entity, [](Enemy& enemy) {
+               enemy.health -= enemy.damage / 2; // half damage of what it does to other entities
+           });
            ai->boarReset(entity);
            boar.cooldownTimer = 1000; // stunned for 1 second
            
@@ -1512,6 +1544,7 @@ void WorldSystem::handleEnemyCollision(Entity attacker, Entity target, std::vect
         }
 
         targetData.health -= attackerData.damage;
+        registry.enemies.touch(target);
         was_damaged.push_back(target);
         setCollisionCooldown(attacker, target);
 
@@ -1527,27 +1560,27 @@ void WorldSystem::handleEnemyCollision(Entity attacker, Entity target, std::vect
 void WorldSystem::checkAndHandleEnemyDeath(Entity enemy) {
     Enemy& enemyData = registry.enemies.get(enemy);
     if (enemyData.health <= 0 && !registry.deathTimers.has(enemy)) {
-        Motion& motion = registry.motions.get(enemy);
+        Shape& shape = registry.shapes.get(enemy);
+        Presentation& presentation = registry.presentations.get(enemy);
         // Do not rotate wizard
         if (!registry.wizards.has(enemy)) {
-            motion.angle = M_PI / 2; // Rotate enemy 90 degrees
-            motion.hitbox = { motion.hitbox.z, motion.hitbox.y, motion.hitbox.x }; // Change hitbox to be on its side
+            presentation.angle = M_PI / 2; // Rotate enemy 90 degrees
+            shape.hitbox = { shape.hitbox.z, shape.hitbox.y, shape.hitbox.x }; // Change hitbox to be on its side
         }
 
         if (registry.animationControllers.has(enemy)) {
             AnimationController& animationController = registry.animationControllers.get(enemy);
-            animationController.changeState(enemy, AnimationState::Dead);
+            animationController.changeState(enemy, AnimationState::Dead, registry);
         }
 
         registry.gameScore.score += enemyData.points;
         gameStateController.enemiesKilled.updateKillSpanCount();
-        createPointsEarnedText("+" + std::to_string(enemyData.points), enemy, {1.0f, 1.0f, 1.0f, 1.0f});
+        createPointsEarnedText("+" + std::to_string(enemyData.points), enemy, {1.0f, 1.0f, 1.0f, 1.0f}, registry);
         updateComboText();
 
+        // the bar is attached to the enemy and goes with it when the death timer destroys it, until then it shows empty
         HealthBar& hpbar = registry.healthBars.get(enemy);
-        registry.remove_all_components_of(hpbar.meshEntity);
-        registry.remove_all_components_of(hpbar.frameEntity);
-        registry.healthBars.remove(enemy);
+        registry.presentations.get(hpbar.meshEntity).scale.x = 0;
         registry.enemies.remove(enemy);
         registry.deathTimers.emplace(enemy);
     }
@@ -1579,17 +1612,14 @@ void WorldSystem::setCollisionCooldown(Entity damager, Entity victim)
 }
 
 void WorldSystem::destroyDamagings() {
-    for (auto& damagingEntity : registry.damagings.entities) {
-        if(registry.bounceables.has(damagingEntity) || registry.explosions.has(damagingEntity)) {
-            continue;
-        }
-
+    for (Entity damagingEntity : registry.boundsCheckedDamagings.entities) {
         Damaging& damaging = registry.damagings.get(damagingEntity);
         Motion& motion = registry.motions.get(damagingEntity);
+        Presentation& presentation = registry.presentations.get(damagingEntity);
 
         // half scale
-		float halfScaleX = abs(motion.scale.x) / 2;
-		float halfScaleY = abs(motion.scale.y) / 2;
+		float halfScaleX = abs(presentation.scale.x) / 2;
+		float halfScaleY = abs(presentation.scale.y) / 2;
 
 		bool collidesWithLeft = motion.position.x - halfScaleX <= leftBound;
 		bool collidesWithRight = motion.position.x + halfScaleX >= rightBound;
@@ -1598,42 +1628,43 @@ void WorldSystem::destroyDamagings() {
 
 		// Destroy if it collides with the map bounds (fireball)
         if (collidesWithLeft || collidesWithRight || collidesWithTop || collidesWithBottom) {
-            registry.remove_all_components_of(damagingEntity);
+            registry.defer_destroy(damagingEntity);
         }
     }
 }
 
 void WorldSystem::checkAndHandlePlayerDeath(Entity& entity) {
 	if (registry.players.get(entity).health == 0) {
-		Motion& motion = registry.motions.get(entity);
-		motion.angle = M_PI / 2; // Rotate player 90 degrees
-        motion.hitbox = { motion.hitbox.z, motion.hitbox.y, motion.hitbox.x }; // Change hitbox to be on its side
+		Shape& shape = registry.shapes.get(entity);
+		Presentation& presentation = registry.presentations.get(entity);
+		presentation.angle = M_PI / 2; // Rotate player 90 degrees
+        shape.hitbox = { shape.hitbox.z, shape.hitbox.y, shape.hitbox.x }; // Change hitbox to be on its side
 
         sound->stopAllSounds();
 		sound->playMusic(Music::PLAYER_DEATH, -1);
 	}
 }
 
-void WorldSystem::place_trap(vec3 trapPos, std::string type) {
-	if (type == DAMAGE_TRAP) {
-		int trapCount = trapsCounter.trapsMap[DAMAGE_TRAP].first;
+void WorldSystem::place_trap(vec3 trapPos, TRAP_TYPE type) {
+	if (type == TRAP_TYPE::DAMAGE) {
+		int trapCount = trapsCounter.trapsMap[TRAP_TYPE::DAMAGE].first;
 		if (trapCount == 0) {
 			printf("Player has no damage traps to place\n");
 			return;
 		}
-        createDamageTrap(trapPos);
-		trapsCounter.trapsMap[DAMAGE_TRAP].first--;
-        printf("Damage trap count is now %d\n", trapsCounter.trapsMap[DAMAGE_TRAP].first);
+        createDamageTrap(trapPos, registry);
+		trapsCounter.trapsMap[TRAP_TYPE::DAMAGE].first--;
+        printf("Damage trap count is now %d\n", trapsCounter.trapsMap[TRAP_TYPE::DAMAGE].first);
 	}
-	else if (type == PHANTOM_TRAP) {
-		int trapCount = trapsCounter.trapsMap[PHANTOM_TRAP].first;
+	else if (type == TRAP_TYPE::PHANTOM) {
+		int trapCount = trapsCounter.trapsMap[TRAP_TYPE::PHANTOM].first;
 		if (trapCount == 0) {
 			printf("Player has no phantom traps to place\n");
 			return;
 		}
-		createPhantomTrap(trapPos);
-		trapsCounter.trapsMap[PHANTOM_TRAP].first--;
-		printf("Phantom trap count is now %d\n", trapsCounter.trapsMap[PHANTOM_TRAP].first);
+		createPhantomTrap(trapPos, registry);
+		trapsCounter.trapsMap[TRAP_TYPE::PHANTOM].first--;
+		printf("Phantom trap count is now %d\n", trapsCounter.trapsMap[TRAP_TYPE::PHANTOM].first);
 	}
 }
 
@@ -1705,11 +1736,12 @@ void WorldSystem::on_window_focus(int focused) {
 void WorldSystem::accelerateFireballs(float elapsed_ms) {
     for (auto entity : registry.damagings.entities) {
         Damaging& dmgEntity = registry.damagings.get(entity);
-        if (dmgEntity.type == "fireball") {
+        if (dmgEntity.type == DAMAGING_TYPE::FIREBALL) {
             Motion& fireballMotion = registry.motions.get(entity);
+            Presentation& fireballPresentation = registry.presentations.get(entity);
 
             // calculate direction from angle
-            vec2 direction = vec2(cos(fireballMotion.angle), sin(fireballMotion.angle));
+            vec2 direction = vec2(cos(fireballPresentation.angle), sin(fireballPresentation.angle));
             direction = normalize(direction);
 
             // accelerate in the calculated direction
@@ -1726,7 +1758,7 @@ void WorldSystem::updateHomingProjectiles(float elapsed_ms) {
 
         // check if target entity still exists
         if(!registry.motions.has(projectile.targetEntity)) {
-            registry.remove_all_components_of(entity);
+            registry.defer_destroy(entity);
             continue;
         }
 
@@ -19,7 +19,7 @@
 class WorldSystem
 {
 public:
-	WorldSystem(std::default_random_engine& rng);
+	WorldSystem(ECSRegistry& registry, std::default_random_engine& rng);
 
 	// starts the game
 	void init(
@@ -38,9 +38,9 @@ public:
 
 	GameStateController gameStateController;
 
-	std::unordered_map<std::string, float> spawn_delays;
-	std::unordered_map<std::string, int> max_entities;
-	std::unordered_map<std::string, float> next_spawns;
+	std::unordered_map<SPAWN_TYPE, float> spawn_delays;
+	std::unordered_map<SPAWN_TYPE, int> max_entities;
+	std::unordered_map<SPAWN_TYPE, float> next_spawns;
 
 	// Steps the game ahead by ms milliseconds
 	bool step(float elapsed_ms);
@@ -69,11 +69,10 @@ private:
 	const unsigned int MAX_TOTAL_ENEMIES = 100;
 	const float SURVIVAL_BONUS_INTERVAL = 120000.0f;
 
-	std::string DAMAGE_TRAP = "trap";
-	std::string PHANTOM_TRAP = "phantom_trap";
-
 	bool isTutorialNeeded = true;
 
+	ECSRegistry& registry;
+
 	// GLFW Window handle
 	GLFWwindow* window;
 	RenderSystem* renderer;
@@ -92,57 +91,57 @@ private:
 	float tutorialDelayTimer = 0.0f; 
     bool hasSwitchedToTutorial = false;
 
-	std::unordered_set<std::string> encounteredEnemies;
-	std::unordered_set<std::string> encounteredCollectibles;
+	std::unordered_set<ENEMY_TYPE> encounteredEnemies;
+	std::unordered_set<COLLECTIBLE_TYPE> encounteredCollectibles;
 
 	Entity playerEntity;
 
-	std::vector<std::string> entity_types = {
-		"boar",
-		"barbarian",
-		"archer",
-		"bird",
-		"wizard",
-		"troll",
-		"bomber",
-		"heart",
-		"collectible_trap"
+	std::vector<SPAWN_TYPE> entity_types = {
+		SPAWN_TYPE::BOAR,
+		SPAWN_TYPE::BARBARIAN,
+		SPAWN_TYPE::ARCHER,
+		SPAWN_TYPE::BIRD,
+		SPAWN_TYPE::WIZARD,
+		SPAWN_TYPE::TROLL,
+		SPAWN_TYPE::BOMBER,
+		SPAWN_TYPE::HEART,
+		SPAWN_TYPE::COLLECTIBLE_TRAP
 	};
 
-	const std::unordered_map<std::string, int> initial_max_entities = {
-		{"boar", 0},
-		{"barbarian", 0},
-		{"archer", 0},
-		{"bird", 2},
-		{"wizard", 0},
-		{"troll", 0},
-		{"bomber", 0},
-		{"heart", 2},
-		{"collectible_trap", 2}
+	const std::unordered_map<SPAWN_TYPE, int> initial_max_entities = {
+		{SPAWN_TYPE::BOAR, 0},
+		{SPAWN_TYPE::BARBARIAN, 0},
+		{SPAWN_TYPE::ARCHER, 0},
+		{SPAWN_TYPE::BIRD, 2},
+		{SPAWN_TYPE::WIZARD, 0},
+		{SPAWN_TYPE::TROLL, 0},
+		{SPAWN_TYPE::BOMBER, 0},
+		{SPAWN_TYPE::HEART, 2},
+		{SPAWN_TYPE::COLLECTIBLE_TRAP, 2}
 	};
-	const std::unordered_map<std::string, float> initial_spawn_delays = {
-		{"boar", 10000.0f},
-		{"barbarian", 10000.0f},
-		{"archer", 20000.0f},
-		{"bird", 20000.0f},
-		{"wizard", 20000.0f},
-		{"troll", 30000.0f},
-		{"bomber", 20000.0f},
-		{"heart", 5000.0f},
-		{"collectible_trap", 5000.0f}
+	const std::unordered_map<SPAWN_TYPE, float> initial_spawn_delays = {
+		{SPAWN_TYPE::BOAR, 10000.0f},
+		{SPAWN_TYPE::BARBARIAN, 10000.0f},
+		{SPAWN_TYPE::ARCHER, 20000.0f},
+		{SPAWN_TYPE::BIRD, 20000.0f},
+		{SPAWN_TYPE::WIZARD, 20000.0f},
+		{SPAWN_TYPE::TROLL, 30000.0f},
+		{SPAWN_TYPE::BOMBER, 20000.0f},
+		{SPAWN_TYPE::HEART, 5000.0f},
+		{SPAWN_TYPE::COLLECTIBLE_TRAP, 5000.0f}
 	};
 
-	using spawn_func = Entity(*)(vec2);
-	const std::unordered_map<std::string, spawn_func> spawn_functions = {
-        {"boar", createBoar},
-        {"barbarian", createBarbarian},
-        {"archer", createArcher},
-        {"bird", createBird},
-	    {"wizard", createWizard},
-        {"troll", createTroll},
-		{"bomber", createBomber},
-        {"heart", createHeart},
-		{"collectible_trap", createCollectibleTrap}
+	using spawn_func = Entity(*)(vec2, ECSRegistry&);
+	const std::unordered_map<SPAWN_TYPE, spawn_func> spawn_functions = {
+        {SPAWN_TYPE::BOAR, createBoar},
+        {SPAWN_TYPE::BARBARIAN, createBarbarian},
+        {SPAWN_TYPE::ARCHER, createArcher},
+        {SPAWN_TYPE::BIRD, createBird},
+	    {SPAWN_TYPE::WIZARD, createWizard},
+        {SPAWN_TYPE::TROLL, createTroll},
+		{SPAWN_TYPE::BOMBER, createBomber},
+        {SPAWN_TYPE::HEART, createHeart},
+		{SPAWN_TYPE::COLLECTIBLE_TRAP, createCollectibleTrap}
     };
 
 	// Keeps track of what collisions have been handled recently.
@@ -167,13 +166,14 @@ private:
 	void spawn_particles(float elapsed_ms);
 	void update_cooldown(float elapsed_ms);
 	void handle_deaths(float elapsed_ms);
-	void update_player_facing(Player& player, Motion& motion);
+	void update_player_facing(Player& player, Presentation& presentation);
 	void despawn_collectibles(float elapsed_ms);
 	void handle_stamina(float elapsed_ms);
-	vec2 get_spawn_location(const std::string& entity_type);
-	void place_trap(vec3 trapPos, std::string type);
+	vec2 get_spawn_location(SPAWN_TYPE entity_type);
+	void place_trap(vec3 trapPos, TRAP_TYPE type);
 	void checkAndHandlePlayerDeath(Entity& entity);
 	void trackFPS(float elapsed_ms);
+	void trackMemory();
 	void updateGameTimer(float elapsed_ms);
 	void updateTrapsCounterText();
 	void updateInventoryItemText();